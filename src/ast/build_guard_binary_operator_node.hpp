@@ -44,25 +44,42 @@ public:
         }
 
         try {
-            switch (op) {
-            case op_type::_and: return *lhs_ and *rhs_;
-            case op_type::_or: return *lhs_ or *rhs_;
-            case op_type::in: return in(*lhs_, *rhs_);
-            case op_type::not_in: return not in(*lhs_, *rhs_);
-            case op_type::eq: return *lhs_ == *rhs_;
-            case op_type::ne: return *lhs_ != *rhs_;
-            case op_type::lt: return *lhs_ < *rhs_;
-            case op_type::gt: return *lhs_ > *rhs_;
-            case op_type::le: return *lhs_ <= *rhs_;
-            case op_type::ge: return *lhs_ >= *rhs_;
-            }
-            std::unreachable();
+            return evaluate_operator(op, *lhs_, *rhs_);
         } catch (std::invalid_argument const&) {
             return add(hkc_error::invalid_operand_types, "lhs: {}, rhs: {}", lhs_->repr(), rhs_->repr());
         }
     }
 
-    [[nodiscard]] size_t precedence() const
+    /** Apply a binary operator on two values.
+     *
+     * @param op The operator.
+     * @param lhs The left hand side operand.
+     * @param rhs The right hand side operand.
+     * @return The result of the operation.
+     * @throws std::invalid_argument When the operand types are invalid for the operator.
+     */
+    [[nodiscard]] static datum evaluate_operator(op_type op, datum const& lhs, datum const& rhs)
+    {
+        switch (op) {
+        case op_type::_and: return lhs and rhs;
+        case op_type::_or: return lhs or rhs;
+        case op_type::in: return in(lhs, rhs);
+        case op_type::not_in: return not in(lhs, rhs);
+        case op_type::eq: return lhs == rhs;
+        case op_type::ne: return lhs != rhs;
+        case op_type::lt: return lhs < rhs;
+        case op_type::gt: return lhs > rhs;
+        case op_type::le: return lhs <= rhs;
+        case op_type::ge: return lhs >= rhs;
+        }
+        std::unreachable();
+    }
+
+    /** The precedence of an operator.
+     *
+     * A lower value binds tighter, like the precedence table of C++.
+     */
+    [[nodiscard]] constexpr static size_t precedence(op_type op) noexcept
     {
         // clang-format off
         switch (op) {
@@ -81,22 +98,29 @@ public:
         std::unreachable();
     }
 
-    [[nodiscard]] bool left_to_right() const
+    [[nodiscard]] size_t precedence() const
+    {
+        return precedence(op);
+    }
+
+    [[nodiscard]] constexpr static bool left_to_right(op_type op) noexcept
     {
         return true;
     }
 
-    [[nodiscard]] generator<node*> children() const override
+    [[nodiscard]] bool left_to_right() const
     {
-        for (auto x : build_guard_expression_node::children()) {
-            co_yield x;
-        }
+        return left_to_right(op);
+    }
 
+    void append_children(std::vector<node *>& r) const override
+    {
+        build_guard_expression_node::append_children(r);
         if (lhs) {
-            co_yield lhs.get();
+            r.push_back(lhs.get());
         }
         if (rhs) {
-            co_yield rhs.get();
+            r.push_back(rhs.get());
         }
     }
 };
@@ -0,0 +1,50 @@
+
+#include "build_guard_cache.hpp"
+#include <cassert>
+
+namespace hk::ast {
+
+[[nodiscard]] size_t build_guard_cache::add(build_guard_expression_node const& root)
+{
+    auto program = build_guard_program{root};
+    auto key = program.key();
+
+    auto const lock = std::scoped_lock(_mutex);
+
+    auto const [it, inserted] = _program_by_key.try_emplace(std::move(key), _programs.size());
+    if (inserted) {
+        _programs.push_back(std::move(program));
+    }
+    return it->second;
+}
+
+[[nodiscard]] std::expected<datum, hkc_error> build_guard_cache::evaluate(size_t index, datum_namespace const& ctx)
+{
+    auto const lock = std::scoped_lock(_mutex);
+
+    assert(index < _programs.size());
+
+    if (_results.size() == max_num_versions and not _results.contains(ctx.version())) {
+        // Versions of namespaces that were modified are never used again.
+        _results.clear();
+    }
+
+    auto& results = _results[ctx.version()];
+    if (results.size() <= index) {
+        results.resize(_programs.size());
+    }
+
+    auto& result = results[index];
+    if (not result) {
+        result = _programs[index].evaluate(ctx);
+    }
+    return *result;
+}
+
+[[nodiscard]] size_t build_guard_cache::size() const
+{
+    auto const lock = std::scoped_lock(_mutex);
+    return _programs.size();
+}
+
+} // namespace hk::ast
@@ -0,0 +1,69 @@
+
+#pragma once
+
+#include "build_guard_program.hpp"
+#include "utility/datum_namespace.hpp"
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hk::ast {
+
+/** The compiled build-guards of the workspace.
+ *
+ * Build-guards are deduplicated by their compiled form; the many sources
+ * with `if target.os == "linux"` share a single program. The result of each
+ * program is memoized for the namespace it was evaluated with, so that each
+ * distinct build-guard is evaluated once per configuration.
+ */
+class build_guard_cache {
+public:
+    /** Compile a build-guard and add it to the cache.
+     *
+     * This function is thread-safe.
+     *
+     * @param root The root of the build-guard expression.
+     * @return The index of the program, the same for identical build-guards.
+     */
+    [[nodiscard]] size_t add(build_guard_expression_node const& root);
+
+    /** Evaluate a build-guard.
+     *
+     * The result is memoized for the version of the namespace; results are
+     * kept for up to `max_num_versions` versions, so that several
+     * configurations can be evaluated in turn. This function is thread-safe.
+     *
+     * @param index The index returned by `add()`.
+     * @param ctx The namespace with the values of the variables.
+     * @return The value of the build-guard.
+     */
+    [[nodiscard]] std::expected<datum, hkc_error> evaluate(size_t index, datum_namespace const& ctx);
+
+    /** The number of distinct build-guards.
+     */
+    [[nodiscard]] size_t size() const;
+
+private:
+    mutable std::mutex _mutex;
+
+    std::vector<build_guard_program> _programs;
+    std::unordered_map<std::string, size_t> _program_by_key;
+
+    using results_type = std::vector<std::optional<std::expected<datum, hkc_error>>>;
+
+    /** The number of namespace versions to keep results for.
+     */
+    constexpr static size_t max_num_versions = 64;
+
+    /** The memoized results by version of the namespace.
+     */
+    std::unordered_map<uint64_t, results_type> _results;
+};
+
+inline build_guard_cache global_build_guard_cache;
+
+} // namespace hk::ast
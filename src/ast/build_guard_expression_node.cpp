@@ -0,0 +1,21 @@
+
+#include "build_guard_expression_node.hpp"
+#include "build_guard_cache.hpp"
+
+namespace hk::ast {
+
+[[nodiscard]] std::expected<datum, hkc_error>
+build_guard_expression_node::evaluate_build_guard_expression(datum_namespace const& ctx) const
+{
+    if (not program_index) {
+        return evaluate_expression(ctx);
+    }
+
+    if (auto r = global_build_guard_cache.evaluate(*program_index, ctx)) {
+        return r;
+    }
+
+    return evaluate_expression(ctx);
+}
+
+} // namespace hk::ast
@@ -1,18 +1,36 @@
-
 #pragma once
 
 #include "node.hpp"
 #include "utility/datum_namespace.hpp"
+#include <optional>
 
 namespace hk::ast {
 
 class build_guard_expression_node : public node {
 public:
+    /** The index of the compiled build-guard in `global_build_guard_cache`.
+     *
+     * Only set on the root expression of a build-guard.
+     */
+    std::optional<size_t> program_index = std::nullopt;
+
     build_guard_expression_node(char const* first, char const* last=nullptr) : node(first, last) {}
 
     [[nodiscard]] virtual std::expected<datum, hkc_error> evaluate_expression(datum_namespace const& ctx) const = 0;
+
+    /** Evaluate the build-guard that starts at this expression.
+     *
+     * The result is taken from `global_build_guard_cache`, so that identical
+     * build-guards are only evaluated once for each namespace. When the
+     * evaluation fails, the expression tree is evaluated to report the error
+     * at this location.
+     *
+     * @param ctx The namespace used by the expression.
+     * @return The value of the expression.
+     */
+    [[nodiscard]] std::expected<datum, hkc_error> evaluate_build_guard_expression(datum_namespace const& ctx) const;
 };
 
 using build_guard_expression_node_ptr = std::unique_ptr<build_guard_expression_node>;
 
-} // namespace hk::ast
\ No newline at end of file
+} // namespace hk::ast
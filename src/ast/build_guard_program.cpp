@@ -0,0 +1,174 @@
+
+#include "build_guard_program.hpp"
+#include "build_guard_literal_node.hpp"
+#include "build_guard_variable_node.hpp"
+#include <algorithm>
+#include <format>
+#include <utility>
+#include <cassert>
+
+namespace hk::ast {
+
+build_guard_program::build_guard_program(build_guard_expression_node const& root)
+{
+    compile(root);
+
+    auto depth = 0uz;
+    for (auto const& instruction : _instructions) {
+        switch (instruction.code) {
+        case opcode::constant:
+        case opcode::variable:
+            _stack_size = std::max(_stack_size, ++depth);
+            break;
+        case opcode::unary_operator:
+            break;
+        case opcode::binary_operator:
+            --depth;
+            break;
+        }
+    }
+    assert(depth == 1);
+}
+
+void build_guard_program::add_constant(datum value)
+{
+    _instructions.emplace_back(opcode::constant, static_cast<uint32_t>(_constants.size()));
+    _constants.push_back(std::move(value));
+}
+
+void build_guard_program::compile(build_guard_expression_node const& n)
+{
+    if (auto literal = dynamic_cast<build_guard_literal_node const*>(&n)) {
+        add_constant(literal->value);
+
+    } else if (auto variable = dynamic_cast<build_guard_variable_node const*>(&n)) {
+        auto const name = interned_string{variable->name.string()};
+        auto const it = std::ranges::find(_variables, name);
+        _instructions.emplace_back(opcode::variable, static_cast<uint32_t>(std::distance(_variables.begin(), it)));
+        if (it == _variables.end()) {
+            _variables.push_back(name);
+        }
+
+    } else if (auto unary = dynamic_cast<build_guard_unary_operator_node const*>(&n)) {
+        assert(unary->rhs != nullptr);
+        compile(*unary->rhs);
+
+        // A constant operand is the last constant that was added.
+        if (_instructions.back().code == opcode::constant) {
+            try {
+                auto value = build_guard_unary_operator_node::evaluate_operator(unary->op, _constants.back());
+                _instructions.pop_back();
+                _constants.pop_back();
+                add_constant(std::move(value));
+                return;
+            } catch (std::invalid_argument const&) {
+                // Leave the error to be reported during evaluation.
+            }
+        }
+        _instructions.emplace_back(opcode::unary_operator, static_cast<uint32_t>(std::to_underlying(unary->op)));
+
+    } else if (auto binary = dynamic_cast<build_guard_binary_operator_node const*>(&n)) {
+        assert(binary->lhs != nullptr);
+        assert(binary->rhs != nullptr);
+        compile(*binary->lhs);
+        compile(*binary->rhs);
+
+        // A sub-expression that is a constant compiles to a single
+        // instruction, so both operands are constant when the last two
+        // instructions are.
+        auto const size = _instructions.size();
+        if (size >= 2 and _instructions[size - 2].code == opcode::constant and
+            _instructions[size - 1].code == opcode::constant) {
+            try {
+                auto const& lhs = _constants[_constants.size() - 2];
+                auto const& rhs = _constants[_constants.size() - 1];
+                auto value = build_guard_binary_operator_node::evaluate_operator(binary->op, lhs, rhs);
+                _instructions.resize(size - 2);
+                _constants.resize(_constants.size() - 2);
+                add_constant(std::move(value));
+                return;
+            } catch (std::invalid_argument const&) {
+                // Leave the error to be reported during evaluation.
+            }
+        }
+        _instructions.emplace_back(opcode::binary_operator, static_cast<uint32_t>(std::to_underlying(binary->op)));
+
+    } else {
+        std::unreachable();
+    }
+}
+
+[[nodiscard]] std::string build_guard_program::key() const
+{
+    auto r = std::string{};
+    for (auto const& instruction : _instructions) {
+        switch (instruction.code) {
+        case opcode::constant: {
+            // Prefix the length, a string literal may contain the separator.
+            auto const repr = _constants[instruction.operand].repr();
+            r += std::format("c{}:{};", repr.size(), repr);
+            break;
+        }
+        case opcode::variable:
+            r += std::format("v{};", _variables[instruction.operand].string_view());
+            break;
+        case opcode::unary_operator:
+            r += std::format("u{};", instruction.operand);
+            break;
+        case opcode::binary_operator:
+            r += std::format("b{};", instruction.operand);
+            break;
+        }
+    }
+    return r;
+}
+
+[[nodiscard]] std::expected<datum, hkc_error> build_guard_program::evaluate(datum_namespace const& ctx) const
+{
+    auto stack = std::vector<datum>{};
+    stack.reserve(_stack_size);
+
+    for (auto const& instruction : _instructions) {
+        switch (instruction.code) {
+        case opcode::constant:
+            stack.push_back(_constants[instruction.operand]);
+            break;
+
+        case opcode::variable:
+            if (auto optional_value = ctx.get(_variables[instruction.operand])) {
+                stack.push_back(*optional_value);
+            } else {
+                return std::unexpected{hkc_error::unknown_build_guard_constant};
+            }
+            break;
+
+        case opcode::unary_operator: {
+            assert(not stack.empty());
+            auto const op = static_cast<build_guard_unary_operator_node::op_type>(instruction.operand);
+            try {
+                stack.back() = build_guard_unary_operator_node::evaluate_operator(op, stack.back());
+            } catch (std::invalid_argument const&) {
+                return std::unexpected{hkc_error::invalid_operand_types};
+            }
+            break;
+        }
+
+        case opcode::binary_operator: {
+            assert(stack.size() >= 2);
+            auto const op = static_cast<build_guard_binary_operator_node::op_type>(instruction.operand);
+            try {
+                stack[stack.size() - 2] = build_guard_binary_operator_node::evaluate_operator(op, stack[stack.size() - 2], stack.back());
+            } catch (std::invalid_argument const&) {
+                return std::unexpected{hkc_error::invalid_operand_types};
+            }
+            stack.pop_back();
+            break;
+        }
+        }
+    }
+
+    assert(stack.size() == 1);
+    return std::move(stack.back());
+}
+
+} // namespace hk::ast
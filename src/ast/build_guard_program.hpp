@@ -0,0 +1,104 @@
+
+#pragma once
+
+#include "build_guard_expression_node.hpp"
+#include "build_guard_binary_operator_node.hpp"
+#include "build_guard_unary_operator_node.hpp"
+#include "utility/datum.hpp"
+#include "utility/datum_namespace.hpp"
+#include "utility/fqname.hpp"
+#include "utility/interned_string.hpp"
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <vector>
+
+namespace hk::ast {
+
+/** A build-guard expression compiled to byte-code.
+ *
+ * The byte-code is a postfix program for a small stack machine. Sub-expressions
+ * that only use literals are folded into a single constant when compiling.
+ *
+ * Evaluating a program does not report errors, on failure the expression tree
+ * should be evaluated to report the error at the correct location.
+ */
+class build_guard_program {
+public:
+    enum class opcode : uint8_t {
+        /** Push `constants[operand]`.
+         */
+        constant,
+
+        /** Push the value of `variables[operand]` from the namespace.
+         */
+        variable,
+
+        /** Apply the unary operator `operand` on the top of the stack.
+         */
+        unary_operator,
+
+        /** Apply the binary operator `operand` on the top two values of the stack.
+         */
+        binary_operator,
+    };
+
+    struct instruction {
+        opcode code;
+        uint32_t operand;
+
+        [[nodiscard]] constexpr friend bool operator==(instruction const&, instruction const&) noexcept = default;
+    };
+
+    build_guard_program() = default;
+
+    /** Compile a build-guard expression.
+     *
+     * @param root The root of the expression tree.
+     */
+    explicit build_guard_program(build_guard_expression_node const& root);
+
+    [[nodiscard]] std::vector<instruction> const& instructions() const noexcept
+    {
+        return _instructions;
+    }
+
+    /** The program is a single constant.
+     */
+    [[nodiscard]] bool is_constant() const noexcept
+    {
+        return _instructions.size() == 1 and _instructions.front().code == opcode::constant;
+    }
+
+    /** A canonical text representation of the program.
+     *
+     * Two programs with the same key compute the same value, even when
+     * their source text differs in white-space, comments or parentheses.
+     */
+    [[nodiscard]] std::string key() const;
+
+    /** Evaluate the program.
+     *
+     * @param ctx The namespace with the values of the variables.
+     * @return The value, or an error if a variable is unknown or the
+     *         operands of an operator have invalid types.
+     */
+    [[nodiscard]] std::expected<datum, hkc_error> evaluate(datum_namespace const& ctx) const;
+
+private:
+    std::vector<instruction> _instructions = {};
+    std::vector<datum> _constants = {};
+
+    /** The interned names of the variables.
+     */
+    std::vector<interned_string> _variables = {};
+
+    /** The maximum size of the stack during evaluation.
+     */
+    size_t _stack_size = 0;
+
+    void compile(build_guard_expression_node const& n);
+    void add_constant(datum value);
+};
+
+} // namespace hk::ast
@@ -0,0 +1,132 @@
+
+#include "build_guard_program.hpp"
+#include "build_guard_cache.hpp"
+#include "build_guard_literal_node.hpp"
+#include "build_guard_variable_node.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+
+namespace {
+
+using hk::ast::build_guard_binary_operator_node;
+using hk::ast::build_guard_expression_node_ptr;
+using hk::ast::build_guard_literal_node;
+using hk::ast::build_guard_program;
+using hk::ast::build_guard_unary_operator_node;
+using hk::ast::build_guard_variable_node;
+
+build_guard_expression_node_ptr literal(hk::datum value)
+{
+    auto r = std::make_unique<build_guard_literal_node>(nullptr, nullptr, false);
+    r->value = std::move(value);
+    return r;
+}
+
+build_guard_expression_node_ptr variable(char const* name)
+{
+    return std::make_unique<build_guard_variable_node>(nullptr, nullptr, hk::fqname{name});
+}
+
+build_guard_expression_node_ptr
+binary(build_guard_binary_operator_node::op_type op, build_guard_expression_node_ptr lhs, build_guard_expression_node_ptr rhs)
+{
+    auto r = std::make_unique<build_guard_binary_operator_node>(nullptr, nullptr, op);
+    r->lhs = std::move(lhs);
+    r->rhs = std::move(rhs);
+    return r;
+}
+
+build_guard_expression_node_ptr _not(build_guard_expression_node_ptr rhs)
+{
+    auto r = std::make_unique<build_guard_unary_operator_node>(nullptr, nullptr, build_guard_unary_operator_node::op_type::_not);
+    r->rhs = std::move(rhs);
+    return r;
+}
+
+} // namespace
+
+TEST_SUITE(build_guard_program_suite)
+{
+
+TEST_CASE(evaluate)
+{
+    using enum build_guard_binary_operator_node::op_type;
+
+    // .target.os == "linux" or not .debug
+    auto const tree = binary(
+        _or, binary(eq, variable(".target.os"), literal(std::string{"linux"})), _not(variable(".debug")));
+    auto const program = build_guard_program{*tree};
+    REQUIRE(program.instructions().size() == 6);
+
+    auto ns = hk::datum_namespace{};
+    ns.set(hk::fqname{".target.os"}, std::string{"windows"});
+    ns.set(hk::fqname{".debug"}, true);
+    REQUIRE(program.evaluate(ns) == hk::datum{false});
+
+    ns.set(hk::fqname{".debug"}, false);
+    REQUIRE(program.evaluate(ns) == hk::datum{true});
+
+    ns.set(hk::fqname{".target.os"}, std::string{"linux"});
+    ns.set(hk::fqname{".debug"}, true);
+    REQUIRE(program.evaluate(ns) == hk::datum{true});
+
+    ns.remove(hk::fqname{".debug"});
+    REQUIRE(program.evaluate(ns) == std::unexpected{hk::hkc_error::unknown_build_guard_constant});
+}
+
+TEST_CASE(constant_folding)
+{
+    using enum build_guard_binary_operator_node::op_type;
+
+    // not (1 == 2) and 3 < 4
+    auto const tree = binary(_and, _not(binary(eq, literal(1LL), literal(2LL))), binary(lt, literal(3LL), literal(4LL)));
+    auto const program = build_guard_program{*tree};
+    REQUIRE(program.is_constant());
+    REQUIRE(program.evaluate(hk::datum_namespace{}) == hk::datum{true});
+}
+
+TEST_CASE(partial_constant_folding)
+{
+    using enum build_guard_binary_operator_node::op_type;
+
+    // .debug and 1 == 1
+    auto const tree = binary(_and, variable(".debug"), binary(eq, literal(1LL), literal(1LL)));
+    auto const program = build_guard_program{*tree};
+    REQUIRE(not program.is_constant());
+    REQUIRE(program.instructions().size() == 3);
+    REQUIRE(program.instructions()[1].code == build_guard_program::opcode::constant);
+}
+
+TEST_CASE(cache_deduplicates)
+{
+    using enum build_guard_binary_operator_node::op_type;
+
+    auto cache = hk::ast::build_guard_cache{};
+    auto const a = binary(eq, variable(".target.os"), literal(std::string{"linux"}));
+    auto const b = binary(eq, variable(".target.os"), literal(std::string{"linux"}));
+    auto const c = binary(eq, variable(".target.os"), literal(std::string{"linu"}));
+
+    auto const a_index = cache.add(*a);
+    REQUIRE(cache.add(*b) == a_index);
+    REQUIRE(cache.add(*c) != a_index);
+    REQUIRE(cache.size() == 2);
+}
+
+TEST_CASE(cache_follows_version)
+{
+    using enum build_guard_binary_operator_node::op_type;
+
+    auto cache = hk::ast::build_guard_cache{};
+    auto const tree = binary(eq, variable(".target.os"), literal(std::string{"linux"}));
+    auto const index = cache.add(*tree);
+
+    auto ns = hk::datum_namespace{};
+    ns.set(hk::fqname{".target.os"}, std::string{"linux"});
+    REQUIRE(cache.evaluate(index, ns) == hk::datum{true});
+    REQUIRE(cache.evaluate(index, ns) == hk::datum{true});
+
+    ns.set(hk::fqname{".target.os"}, std::string{"windows"});
+    REQUIRE(cache.evaluate(index, ns) == hk::datum{false});
+}
+
+};
@@ -27,18 +27,33 @@ public:
         }
 
         try {
-            switch (op) {
-            case op_type::_not:
-                return not *rhs_;
-            }
-            std::unreachable();
-
+            return evaluate_operator(op, *rhs_);
         } catch (std::invalid_argument const&) {
             return add(hkc_error::invalid_operand_types, "rhs: {}", rhs_->repr());
         }
     }
 
-    [[nodiscard]] size_t precedence() const
+    /** Apply a unary operator on a value.
+     *
+     * @param op The operator.
+     * @param rhs The operand.
+     * @return The result of the operation.
+     * @throws std::invalid_argument When the operand type is invalid for the operator.
+     */
+    [[nodiscard]] static datum evaluate_operator(op_type op, datum const& rhs)
+    {
+        switch (op) {
+        case op_type::_not:
+            return not rhs;
+        }
+        std::unreachable();
+    }
+
+    /** The precedence of an operator.
+     *
+     * A lower value binds tighter, like the precedence table of C++.
+     */
+    [[nodiscard]] constexpr static size_t precedence(op_type op) noexcept
     {
         // clang-format off
         switch (op) {
@@ -48,19 +63,21 @@ public:
         std::unreachable();
     }
 
+    [[nodiscard]] size_t precedence() const
+    {
+        return precedence(op);
+    }
+
     [[nodiscard]] bool left_to_right() const
     {
         return false;
     }
 
-    [[nodiscard]] generator<node*> children() const override
+    void append_children(std::vector<node *>& r) const override
     {
-        for (auto x : build_guard_expression_node::children()) {
-            co_yield x;
-        }
-
+        build_guard_expression_node::append_children(r);
         if (rhs) {
-            co_yield rhs.get();
+            r.push_back(rhs.get());
         }
     }
 };
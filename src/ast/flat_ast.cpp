@@ -0,0 +1,220 @@
+
+#include "flat_ast.hpp"
+#include "build_guard_literal_node.hpp"
+#include "build_guard_variable_node.hpp"
+#include "import_library_declaration_node.hpp"
+#include "import_module_declaration_node.hpp"
+#include "import_repository_declaration_node.hpp"
+#include "library_declaration_node.hpp"
+#include "library_node.hpp"
+#include "module_declaration_node.hpp"
+#include "module_node.hpp"
+#include "program_declaration_node.hpp"
+#include "program_node.hpp"
+
+namespace hk::ast {
+
+/** Get the kind of a node in the tree.
+ */
+[[nodiscard]] static node_kind get_node_kind(node const& n) noexcept
+{
+    // Order from most to least derived.
+    if (dynamic_cast<module_node const*>(&n)) {
+        return node_kind::module;
+    } else if (dynamic_cast<program_node const*>(&n)) {
+        return node_kind::program;
+    } else if (dynamic_cast<library_node const*>(&n)) {
+        return node_kind::library;
+    } else if (dynamic_cast<module_declaration_node const*>(&n)) {
+        return node_kind::module_declaration;
+    } else if (dynamic_cast<program_declaration_node const*>(&n)) {
+        return node_kind::program_declaration;
+    } else if (dynamic_cast<library_declaration_node const*>(&n)) {
+        return node_kind::library_declaration;
+    } else if (dynamic_cast<import_repository_declaration_node const*>(&n)) {
+        return node_kind::import_repository_declaration;
+    } else if (dynamic_cast<import_module_declaration_node const*>(&n)) {
+        return node_kind::import_module_declaration;
+    } else if (dynamic_cast<import_library_declaration_node const*>(&n)) {
+        return node_kind::import_library_declaration;
+    } else if (dynamic_cast<build_guard_literal_node const*>(&n)) {
+        return node_kind::build_guard_literal;
+    } else if (dynamic_cast<build_guard_variable_node const*>(&n)) {
+        return node_kind::build_guard_variable;
+    } else if (dynamic_cast<build_guard_unary_operator_node const*>(&n)) {
+        return node_kind::build_guard_unary_operator;
+    } else if (dynamic_cast<build_guard_binary_operator_node const*>(&n)) {
+        return node_kind::build_guard_binary_operator;
+    } else {
+        return node_kind::other;
+    }
+}
+
+flat_ast::flat_ast(node const& root) : _text(root.first)
+{
+    auto offset = [&](char const* p) -> uint32_t {
+        if (p == nullptr) {
+            return no_offset;
+        }
+        assert(p >= _text);
+        assert(p - _text < no_offset);
+        return static_cast<uint32_t>(p - _text);
+    };
+
+    // Breadth-first; `queue` doubles as the list of nodes in index order.
+    auto queue = std::vector<node *>{const_cast<node *>(&root)};
+    _parents.push_back(no_node);
+
+    for (auto i = 0uz; i != queue.size(); ++i) {
+        auto const& n = *queue[i];
+
+        _first_child.push_back(static_cast<node_index>(queue.size()));
+        n.append_children(queue);
+        _parents.resize(queue.size(), static_cast<node_index>(i));
+
+        auto const kind = get_node_kind(n);
+        auto payload = uint32_t{};
+        if (kind == node_kind::build_guard_literal) {
+            payload = static_cast<uint32_t>(_literals.size());
+            _literals.push_back(static_cast<build_guard_literal_node const&>(n).value);
+
+        } else if (kind == node_kind::build_guard_variable) {
+            payload = static_cast<uint32_t>(_variables.size());
+            _variables.push_back(static_cast<build_guard_variable_node const&>(n).name);
+
+        } else if (kind == node_kind::build_guard_unary_operator) {
+            payload = static_cast<uint32_t>(static_cast<build_guard_unary_operator_node const&>(n).op);
+
+        } else if (kind == node_kind::build_guard_binary_operator) {
+            payload = static_cast<uint32_t>(static_cast<build_guard_binary_operator_node const&>(n).op);
+
+        } else if (is_declaration(kind)) {
+            payload = static_cast<uint32_t>(_build_guard_results.size());
+            _build_guard_results.push_back(logic::F);
+        }
+
+        _kinds.push_back(kind);
+        _payloads.push_back(payload);
+        _firsts.push_back(offset(n.first));
+        _lasts.push_back(offset(n.last));
+    }
+    _first_child.push_back(static_cast<node_index>(queue.size()));
+
+    _kinds.shrink_to_fit();
+    _payloads.shrink_to_fit();
+    _parents.shrink_to_fit();
+    _first_child.shrink_to_fit();
+    _firsts.shrink_to_fit();
+    _lasts.shrink_to_fit();
+}
+
+void flat_ast::fixup() noexcept
+{
+    // Children always have a higher index than their parent, so walking
+    // backward visits all children before their parent.
+    for (auto i = static_cast<node_index>(size()); i-- != 0;) {
+        if (_lasts[i] != no_offset) {
+            continue;
+        }
+
+        for (auto child : children(i)) {
+            if (_lasts[child] != no_offset) {
+                _lasts[i] = _lasts[child];
+            }
+        }
+    }
+}
+
+std::expected<void, hkc_error> flat_ast::evaluate_build_guard(datum_namespace const& ctx, error_list& errors, line_table const& lines)
+{
+    auto last_error = hkc_error::none;
+
+    for (auto i = node_index{}; i != size(); ++i) {
+        if (not is_declaration(_kinds[i])) {
+            continue;
+        }
+
+        auto& result = _build_guard_results[_payloads[i]];
+
+        // The build-guard is the only child of a declaration.
+        auto const c = children(i);
+        if (c.empty()) {
+            // Fallback.
+            result = logic::_;
+
+        } else if (auto r = evaluate_expression(c.front(), ctx, errors, lines)) {
+            result = to_logic(static_cast<bool>(*r));
+
+        } else {
+            result = logic::X;
+            last_error = r.error();
+        }
+    }
+
+    if (last_error != hkc_error::none) {
+        return std::unexpected{last_error};
+    }
+    return {};
+}
+
+[[nodiscard]] std::expected<datum, hkc_error>
+flat_ast::evaluate_expression(node_index i, datum_namespace const& ctx, error_list& errors, line_table const& lines) const
+{
+    auto add = [&](hkc_error error, std::string message) {
+        auto const [it, _] = errors.add(lines, first(i), last(i), error, std::move(message));
+        return std::unexpected{it->code()};
+    };
+
+    switch (_kinds[i]) {
+    case node_kind::build_guard_literal:
+        return literal(i);
+
+    case node_kind::build_guard_variable:
+        if (auto optional_value = ctx.get(variable(i))) {
+            return *optional_value;
+        } else {
+            return add(hkc_error::unknown_build_guard_constant, std::format("{}", variable(i)));
+        }
+
+    case node_kind::build_guard_unary_operator: {
+        auto const op = static_cast<build_guard_unary_operator_node::op_type>(_payloads[i]);
+        auto const rhs = evaluate_expression(children(i).front(), ctx, errors, lines);
+        if (not rhs) {
+            return std::unexpected{rhs.error()};
+        }
+
+        try {
+            return build_guard_unary_operator_node::evaluate_operator(op, *rhs);
+        } catch (std::invalid_argument const&) {
+            return add(hkc_error::invalid_operand_types, std::format("rhs: {}", rhs->repr()));
+        }
+    }
+
+    case node_kind::build_guard_binary_operator: {
+        auto const op = static_cast<build_guard_binary_operator_node::op_type>(_payloads[i]);
+        auto const c = children(i);
+        assert(c.size() == 2);
+
+        auto const lhs = evaluate_expression(c[0], ctx, errors, lines);
+        if (not lhs) {
+            return std::unexpected{lhs.error()};
+        }
+
+        auto const rhs = evaluate_expression(c[1], ctx, errors, lines);
+        if (not rhs) {
+            return std::unexpected{rhs.error()};
+        }
+
+        try {
+            return build_guard_binary_operator_node::evaluate_operator(op, *lhs, *rhs);
+        } catch (std::invalid_argument const&) {
+            return add(hkc_error::invalid_operand_types, std::format("lhs: {}, rhs: {}", lhs->repr(), rhs->repr()));
+        }
+    }
+
+    default:
+        std::unreachable();
+    }
+}
+
+} // namespace hk::ast
@@ -0,0 +1,229 @@
+
+#pragma once
+
+#include "node.hpp"
+#include "build_guard_binary_operator_node.hpp"
+#include "build_guard_unary_operator_node.hpp"
+#include "error/error_list.hpp"
+#include "tokenizer/line_table.hpp"
+#include "utility/datum.hpp"
+#include "utility/datum_namespace.hpp"
+#include "utility/fqname.hpp"
+#include "utility/logic.hpp"
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <ranges>
+#include <vector>
+#include <cassert>
+
+namespace hk::ast {
+
+/** The kind of a node in a flat AST.
+ */
+enum class node_kind : uint8_t {
+    other,
+    module,
+    program,
+    library,
+    module_declaration,
+    program_declaration,
+    library_declaration,
+    import_repository_declaration,
+    import_module_declaration,
+    import_library_declaration,
+    build_guard_literal,
+    build_guard_variable,
+    build_guard_unary_operator,
+    build_guard_binary_operator,
+};
+
+/** Index of a node in a flat AST.
+ */
+using node_index = uint32_t;
+
+/** Index used for "no node", for example the parent of the root.
+ */
+constexpr auto no_node = std::numeric_limits<node_index>::max();
+
+/** A data-oriented representation of an AST.
+ *
+ * Nodes are stored in breadth-first order in a set of parallel arrays. Because
+ * of the breadth-first order the children of a node are a contiguous range of
+ * node indices, and the child-ranges of consecutive nodes are adjacent. This
+ * means that `children()` is encoded in a single 32-bit index per node, and
+ * that every child has a higher index than its parent.
+ *
+ * The token range of each node is stored as 32-bit offsets from the first
+ * character of the root node. Data specific to a kind of node, like the value
+ * of a literal, is stored in separate arrays indexed through a per-node
+ * payload.
+ *
+ * Walking the tree, `fixup()` and `evaluate_build_guard()` do not make virtual
+ * calls or allocate.
+ */
+class flat_ast {
+public:
+    flat_ast() = default;
+    flat_ast(flat_ast const&) = default;
+    flat_ast(flat_ast&&) = default;
+    flat_ast& operator=(flat_ast const&) = default;
+    flat_ast& operator=(flat_ast&&) = default;
+
+    /** Convert a tree of nodes into a flat AST.
+     *
+     * @param root The root of the tree.
+     */
+    explicit flat_ast(node const& root);
+
+    /** The number of nodes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _kinds.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _kinds.empty();
+    }
+
+    /** The kind of a node.
+     */
+    [[nodiscard]] node_kind kind(node_index i) const noexcept
+    {
+        assert(i < size());
+        return _kinds[i];
+    }
+
+    /** The parent of a node, or `no_node` for the root.
+     */
+    [[nodiscard]] node_index parent(node_index i) const noexcept
+    {
+        assert(i < size());
+        return _parents[i];
+    }
+
+    /** The children of a node.
+     *
+     * @return A range of node indices.
+     */
+    [[nodiscard]] auto children(node_index i) const noexcept
+    {
+        assert(i < size());
+        return std::views::iota(_first_child[i], _first_child[i + 1]);
+    }
+
+    /** The location of the first character of a node.
+     */
+    [[nodiscard]] char const* first(node_index i) const noexcept
+    {
+        assert(i < size());
+        return _text + _firsts[i];
+    }
+
+    /** One beyond the location of the last character of a node.
+     *
+     * @return The location, or nullptr if not known before `fixup()`.
+     */
+    [[nodiscard]] char const* last(node_index i) const noexcept
+    {
+        assert(i < size());
+        return _lasts[i] == no_offset ? nullptr : _text + _lasts[i];
+    }
+
+    /** The value of a build_guard_literal node.
+     */
+    [[nodiscard]] datum const& literal(node_index i) const noexcept
+    {
+        assert(kind(i) == node_kind::build_guard_literal);
+        return _literals[_payloads[i]];
+    }
+
+    /** The name of a build_guard_variable node.
+     */
+    [[nodiscard]] fqname const& variable(node_index i) const noexcept
+    {
+        assert(kind(i) == node_kind::build_guard_variable);
+        return _variables[_payloads[i]];
+    }
+
+    /** The result of the last `evaluate_build_guard()` for a declaration.
+     *
+     * @param i A declaration or import node.
+     */
+    [[nodiscard]] logic enabled(node_index i) const noexcept
+    {
+        assert(is_declaration(kind(i)));
+        return _build_guard_results[_payloads[i]];
+    }
+
+    /** Fill in the missing `last` of each node from its children.
+     *
+     * This is the same as `node::fixup()`, nodes without a `last` get the
+     * `last` of their last child that has one.
+     */
+    void fixup() noexcept;
+
+    /** Evaluate the build-guards of all declarations and imports.
+     *
+     * @param ctx The namespace used by the build-guard expressions.
+     * @param errors The list to add evaluation errors to.
+     * @param lines The line table of the source, used for error messages.
+     * @return The last error, if any.
+     */
+    std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx, error_list& errors, line_table const& lines);
+
+    /** The memory in bytes used by the nodes, excluding the payloads.
+     */
+    [[nodiscard]] std::size_t node_capacity_in_bytes() const noexcept
+    {
+        return _kinds.capacity() * sizeof(node_kind) + _payloads.capacity() * sizeof(uint32_t) +
+            _parents.capacity() * sizeof(node_index) + _first_child.capacity() * sizeof(node_index) +
+            _firsts.capacity() * sizeof(uint32_t) + _lasts.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    constexpr static auto no_offset = std::numeric_limits<uint32_t>::max();
+
+    /** The first character of the root node; the base of the token offsets.
+     */
+    char const* _text = nullptr;
+
+    std::vector<node_kind> _kinds;
+    std::vector<uint32_t> _payloads;
+    std::vector<node_index> _parents;
+
+    /** The first child of each node, with an extra entry at the end.
+     *
+     * The children of node `i` are `[_first_child[i], _first_child[i + 1])`.
+     */
+    std::vector<node_index> _first_child;
+
+    std::vector<uint32_t> _firsts;
+    std::vector<uint32_t> _lasts;
+
+    std::vector<datum> _literals;
+    std::vector<fqname> _variables;
+    std::vector<logic> _build_guard_results;
+
+    [[nodiscard]] constexpr static bool is_declaration(node_kind kind) noexcept
+    {
+        switch (kind) {
+        case node_kind::module_declaration:
+        case node_kind::program_declaration:
+        case node_kind::library_declaration:
+        case node_kind::import_repository_declaration:
+        case node_kind::import_module_declaration:
+        case node_kind::import_library_declaration:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    [[nodiscard]] std::expected<datum, hkc_error>
+    evaluate_expression(node_index i, datum_namespace const& ctx, error_list& errors, line_table const& lines) const;
+};
+
+} // namespace hk::ast
@@ -0,0 +1,93 @@
+
+#include "flat_ast.hpp"
+#include "parser/parse_top.hpp"
+#include "tokenizer/validate_utf8.hpp"
+#include "bench_utilities/corpus.hpp"
+#include "utility/datum_namespace.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/** The prologue of a generated module with `state.range(0)` imports.
+ *
+ * A third of the imports have a build-guard.
+ */
+struct prologue {
+    std::string text;
+    hk::parse_context ctx;
+    std::unique_ptr<hk::ast::top_node> tree;
+
+    prologue(benchmark::State const& state) : ctx(hk::line_table{})
+    {
+        auto options = bench::corpus_options{};
+        options.num_imports = static_cast<std::size_t>(state.range(0));
+        options.num_declarations = 0;
+        text = bench::pad_source_code(bench::generate_module("bench.flat_ast", options));
+
+        ctx.lines().add_file(text.data(), text.data() + text.size(), "<bench>");
+        ctx.lines().set_ascii(hk::validate_utf8(text.data(), text.data() + text.size()).ascii);
+        if (auto optional_tree = hk::parse_top(text.data(), ctx, true); optional_tree and ctx.errors().empty()) {
+            tree = std::move(optional_tree).value();
+        } else {
+            throw std::runtime_error("Could not parse the prologue of the generated module");
+        }
+    }
+};
+
+void set_guard_namespace(hk::datum_namespace& guard_namespace)
+{
+    guard_namespace.set(hk::fqname{".target.os"}, std::string{"linux"});
+    guard_namespace.set(hk::fqname{".target.cpu"}, std::string{"x86_64"});
+    guard_namespace.set(hk::fqname{".debug"}, false);
+}
+
+void bm_flat_ast_construct(benchmark::State& state)
+{
+    auto const p = prologue{state};
+
+    for (auto _ : state) {
+        auto ast = hk::ast::flat_ast{*p.tree};
+        benchmark::DoNotOptimize(ast);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_flat_ast_evaluate_build_guard(benchmark::State& state)
+{
+    auto p = prologue{state};
+    auto ast = hk::ast::flat_ast{*p.tree};
+    auto guard_namespace = hk::datum_namespace{};
+    set_guard_namespace(guard_namespace);
+    auto errors = hk::error_list{};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ast.evaluate_build_guard(guard_namespace, errors, p.ctx.lines()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** The baseline for `bm_flat_ast_evaluate_build_guard`, walking the node tree.
+ */
+void bm_node_tree_evaluate_build_guard(benchmark::State& state)
+{
+    auto p = prologue{state};
+    auto guard_namespace = hk::datum_namespace{};
+    set_guard_namespace(guard_namespace);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.tree->evaluate_build_guard(guard_namespace));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(bm_flat_ast_construct)->Arg(16)->Arg(1024);
+BENCHMARK(bm_flat_ast_evaluate_build_guard)->Arg(16)->Arg(1024);
+BENCHMARK(bm_node_tree_evaluate_build_guard)->Arg(16)->Arg(1024);
@@ -0,0 +1,129 @@
+
+#include "flat_ast.hpp"
+#include "build_guard_literal_node.hpp"
+#include "build_guard_variable_node.hpp"
+#include "module_node.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+
+TEST_SUITE(flat_ast_suite)
+{
+
+/** Build the tree for `module com.example.foo if .target.os == "linux" or not .debug`.
+ */
+static hk::ast::module_node_ptr make_module(std::string const& text)
+{
+    using namespace hk::ast;
+
+    auto const p = text.data();
+    auto declaration = std::make_unique<module_declaration_node>(p);
+    declaration->name = hk::fqname{"com.example.foo"};
+
+    auto eq = std::make_unique<build_guard_binary_operator_node>(p + 26, p + 47, build_guard_binary_operator_node::op_type::eq);
+    eq->lhs = std::make_unique<build_guard_variable_node>(p + 26, p + 36, hk::fqname{".target.os"});
+    eq->rhs = std::make_unique<build_guard_literal_node>(p + 40, p + 47, std::string{"linux"});
+
+    auto no = std::make_unique<build_guard_unary_operator_node>(p + 51, p + 61, build_guard_unary_operator_node::op_type::_not);
+    no->rhs = std::make_unique<build_guard_variable_node>(p + 55, p + 61, hk::fqname{".debug"});
+
+    auto or_ = std::make_unique<build_guard_binary_operator_node>(p + 26, nullptr, build_guard_binary_operator_node::op_type::_or);
+    or_->lhs = std::move(eq);
+    or_->rhs = std::move(no);
+    declaration->build_guard = std::move(or_);
+
+    return std::make_unique<module_node>(p, std::move(declaration));
+}
+
+TEST_CASE(structure)
+{
+    auto const text = std::string{"module com.example.foo if .target.os == \"linux\" or not .debug\n"};
+    auto const tree = make_module(text);
+    auto const ast = hk::ast::flat_ast{*tree};
+
+    REQUIRE(ast.size() == 8);
+    REQUIRE(ast.kind(0) == hk::ast::node_kind::module);
+    REQUIRE(ast.parent(0) == hk::ast::no_node);
+    REQUIRE(ast.children(0).size() == 1);
+
+    auto const declaration = ast.children(0).front();
+    REQUIRE(ast.kind(declaration) == hk::ast::node_kind::module_declaration);
+    REQUIRE(ast.parent(declaration) == 0);
+    REQUIRE(ast.children(declaration).size() == 1);
+
+    auto const or_ = ast.children(declaration).front();
+    REQUIRE(ast.kind(or_) == hk::ast::node_kind::build_guard_binary_operator);
+    REQUIRE(ast.children(or_).size() == 2);
+
+    auto const eq = ast.children(or_)[0];
+    REQUIRE(ast.kind(eq) == hk::ast::node_kind::build_guard_binary_operator);
+    REQUIRE(ast.parent(eq) == or_);
+    REQUIRE(ast.variable(ast.children(eq)[0]) == hk::fqname{".target.os"});
+    REQUIRE(ast.literal(ast.children(eq)[1]) == hk::datum{std::string{"linux"}});
+
+    auto const no = ast.children(or_)[1];
+    REQUIRE(ast.kind(no) == hk::ast::node_kind::build_guard_unary_operator);
+    REQUIRE(ast.first(no) == text.data() + 51);
+}
+
+TEST_CASE(fixup)
+{
+    auto const text = std::string{"module com.example.foo if .target.os == \"linux\" or not .debug\n"};
+    auto const tree = make_module(text);
+    auto ast = hk::ast::flat_ast{*tree};
+
+    REQUIRE(ast.last(0) == nullptr);
+    ast.fixup();
+
+    // The last of the module is the last of `not .debug`.
+    REQUIRE(ast.last(0) == text.data() + 61);
+    REQUIRE(ast.last(ast.children(0).front()) == text.data() + 61);
+}
+
+TEST_CASE(evaluate_build_guard)
+{
+    auto const text = std::string{"module com.example.foo if .target.os == \"linux\" or not .debug\n"};
+    auto const tree = make_module(text);
+    auto ast = hk::ast::flat_ast{*tree};
+    auto const declaration = ast.children(0).front();
+
+    auto errors = hk::error_list{};
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<text>");
+
+    auto evaluate = [&](std::string os, bool debug) {
+        auto ctx = hk::datum_namespace{};
+        ctx.set(hk::fqname{".target.os"}, std::move(os));
+        ctx.set(hk::fqname{".debug"}, debug);
+        REQUIRE(ast.evaluate_build_guard(ctx, errors, lines).has_value());
+        return ast.enabled(declaration);
+    };
+
+    REQUIRE(evaluate("windows", true) == hk::logic::F);
+    REQUIRE(evaluate("windows", false) == hk::logic::T);
+    REQUIRE(evaluate("linux", true) == hk::logic::T);
+    REQUIRE(errors.empty());
+}
+
+TEST_CASE(same_as_tree)
+{
+    auto const text = std::string{"module com.example.foo if .target.os == \"linux\" or not .debug\n"};
+    auto const tree = make_module(text);
+    auto ast = hk::ast::flat_ast{*tree};
+
+    tree->fixup(nullptr);
+    ast.fixup();
+
+    auto& declaration = tree->declaration();
+    REQUIRE(&declaration.parent() == tree.get());
+    REQUIRE(&declaration.build_guard->parent() == &declaration);
+    REQUIRE(tree->last == ast.last(0));
+    REQUIRE(declaration.last == ast.last(1));
+
+    auto ctx = hk::datum_namespace{};
+    ctx.set(hk::fqname{".target.os"}, std::string{"linux"});
+    ctx.set(hk::fqname{".debug"}, true);
+    REQUIRE(tree->evaluate_build_guard(ctx).has_value());
+    REQUIRE(tree->enabled() == hk::logic::T);
+}
+
+};
@@ -18,12 +18,17 @@ public:
     {
     }
 
+    [[nodiscard]] bool has_build_guard() const noexcept override
+    {
+        return true;
+    }
+
     std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx) override
     {
         if (build_guard == nullptr) {
             _build_guard_result = logic::_;
             return {};
-        } else if (auto r = build_guard->evaluate_expression(ctx)) {
+        } else if (auto r = build_guard->evaluate_build_guard_expression(ctx)) {
             _build_guard_result = to_logic(static_cast<bool>(*r));
             return {};
         } else {
@@ -32,14 +37,11 @@ public:
         }
     }
 
-    [[nodiscard]] generator<node *> children() const override
+    void append_children(std::vector<node *>& r) const override
     {
-        for (auto ptr : node::children()) {
-            co_yield ptr;
-        }
-
+        node::append_children(r);
         assert(build_guard != nullptr);
-        co_yield build_guard.get();
+        r.push_back(build_guard.get());
     }
 
     /** Is this top node enabled.
@@ -1,6 +1,7 @@
 
 #include "node.hpp"
 #include "repository/source.hpp"
+#include "utility/depth_first.hpp"
 
 namespace hk::ast {
 
@@ -11,16 +12,26 @@ std::unexpected<hkc_error> node::_add(hkc_error error, std::string message) cons
     return std::unexpected{it->code()};
 }
 
+static void append_node_children(node& n, std::vector<node *>& r)
+{
+    n.append_children(r);
+}
+
 std::expected<void, hkc_error> node::evaluate_build_guard(datum_namespace const& ctx)
 {
     auto last_error = hkc_error::none;
 
-    for (auto child_ptr : children()) {
-        assert(child_ptr != nullptr);
-        if (auto r = child_ptr->evaluate_build_guard(ctx); not r) {
+    auto walk = depth_first<node>{};
+    walk(*this, append_node_children, [&](node& n, node *) {
+        if (&n == this or not n.has_build_guard()) {
+            return true;
+        }
+
+        if (auto r = n.evaluate_build_guard(ctx); not r) {
             last_error = r.error();
         }
-    }
+        return false;
+    });
 
     if (last_error != hkc_error::none) {
         return std::unexpected{last_error};
@@ -29,4 +40,28 @@ std::expected<void, hkc_error> node::evaluate_build_guard(datum_namespace const&
     return {};
 }
 
-}
\ No newline at end of file
+char const *node::fixup(node *parent)
+{
+    auto walk = depth_first<node>{};
+    walk(
+        *this,
+        append_node_children,
+        [&](node& n, node *n_parent) {
+            n._parent = &n == this ? parent : n_parent;
+            return true;
+        },
+        [](node& n, node *, std::span<node * const> children) {
+            // The children have been fixed up before their parent.
+            if (n.last == nullptr) {
+                for (auto child : children) {
+                    if (child->last != nullptr) {
+                        n.last = child->last;
+                    }
+                }
+            }
+        });
+
+    return last;
+}
+
+}
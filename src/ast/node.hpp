@@ -3,10 +3,10 @@
 
 #include "error/hkc_error.hpp"
 #include "tokenizer/line_table.hpp"
-#include "utility/generator.hpp"
 #include "utility/datum_namespace.hpp"
 #include <string>
 #include <memory>
+#include <vector>
 #include <variant>
 #include <cassert>
 #include <expected>
@@ -73,9 +73,33 @@ public:
         return _add(error, std::format(std::move(fmt), std::forward<Args>(args)...));
     }
 
-    [[nodiscard]] virtual generator<node *> children() const
+    /** Append the direct children of this node.
+     *
+     * The children are appended to a vector owned by the caller, so that
+     * walking a tree does not allocate for each node.
+     *
+     * @param r The vector to append the children to.
+     */
+    virtual void append_children(std::vector<node *>& r) const {}
+
+    /** The direct children of this node.
+     */
+    [[nodiscard]] std::vector<node *> children() const
+    {
+        auto r = std::vector<node *>{};
+        append_children(r);
+        return r;
+    }
+
+    /** Check if this node has its own build-guard.
+     *
+     * `evaluate_build_guard()` of a node without a build-guard evaluates
+     * the build-guards of its descendants; it stops at the nodes that do
+     * have a build-guard, which evaluate it themselves.
+     */
+    [[nodiscard]] virtual bool has_build_guard() const noexcept
     {
-        co_return;
+        return false;
     }
 
     /** Evaluate conditional compilation expressions.
@@ -84,23 +108,14 @@ public:
      */
     virtual std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx);
 
-    virtual char const *fixup(node *parent)
-    {
-        char const *child_last = nullptr;
-
-        for (auto &node : children()) {
-            assert(node != nullptr);
-            if (auto p = node->fixup(this)) {
-                child_last = p;
-            }
-        }
-
-        _parent = parent;
-        if (last == nullptr) {
-            last = child_last;
-        }
-        return last;
-    }
+    /** Set the parent of each node, and the missing `last` of each node.
+     *
+     * Nodes without a `last` get the `last` of their last child that has one.
+     *
+     * @param parent The parent of this node.
+     * @return The `last` of this node.
+     */
+    char const *fixup(node *parent);
 
 protected:
     node *_parent = nullptr;
@@ -15,13 +15,10 @@ public:
         return *_declaration;
     }
 
-    [[nodiscard]] generator<node *> children() const override
+    void append_children(std::vector<node *>& r) const override
     {
-        for (auto _ : top_node::children()) {
-            co_yield _;
-        }
-        
-        co_yield _declaration.get();
+        top_node::append_children(r);
+        r.push_back(_declaration.get());
     }
 
     [[nodiscard]] logic enabled() noexcept override
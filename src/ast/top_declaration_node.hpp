@@ -18,17 +18,19 @@ public:
     build_guard_expression_node_ptr build_guard = nullptr;
 
 
-    [[nodiscard]] generator<node *> children() const override
+    void append_children(std::vector<node *>& r) const override
     {
-        for (auto x: node::children()) {
-            co_yield x;
-        }
-
+        node::append_children(r);
         if (build_guard) {
-            co_yield build_guard.get();
+            r.push_back(build_guard.get());
         }
     }
 
+    [[nodiscard]] bool has_build_guard() const noexcept override
+    {
+        return true;
+    }
+
     std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx) override
     {
         if (build_guard == nullptr) {
@@ -36,7 +38,7 @@ public:
             _build_guard_result = logic::_;
             return {};
 
-        } else if (auto r = build_guard->evaluate_expression(ctx)) {
+        } else if (auto r = build_guard->evaluate_build_guard_expression(ctx)) {
             _build_guard_result = to_logic(static_cast<bool>(*r));
             return {};
 
@@ -31,23 +31,20 @@ public:
         return *_source;
     }
 
-    [[nodiscard]] generator<node *> children() const override
+    void append_children(std::vector<node *>& r) const override
     {
-        for (auto ptr : node::children()) {
-            co_yield ptr;
+        node::append_children(r);
+        for (auto& ptr : remote_repositories) {
+            r.push_back(ptr.get());
         }
-
-        for (auto &ptr : remote_repositories) {
-            co_yield ptr.get();
-        }
-        for (auto &ptr : module_imports) {
-            co_yield ptr.get();
+        for (auto& ptr : module_imports) {
+            r.push_back(ptr.get());
         }
-        for (auto &ptr : library_imports) {
-            co_yield ptr.get();
+        for (auto& ptr : library_imports) {
+            r.push_back(ptr.get());
         }
-        for (auto &ptr : body) {
-            co_yield ptr.get();
+        for (auto& ptr : body) {
+            r.push_back(ptr.get());
         }
     }
 
@@ -0,0 +1,345 @@
+
+#include "corpus.hpp"
+#include "test_utilities/paths.hpp"
+#include "utility/read_file.hpp"
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace bench {
+
+namespace {
+
+class module_generator {
+public:
+    module_generator(corpus_options const& options) : _options(options), _engine(options.seed) {}
+
+    [[nodiscard]] std::string operator()(std::string_view module_name)
+    {
+        _r.clear();
+        _r += std::format("\nmodule {}", module_name);
+        if (not _options.build_guard.empty()) {
+            _r += std::format(" if {}", _options.build_guard);
+        }
+        _r += ";\n";
+
+        for (auto i = 0uz; i != _options.num_imports; ++i) {
+            generate_import(i);
+        }
+        _r += '\n';
+
+        for (auto i = 0uz; i != _options.num_declarations; ++i) {
+            if (chance(4)) {
+                generate_class(i);
+            } else {
+                generate_function(i, 0);
+            }
+            _r += '\n';
+        }
+        return std::move(_r);
+    }
+
+private:
+    corpus_options _options;
+    std::mt19937_64 _engine;
+    std::string _r;
+
+    /** A random number in the range [0, n).
+     */
+    [[nodiscard]] std::size_t random(std::size_t n)
+    {
+        return static_cast<std::size_t>(_engine() % n);
+    }
+
+    /** True one in @a n times.
+     */
+    [[nodiscard]] bool chance(std::size_t n)
+    {
+        return random(n) == 0;
+    }
+
+    void indent(std::size_t depth)
+    {
+        _r.append(depth * 4, ' ');
+    }
+
+    [[nodiscard]] std::string_view word()
+    {
+        constexpr auto words = std::array<std::string_view, 16>{
+            "count", "index", "value", "size", "offset", "stride", "first", "last",
+            "bitmap", "object", "segment", "page", "buffer", "length", "result", "state"};
+        return words[random(words.size())];
+    }
+
+    [[nodiscard]] std::string_view type_name()
+    {
+        constexpr auto types = std::array<std::string_view, 6>{
+            "__builtin_i64", "__builtin_u64", "__builtin_u32", "__builtin_u8", "__builtin_size", "long"};
+        return types[random(types.size())];
+    }
+
+    void generate_build_guard()
+    {
+        switch (random(4)) {
+        case 0:
+            _r += " if target.os == \"linux\"";
+            break;
+        case 1:
+            _r += " if target.os == \"windows\" or target.os == \"macos\"";
+            break;
+        case 2:
+            _r += " if not debug";
+            break;
+        default:
+            _r += " if target.cpu == \"x86_64\" and (debug or target.os != \"windows\")";
+            break;
+        }
+    }
+
+    void generate_import(std::size_t i)
+    {
+        if (i % 8 == 7) {
+            _r += std::format("import git \"https://github.com/example/repository-{}.git\" \"main\";\n", random(1000));
+            return;
+        }
+
+        auto const name = word();
+        _r += std::format("import bench.{}_{}", name, random(1000));
+        if (chance(3)) {
+            generate_build_guard();
+        }
+        _r += ";\n";
+    }
+
+    void generate_literal()
+    {
+        switch (random(6)) {
+        case 0:
+            _r += std::format("{}", random(100));
+            break;
+        case 1:
+            _r += std::format("0x{:x}", _engine());
+            break;
+        case 2: {
+            auto const a = random(1000);
+            auto const b = random(1000);
+            _r += std::format("{}'{:03}'{:03}", a, b, random(1000));
+            break;
+        }
+        case 3: {
+            auto const integer = random(1000);
+            auto const fraction = random(1000);
+            _r += std::format("{}.{}e{}", integer, fraction, random(40));
+            break;
+        }
+        case 4: {
+            auto const a = word();
+            _r += std::format("\"{} {}\"", a, word());
+            break;
+        }
+        default:
+            _r += std::format("{}", _engine());
+            break;
+        }
+    }
+
+    void generate_expression(std::size_t depth)
+    {
+        constexpr auto operators = std::array<std::string_view, 8>{" + ", " - ", " * ", " / ", " == ", " < ", " and ", " or "};
+
+        if (depth == 0 or chance(3)) {
+            if (chance(2)) {
+                generate_literal();
+            } else {
+                _r += word();
+            }
+            return;
+        }
+
+        auto const parenthesis = chance(3);
+        if (parenthesis) {
+            _r += '(';
+        }
+        generate_expression(depth - 1);
+        _r += operators[random(operators.size())];
+        generate_expression(depth - 1);
+        if (parenthesis) {
+            _r += ')';
+        }
+    }
+
+    void generate_block(std::size_t depth)
+    {
+        _r += "{\n";
+        auto const num_statements = 1 + random(6);
+        for (auto i = 0uz; i != num_statements; ++i) {
+            generate_statement(depth + 1);
+        }
+        indent(depth);
+        _r += "}\n";
+    }
+
+    void generate_statement(std::size_t depth)
+    {
+        indent(depth);
+
+        auto const nested = depth < _options.max_depth;
+        switch (random(nested ? 6 : 3)) {
+        case 0: {
+            auto const verb = word();
+            auto const noun = word();
+            _r += std::format("// {} the {} of the {}.\n", verb, noun, word());
+            indent(depth);
+            [[fallthrough]];
+        }
+        case 1: {
+            auto const name = word();
+            _r += std::format("var {}_{} = ", name, random(100));
+            generate_expression(3);
+            _r += '\n';
+            break;
+        }
+        case 2:
+            _r += "return ";
+            generate_expression(2);
+            _r += '\n';
+            break;
+        case 3:
+        case 4:
+            _r += "if (";
+            generate_expression(2);
+            _r += ") ";
+            generate_block(depth);
+            break;
+        default:
+            _r += "while (";
+            generate_expression(2);
+            _r += ") ";
+            generate_block(depth);
+            break;
+        }
+    }
+
+    void generate_function(std::size_t i, std::size_t depth)
+    {
+        indent(depth);
+        _r += "/** Compute the ";
+        _r += word();
+        _r += ".\n";
+        indent(depth);
+        _r += " */\n";
+
+        indent(depth);
+        _r += std::format("pub fn {}_{}(", word(), i);
+        auto const num_arguments = random(4);
+        for (auto j = 0uz; j != num_arguments; ++j) {
+            if (j != 0) {
+                _r += ", ";
+            }
+            auto const name = word();
+            _r += std::format("{}_{} : {}", name, j, type_name());
+        }
+        _r += std::format(") -> {}\n", type_name());
+        indent(depth);
+        generate_block(depth);
+    }
+
+    void generate_class(std::size_t i)
+    {
+        _r += std::format("pub class {}_{}\n{{\n", word(), i);
+        auto const num_members = 1 + random(4);
+        for (auto j = 0uz; j != num_members; ++j) {
+            auto const name = word();
+            _r += std::format("    var _{}_{} : {}\n", name, j, type_name());
+        }
+        _r += '\n';
+
+        auto const num_methods = 1 + random(3);
+        for (auto j = 0uz; j != num_methods; ++j) {
+            generate_function(j, 1);
+        }
+        _r += "}\n";
+    }
+};
+
+} // namespace
+
+[[nodiscard]] std::string pad_source_code(std::string text)
+{
+    text.append(8, '\0');
+    return text;
+}
+
+[[nodiscard]] std::string generate_module(std::string_view module_name, corpus_options const& options)
+{
+    return module_generator{options}(module_name);
+}
+
+static void write_corpus_file(std::filesystem::path const& path, std::string_view text)
+{
+    auto file = std::ofstream(path, std::ios::binary);
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (not file) {
+        throw std::runtime_error(std::format("Could not write corpus file {}", path.string()));
+    }
+}
+
+void write_corpus(std::filesystem::path const& directory, std::size_t num_modules, corpus_options const& options)
+{
+    std::filesystem::create_directories(directory);
+
+    auto anchor = std::format("\n// The anchor of the generated modules.\nmodule {} {}", options.anchor, options.anchor_version);
+    if (not options.build_guard.empty()) {
+        anchor += std::format(" if {}", options.build_guard);
+    }
+    anchor += ";\n";
+    for (auto const& url : options.git_imports) {
+        anchor += std::format("import git \"{}\" \"main\";\n", url);
+    }
+    write_corpus_file(directory / "anchor.hkm", anchor);
+
+    for (auto i = 0uz; i != num_modules; ++i) {
+        auto module_options = options;
+        module_options.seed = options.seed + i;
+
+        auto const text = generate_module(std::format("{}.m{}", options.anchor, i), module_options);
+        write_corpus_file(directory / std::format("m{}.hkm", i), text);
+    }
+}
+
+[[nodiscard]] static std::vector<corpus_file> load_source_tree_corpus()
+{
+    auto r = std::vector<corpus_file>{};
+
+    auto const source_path = test::source_path();
+    for (auto const directory : {source_path / "stdlib", source_path / "test_data"}) {
+        for (auto const& entry : std::filesystem::recursive_directory_iterator{directory}) {
+            if (not entry.is_regular_file() or entry.path().extension() != ".hkm") {
+                continue;
+            }
+
+            if (auto text = hk::read_file(entry.path(), 8)) {
+                r.emplace_back(entry.path(), std::move(text).value());
+            } else {
+                throw std::runtime_error(std::format("Could not read corpus file {}", entry.path().string()));
+            }
+        }
+    }
+
+    // The order of a directory iterator is unspecified.
+    std::ranges::sort(r, [](auto const& a, auto const& b) {
+        return a.path < b.path;
+    });
+    return r;
+}
+
+[[nodiscard]] std::vector<corpus_file> const& source_tree_corpus()
+{
+    static auto const r = load_source_tree_corpus();
+    return r;
+}
+
+} // namespace bench
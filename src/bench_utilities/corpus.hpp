@@ -0,0 +1,98 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+/** Options for generating a synthetic module.
+ */
+struct corpus_options {
+    /** The number of classes and functions in the body of the module.
+     */
+    std::size_t num_declarations = 64;
+
+    /** The maximum nesting depth of blocks inside a function.
+     */
+    std::size_t max_depth = 4;
+
+    /** The number of `import` statements in the prologue.
+     */
+    std::size_t num_imports = 8;
+
+    /** The build-guard expression of the module declaration, empty for none.
+     */
+    std::string build_guard = {};
+
+    /** The name of the anchor module written by `write_corpus()`.
+     */
+    std::string anchor = "bench";
+
+    /** The version of the anchor module.
+     */
+    std::string anchor_version = "1.0.0";
+
+    /** The URLs of the git repositories imported by the anchor module.
+     *
+     * Each repository is imported at its `main` branch.
+     */
+    std::vector<std::string> git_imports = {};
+
+    /** The seed of the random number generator.
+     *
+     * The same options always generate the same text.
+     */
+    uint64_t seed = 1;
+};
+
+/** A source file of the corpus.
+ */
+struct corpus_file {
+    std::filesystem::path path;
+
+    /** The text of the file followed by 8 nul characters.
+     */
+    std::string text;
+};
+
+/** Append the 8 nul characters that the tokenizer requires.
+ */
+[[nodiscard]] std::string pad_source_code(std::string text);
+
+/** Generate the text of a synthetic module.
+ *
+ * The module starts with a prologue with imports, some of which have a
+ * build-guard. The body has classes and functions with comments, nested
+ * `if` and `while` blocks and expressions with every kind of literal.
+ *
+ * @param module_name The name of the module.
+ * @param options The size and shape of the module.
+ * @return The text of the module, without nul padding.
+ */
+[[nodiscard]] std::string generate_module(std::string_view module_name, corpus_options const& options);
+
+/** Write generated modules into a directory.
+ *
+ * The modules are named `<anchor>.m<i>`, sub-modules of the anchor module
+ * which is written to `anchor.hkm`. The build-guard of the options is used
+ * for the anchor module as well.
+ *
+ * @param directory The directory to write the `.hkm` files to.
+ * @param num_modules The number of modules.
+ * @param options The size and shape of each module; the seed is varied
+ *                for each module.
+ */
+void write_corpus(std::filesystem::path const& directory, std::size_t num_modules, corpus_options const& options);
+
+/** The `.hkm` files from stdlib/ and test_data/ of the source tree.
+ *
+ * The files are loaded once, on the first call.
+ */
+[[nodiscard]] std::vector<corpus_file> const& source_tree_corpus();
+
+} // namespace bench
@@ -0,0 +1,150 @@
+
+#include "repository_graph.hpp"
+#include "utility/defer.hpp"
+#include <git2.h>
+#include <algorithm>
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+static void check_git_result(int result, std::string_view what, std::filesystem::path const& path)
+{
+    if (result < 0) {
+        auto const* const e = ::git_error_last();
+        throw std::runtime_error(
+            std::format("Could not {} '{}': {}", what, path.string(), e != nullptr ? e->message : "unknown error"));
+    }
+}
+
+void git_commit_directory(std::filesystem::path const& path)
+{
+    ::git_libgit2_init();
+    auto const d0 = hk::defer{[] {
+        ::git_libgit2_shutdown();
+    }};
+
+    ::git_repository* repository = nullptr;
+    check_git_result(::git_repository_init(&repository, path.string().c_str(), 0), "initialize git repository", path);
+    auto const d1 = hk::defer{[&] {
+        ::git_repository_free(repository);
+    }};
+
+    ::git_index* index = nullptr;
+    check_git_result(::git_repository_index(&index, repository), "open the index of", path);
+    auto const d2 = hk::defer{[&] {
+        ::git_index_free(index);
+    }};
+
+    char pattern[] = "*";
+    char* patterns[] = {pattern};
+    auto const pathspec = ::git_strarray{patterns, 1};
+    check_git_result(::git_index_add_all(index, &pathspec, GIT_INDEX_ADD_DEFAULT, nullptr, nullptr), "add the files of", path);
+    check_git_result(::git_index_write(index), "write the index of", path);
+
+    auto tree_id = ::git_oid{};
+    check_git_result(::git_index_write_tree(&tree_id, index), "write the tree of", path);
+
+    ::git_tree* tree = nullptr;
+    check_git_result(::git_tree_lookup(&tree, repository, &tree_id), "look up the tree of", path);
+    auto const d3 = hk::defer{[&] {
+        ::git_tree_free(tree);
+    }};
+
+    // A fixed time, so that the same files always produce the same commit.
+    ::git_signature* signature = nullptr;
+    check_git_result(::git_signature_new(&signature, "hkbench", "hkbench@example.com", 0, 0), "create a signature for", path);
+    auto const d4 = hk::defer{[&] {
+        ::git_signature_free(signature);
+    }};
+
+    auto commit_id = ::git_oid{};
+    check_git_result(
+        ::git_commit_create_v(&commit_id, repository, "refs/heads/main", signature, signature, nullptr, "Generated by hkbench", tree, 0),
+        "commit to",
+        path);
+    check_git_result(::git_repository_set_head(repository, "refs/heads/main"), "set the HEAD of", path);
+}
+
+[[nodiscard]] std::filesystem::path write_repository_graph(std::filesystem::path const& directory, repository_graph_options const& options)
+{
+    auto const absolute_directory = std::filesystem::absolute(directory);
+    auto engine = std::mt19937_64{options.seed};
+
+    // Fill the levels in order; every level gets at least one repository.
+    auto const depth = std::clamp(options.depth, 1uz, std::max(options.num_repositories, 1uz));
+    auto levels = std::vector<std::vector<std::size_t>>(depth);
+    for (auto i = 0uz; i != options.num_repositories; ++i) {
+        levels[i * depth / options.num_repositories].push_back(i);
+    }
+
+    auto const repository_path = [&](std::size_t i) {
+        return absolute_directory / std::format("r{}", i);
+    };
+    auto const repository_url = [&](std::size_t i) {
+        return std::format("file://{}", repository_path(i).generic_string());
+    };
+
+    // Every 8th generated import is a git import of a repository on the
+    // network, use only module imports.
+    auto module_options = options.modules;
+    module_options.num_imports = std::min(module_options.num_imports, 7uz);
+
+    for (auto level = 0uz; level != levels.size(); ++level) {
+        auto const& parents = levels[level];
+        auto const* const children = level + 1 != levels.size() ? &levels[level + 1] : nullptr;
+
+        for (auto k = 0uz; k != parents.size(); ++k) {
+            auto const i = parents[k];
+
+            auto repository_options = module_options;
+            repository_options.seed = options.modules.seed + i * options.num_modules;
+            repository_options.git_imports.clear();
+            if (i < options.num_anchor_conflicts) {
+                repository_options.anchor = "shared";
+                repository_options.anchor_version = std::format("1.{}.0", i);
+            } else {
+                repository_options.anchor = std::format("r{}", i);
+            }
+
+            if (children != nullptr) {
+                auto imports = std::vector<std::size_t>{};
+                // Each child is imported by at least one parent.
+                for (auto c = k; c < children->size(); c += parents.size()) {
+                    imports.push_back((*children)[c]);
+                }
+                while (imports.size() < std::min(options.fan_out, children->size())) {
+                    auto const c = (*children)[engine() % children->size()];
+                    if (std::ranges::find(imports, c) == imports.end()) {
+                        imports.push_back(c);
+                    }
+                }
+                for (auto const c : imports) {
+                    repository_options.git_imports.push_back(repository_url(c));
+                }
+            }
+
+            write_corpus(repository_path(i), options.num_modules, repository_options);
+            git_commit_directory(repository_path(i));
+        }
+    }
+
+    auto root_options = module_options;
+    root_options.anchor = "root";
+    root_options.git_imports.clear();
+    if (not levels.empty()) {
+        for (auto const c : levels.front()) {
+            root_options.git_imports.push_back(repository_url(c));
+        }
+    }
+
+    auto const root_path = absolute_directory / "root";
+    write_corpus(root_path, options.num_modules, root_options);
+    return root_path;
+}
+
+} // namespace bench
@@ -0,0 +1,70 @@
+
+#pragma once
+
+#include "corpus.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace bench {
+
+/** Options for generating a graph of git repositories.
+ */
+struct repository_graph_options {
+    /** The number of git repositories, not including the root repository.
+     */
+    std::size_t num_repositories = 8;
+
+    /** The number of sub-modules in each repository.
+     */
+    std::size_t num_modules = 16;
+
+    /** The number of `import git` declarations in each repository.
+     */
+    std::size_t fan_out = 2;
+
+    /** The number of levels of repositories below the root repository.
+     */
+    std::size_t depth = 2;
+
+    /** The number of repositories that declare the same anchor, each with a different version.
+     *
+     * When the modules are deduplicated only the sub-modules of the
+     * repository with the highest version remain.
+     */
+    std::size_t num_anchor_conflicts = 2;
+
+    /** The size and shape of the modules.
+     *
+     * The anchor and the git imports are set for each repository.
+     */
+    corpus_options modules = {};
+
+    /** The seed of the random number generator that selects the imports.
+     */
+    uint64_t seed = 1;
+};
+
+/** Write a graph of git repositories into a directory.
+ *
+ * The repositories are distributed over `depth` levels. The root repository
+ * imports every repository on the first level. Each repository imports at
+ * least `fan_out` repositories of the next level, and every repository is
+ * imported by at least one repository of the previous level.
+ *
+ * The repositories are imported through `file://` URLs at their `main`
+ * branch, so that cloning them does not use the network.
+ *
+ * @param directory The directory to write the repositories to.
+ * @param options The shape of the graph.
+ * @return The path to the root repository, which is not a git repository.
+ */
+[[nodiscard]] std::filesystem::path write_repository_graph(std::filesystem::path const& directory, repository_graph_options const& options);
+
+/** Commit every file in a directory to the `main` branch of a new git repository.
+ *
+ * @param path The directory to turn into a git repository.
+ */
+void git_commit_directory(std::filesystem::path const& path);
+
+} // namespace bench
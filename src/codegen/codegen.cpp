@@ -0,0 +1,197 @@
+
+#include "codegen.hpp"
+#include "utility/defer.hpp"
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
+#include <llvm/Analysis/ProfileSummaryInfo.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/ModuleSummaryIndex.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <cassert>
+#include <future>
+#include <utility>
+
+namespace hk {
+
+[[nodiscard]] static llvm::OptimizationLevel to_llvm(codegen_optimization optimization) noexcept
+{
+    switch (optimization) {
+    case codegen_optimization::none:
+        return llvm::OptimizationLevel::O0;
+    case codegen_optimization::O1:
+        return llvm::OptimizationLevel::O1;
+    case codegen_optimization::O2:
+        return llvm::OptimizationLevel::O2;
+    case codegen_optimization::O3:
+        return llvm::OptimizationLevel::O3;
+    }
+    std::unreachable();
+}
+
+/** Run the optimization pipeline on a module.
+ *
+ * The analysis managers and the pass builder are local, so that modules in
+ * different contexts may be optimized concurrently.
+ */
+static void optimize(llvm::Module& module, codegen_options const& options)
+{
+    auto loop_analysis = llvm::LoopAnalysisManager{};
+    auto function_analysis = llvm::FunctionAnalysisManager{};
+    auto cgscc_analysis = llvm::CGSCCAnalysisManager{};
+    auto module_analysis = llvm::ModuleAnalysisManager{};
+
+    auto builder = llvm::PassBuilder{};
+    builder.registerModuleAnalyses(module_analysis);
+    builder.registerCGSCCAnalyses(cgscc_analysis);
+    builder.registerFunctionAnalyses(function_analysis);
+    builder.registerLoopAnalyses(loop_analysis);
+    builder.crossRegisterProxies(loop_analysis, function_analysis, cgscc_analysis, module_analysis);
+
+    auto const level = to_llvm(options.optimization);
+    auto passes = [&] {
+        if (options.optimization == codegen_optimization::none) {
+            return builder.buildO0DefaultPipeline(level, options.thin_lto);
+        } else if (options.thin_lto) {
+            return builder.buildThinLTOPreLinkDefaultPipeline(level);
+        } else {
+            return builder.buildPerModuleDefaultPipeline(level);
+        }
+    }();
+
+    passes.run(module, module_analysis);
+}
+
+[[nodiscard]] std::expected<codegen_unit, hkc_error> codegen(codegen_module const& module, codegen_options const& options)
+{
+    assert(module.lower);
+
+    // The module must be destroyed before its context.
+    auto context = llvm::LLVMContext{};
+    auto llvm_module = llvm::Module{module.name, context};
+
+    module.lower(llvm_module);
+    if (llvm::verifyModule(llvm_module)) {
+        return std::unexpected{hkc_error::invalid_llvm_ir};
+    }
+
+    optimize(llvm_module, options);
+
+    auto r = codegen_unit{module.name, {}};
+    auto stream = llvm::raw_string_ostream{r.bitcode};
+    if (options.thin_lto) {
+        auto profile_summary = llvm::ProfileSummaryInfo{llvm_module};
+        auto const index = llvm::buildModuleSummaryIndex(llvm_module, nullptr, &profile_summary);
+        llvm::WriteBitcodeToFile(llvm_module, stream, false, &index);
+    } else {
+        llvm::WriteBitcodeToFile(llvm_module, stream);
+    }
+    stream.flush();
+    return r;
+}
+
+[[nodiscard]] std::expected<std::vector<codegen_unit>, hkc_error>
+codegen(std::span<codegen_module const> modules, codegen_options const& options, thread_pool& pool)
+{
+    auto futures = std::vector<std::future<std::expected<codegen_unit, hkc_error>>>{};
+    futures.reserve(modules.size());
+    for (auto const& module : modules) {
+        futures.push_back(pool([&module, &options] {
+            return codegen(module, options);
+        }));
+    }
+
+    // The work refers to the modules and options; wait for all of it, even
+    // when a module fails, before returning or rethrowing.
+    for (auto const& future : futures) {
+        future.wait();
+    }
+
+    auto r = std::vector<codegen_unit>{};
+    r.reserve(futures.size());
+    for (auto& future : futures) {
+        auto unit = future.get();
+        if (not unit) {
+            return std::unexpected{unit.error()};
+        }
+        r.push_back(std::move(*unit));
+    }
+    return r;
+}
+
+[[nodiscard]] std::expected<std::unique_ptr<llvm::Module>, hkc_error>
+codegen_link(llvm::LLVMContext& context, std::span<codegen_unit const> units, std::string_view name)
+{
+    /** Ignore the diagnostics of the linker.
+     *
+     * The default handler of a context exits the process on an error; the
+     * linker reports the error again through its return value.
+     */
+    struct diagnostic_handler : llvm::DiagnosticHandler {
+        bool handleDiagnostics(llvm::DiagnosticInfo const&) override
+        {
+            return true;
+        }
+    };
+
+    auto previous_handler = context.getDiagnosticHandler();
+    context.setDiagnosticHandler(std::make_unique<diagnostic_handler>());
+    auto const d = defer([&] {
+        context.setDiagnosticHandler(std::move(previous_handler));
+    });
+
+    auto r = std::make_unique<llvm::Module>(name, context);
+    auto linker = llvm::Linker{*r};
+
+    for (auto const& unit : units) {
+        auto const buffer = llvm::MemoryBufferRef{unit.bitcode, unit.name};
+        auto module = llvm::parseBitcodeFile(buffer, context);
+        if (not module) {
+            llvm::consumeError(module.takeError());
+            return std::unexpected{hkc_error::llvm_link_failure};
+        }
+
+        if (linker.linkInModule(std::move(*module))) {
+            return std::unexpected{hkc_error::llvm_link_failure};
+        }
+    }
+    return r;
+}
+
+[[nodiscard]] std::expected<std::string, hkc_error> codegen_summary(std::span<codegen_unit const> units)
+{
+    auto index = llvm::ModuleSummaryIndex{false};
+
+    for (auto i = 0uz; i != units.size(); ++i) {
+        auto const buffer = llvm::MemoryBufferRef{units[i].bitcode, units[i].name};
+
+        auto info = llvm::getBitcodeLTOInfo(buffer);
+        if (not info) {
+            llvm::consumeError(info.takeError());
+            return std::unexpected{hkc_error::llvm_link_failure};
+        }
+        if (not info->HasSummary) {
+            return std::unexpected{hkc_error::llvm_link_failure};
+        }
+
+        if (auto error = llvm::readModuleSummaryIndex(buffer, index, i)) {
+            llvm::consumeError(std::move(error));
+            return std::unexpected{hkc_error::llvm_link_failure};
+        }
+    }
+
+    auto r = std::string{};
+    auto stream = llvm::raw_string_ostream{r};
+    llvm::writeIndexToFile(index, stream);
+    stream.flush();
+    return r;
+}
+
+}
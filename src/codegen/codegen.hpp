@@ -0,0 +1,116 @@
+
+#pragma once
+
+#include "error/hkc_error.hpp"
+#include "utility/thread_pool.hpp"
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace llvm {
+class LLVMContext;
+class Module;
+}
+
+namespace hk {
+
+/** The optimization level of the code generator.
+ */
+enum class codegen_optimization : std::uint8_t { none, O1, O2, O3 };
+
+struct codegen_options {
+    codegen_optimization optimization = codegen_optimization::O2;
+
+    /** Prepare the modules for ThinLTO.
+     *
+     * Each module is optimized with the ThinLTO pre-link pipeline, and its
+     * bitcode includes a module summary. The summaries are combined by
+     * `codegen_summary()`, and the cross-module optimization is left to
+     * the ThinLTO backend of the linker.
+     */
+    bool thin_lto = false;
+};
+
+/** A module to lower to LLVM IR.
+ */
+struct codegen_module {
+    /** The identifier of the LLVM module.
+     */
+    std::string name;
+
+    /** Lower the module into an empty LLVM module.
+     *
+     * This is called on a worker thread. The LLVM module has its own
+     * LLVMContext, so the lowering of different modules does not share any
+     * LLVM state and needs no locking; but the callback must not use types
+     * or values from another context.
+     */
+    std::function<void(llvm::Module&)> lower;
+};
+
+/** A module that was lowered and optimized.
+ */
+struct codegen_unit {
+    std::string name;
+
+    /** The LLVM bitcode of the module.
+     */
+    std::string bitcode;
+};
+
+/** Lower and optimize a single module.
+ *
+ * The module is lowered in a new LLVMContext, verified, optimized and
+ * written as bitcode; the context is destroyed before returning.
+ *
+ * @param module The module to lower.
+ * @param options The options of the code generator.
+ * @return The bitcode of the optimized module.
+ * @retval hkc_error::invalid_llvm_ir The lowered module failed verification.
+ */
+[[nodiscard]] std::expected<codegen_unit, hkc_error> codegen(codegen_module const& module, codegen_options const& options);
+
+/** Lower and optimize modules in parallel.
+ *
+ * Each module is lowered and optimized on a thread of @a pool, see
+ * `codegen(codegen_module const&, codegen_options const&)`. Only the
+ * bitcode is kept, so the memory used by a module's LLVM context is
+ * released as soon as the module is done.
+ *
+ * @param modules The modules to lower.
+ * @param options The options of the code generator.
+ * @param pool The thread pool to run on.
+ * @return The bitcode of the modules, in the order of @a modules.
+ * @retval hkc_error::invalid_llvm_ir One of the lowered modules failed verification.
+ */
+[[nodiscard]] std::expected<std::vector<codegen_unit>, hkc_error>
+codegen(std::span<codegen_module const> modules, codegen_options const& options, thread_pool& pool);
+
+/** Link the modules into a single module.
+ *
+ * The bitcode is read into @a context and linked, in the order of @a units.
+ *
+ * @param context The context of the linked module.
+ * @param units The modules to link.
+ * @param name The identifier of the linked module.
+ * @return The linked module.
+ * @retval hkc_error::llvm_link_failure The bitcode could not be read, or
+ *         the modules define the same symbol.
+ */
+[[nodiscard]] std::expected<std::unique_ptr<llvm::Module>, hkc_error>
+codegen_link(llvm::LLVMContext& context, std::span<codegen_unit const> units, std::string_view name);
+
+/** Combine the module summaries for ThinLTO.
+ *
+ * @param units The modules, generated with `codegen_options::thin_lto`.
+ * @return The combined summary index, as bitcode.
+ * @retval hkc_error::llvm_link_failure A module has no summary.
+ */
+[[nodiscard]] std::expected<std::string, hkc_error> codegen_summary(std::span<codegen_unit const> units);
+
+}
@@ -0,0 +1,139 @@
+
+#include "codegen.hpp"
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <hikotest/hikotest.hpp>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace test {
+
+/** A module that defines `i32 @<name>(i32 %x)`, returning `x * factor`.
+ *
+ * When @a callee is not empty the function returns `@<callee>(x) * factor`
+ * instead, with @a callee declared in the module.
+ */
+[[nodiscard]] static hk::codegen_module make_module(std::string name, int factor, std::string callee = {})
+{
+    auto lower = [name, factor, callee](llvm::Module& module) {
+        auto& context = module.getContext();
+        auto *i32 = llvm::Type::getInt32Ty(context);
+        auto *type = llvm::FunctionType::get(i32, {i32}, false);
+
+        auto *f = llvm::Function::Create(type, llvm::Function::ExternalLinkage, name, module);
+        auto builder = llvm::IRBuilder<>{llvm::BasicBlock::Create(context, "entry", f)};
+
+        llvm::Value *x = f->getArg(0);
+        if (not callee.empty()) {
+            auto g = module.getOrInsertFunction(callee, type);
+            x = builder.CreateCall(g, {x});
+        }
+        builder.CreateRet(builder.CreateMul(x, builder.getInt32(factor)));
+    };
+
+    return {std::move(name), std::move(lower)};
+}
+
+[[nodiscard]] static std::vector<hk::codegen_module> make_modules(std::size_t n)
+{
+    auto r = std::vector<hk::codegen_module>{};
+    for (auto i = 0uz; i != n; ++i) {
+        auto callee = i == 0 ? std::string{} : std::format("f{}", i - 1);
+        r.push_back(make_module(std::format("f{}", i), static_cast<int>(i + 1), callee));
+    }
+    return r;
+}
+
+} // namespace test
+
+TEST_SUITE(codegen_suite) {
+
+TEST_CASE(parallel)
+{
+    auto pool = hk::thread_pool(4);
+    auto const modules = test::make_modules(16);
+
+    auto const units = hk::codegen(modules, hk::codegen_options{}, pool);
+    pool.wait();
+    REQUIRE(units.has_value());
+    REQUIRE(units->size() == 16);
+    for (auto i = 0uz; i != units->size(); ++i) {
+        REQUIRE((*units)[i].name == std::format("f{}", i));
+        REQUIRE(not (*units)[i].bitcode.empty());
+    }
+}
+
+TEST_CASE(link)
+{
+    auto pool = hk::thread_pool(4);
+    auto const modules = test::make_modules(8);
+    auto const units = hk::codegen(modules, hk::codegen_options{}, pool);
+    pool.wait();
+    REQUIRE(units.has_value());
+
+    auto context = llvm::LLVMContext{};
+    auto const module = hk::codegen_link(context, *units, "program");
+    REQUIRE(module.has_value());
+
+    for (auto i = 0uz; i != 8; ++i) {
+        auto const *f = (*module)->getFunction(std::format("f{}", i));
+        REQUIRE(f != nullptr);
+        REQUIRE(not f->isDeclaration());
+    }
+}
+
+TEST_CASE(link_duplicate_symbol)
+{
+    auto pool = hk::thread_pool(2);
+    auto const modules = std::vector{test::make_module("a", 2), test::make_module("b", 3)};
+    auto units = hk::codegen(modules, hk::codegen_options{}, pool);
+    pool.wait();
+    REQUIRE(units.has_value());
+    (*units)[1] = (*units)[0];
+    (*units)[1].name = "b";
+
+    auto context = llvm::LLVMContext{};
+    auto const module = hk::codegen_link(context, *units, "program");
+    REQUIRE(not module.has_value());
+    REQUIRE(module.error() == hk::hkc_error::llvm_link_failure);
+}
+
+TEST_CASE(invalid_ir)
+{
+    auto pool = hk::thread_pool(2);
+    auto modules = test::make_modules(4);
+    modules[2].lower = [](llvm::Module& module) {
+        auto& context = module.getContext();
+        auto *type = llvm::FunctionType::get(llvm::Type::getVoidTy(context), false);
+        auto *f = llvm::Function::Create(type, llvm::Function::ExternalLinkage, "f2", module);
+        // A basic block without a terminator.
+        llvm::BasicBlock::Create(context, "entry", f);
+    };
+
+    auto const units = hk::codegen(modules, hk::codegen_options{}, pool);
+    pool.wait();
+    REQUIRE(not units.has_value());
+    REQUIRE(units.error() == hk::hkc_error::invalid_llvm_ir);
+}
+
+TEST_CASE(thin_lto_summary)
+{
+    auto pool = hk::thread_pool(4);
+    auto const modules = test::make_modules(8);
+
+    auto const thin_units = hk::codegen(modules, hk::codegen_options{.thin_lto = true}, pool);
+    pool.wait();
+    REQUIRE(thin_units.has_value());
+    auto const summary = hk::codegen_summary(*thin_units);
+    REQUIRE(summary.has_value());
+    REQUIRE(not summary->empty());
+
+    auto const units = hk::codegen(modules, hk::codegen_options{}, pool);
+    pool.wait();
+    REQUIRE(units.has_value());
+    REQUIRE(hk::codegen_summary(*units).error() == hk::hkc_error::llvm_link_failure);
+}
+
+}; // TEST_SUITE(codegen_suite)
@@ -0,0 +1,141 @@
+
+#include "diagnostic_sink.hpp"
+#include "utility/strings.hpp"
+#include "utility/write_all.hpp"
+#include <format>
+#include <utility>
+#include <cassert>
+
+namespace hk {
+
+/** The SARIF level of an error code.
+ */
+[[nodiscard]] static std::string_view to_level(hkc_error code) noexcept
+{
+    auto const numeric_code = std::to_underlying(code);
+
+    if (numeric_code < 10000) {
+        return "note";
+    } else if (numeric_code < 20000) {
+        return "warning";
+    } else {
+        return "error";
+    }
+}
+
+diagnostic_sink::diagnostic_sink(diagnostic_format format, int fd) : _format(format), _fd(fd)
+{
+    assert(format == diagnostic_format::jsonl or format == diagnostic_format::sarif);
+
+    if (_format == diagnostic_format::sarif) {
+        write_all(
+            _fd,
+            "{\"version\":\"2.1.0\","
+            "\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\","
+            "\"runs\":[{\"tool\":{\"driver\":{\"name\":\"hkc\"}},"
+            "\"columnKind\":\"utf16CodeUnits\","
+            "\"results\":[\n");
+    }
+
+    _thread = std::thread{[this] {
+        run();
+    }};
+}
+
+diagnostic_sink::~diagnostic_sink()
+{
+    _stop.store(true, std::memory_order::release);
+    _sequence.fetch_add(1, std::memory_order::release);
+    _sequence.notify_one();
+    _thread.join();
+
+    if (_format == diagnostic_format::sarif) {
+        write_all(_fd, "]}]}\n");
+    }
+}
+
+void diagnostic_sink::push(diagnostic d)
+{
+    _queue.push(std::move(d));
+    _sequence.fetch_add(1, std::memory_order::release);
+    _sequence.notify_one();
+}
+
+[[nodiscard]] std::string diagnostic_sink::to_jsonl(diagnostic const& d)
+{
+    auto r = std::format(
+        "{{\"code\":\"{}\",\"level\":\"{}\",\"message\":\"{}\"", to_code(d.code), to_level(d.code), json_escape(std::format("{}", d.code)));
+
+    if (not d.message.empty()) {
+        r += std::format(",\"detail\":\"{}\"", json_escape(d.message));
+    }
+
+    if (not d.path.empty()) {
+        r += std::format(",\"file\":\"{}\",\"line\":{},\"column\":{}", json_escape(d.path), d.line + 1, d.column + 1);
+    }
+
+    r += '}';
+    return r;
+}
+
+[[nodiscard]] std::string diagnostic_sink::to_sarif_result(diagnostic const& d)
+{
+    auto text = std::format("{}", d.code);
+    if (not d.message.empty()) {
+        text += std::format(": {}", d.message);
+    }
+
+    auto r = std::format(
+        "{{\"ruleId\":\"{}\",\"level\":\"{}\",\"message\":{{\"text\":\"{}\"}}", to_code(d.code), to_level(d.code), json_escape(text));
+
+    if (not d.path.empty()) {
+        r += std::format(
+            ",\"locations\":[{{\"physicalLocation\":{{\"artifactLocation\":{{\"uri\":\"{}\"}},"
+            "\"region\":{{\"startLine\":{},\"startColumn\":{}}}}}}}]",
+            json_escape(d.path),
+            d.line + 1,
+            d.column + 1);
+    }
+
+    r += '}';
+    return r;
+}
+
+void diagnostic_sink::run()
+{
+    auto buffer = std::string{};
+
+    while (true) {
+        // Read the sequence before draining the queue, so that a push after
+        // the drain changes the sequence, and wait() returns immediately.
+        auto const sequence = _sequence.load(std::memory_order::acquire);
+        auto const stop = _stop.load(std::memory_order::acquire);
+
+        buffer.clear();
+        while (auto d = _queue.pop()) {
+            if (_format == diagnostic_format::jsonl) {
+                buffer += to_jsonl(*d);
+                buffer += '\n';
+            } else {
+                if (_has_results) {
+                    buffer += ',';
+                }
+                buffer += to_sarif_result(*d);
+                buffer += '\n';
+                _has_results = true;
+            }
+        }
+
+        if (not buffer.empty()) {
+            write_all(_fd, buffer);
+        }
+
+        if (stop) {
+            return;
+        }
+
+        _sequence.wait(sequence, std::memory_order::acquire);
+    }
+}
+
+} // namespace hk
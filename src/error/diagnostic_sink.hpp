@@ -0,0 +1,121 @@
+
+#pragma once
+
+#include "hkc_error.hpp"
+#include "utility/mpsc_queue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace hk {
+
+/** The format of the diagnostics written by the compiler.
+ */
+enum class diagnostic_format {
+    /** Human readable text, with the line of source code.
+     */
+    text,
+
+    /** One JSON object per line.
+     */
+    jsonl,
+
+    /** A SARIF 2.1.0 log with a single run.
+     */
+    sarif,
+};
+
+/** A single diagnostic message, with a resolved location.
+ */
+struct diagnostic {
+    /** The path of the source file, empty if the location is not known.
+     */
+    std::string path = {};
+
+    /** The line number, 0-based.
+     */
+    uint32_t line = 0;
+
+    /** The UTF-16 column number, 0-based.
+     */
+    uint32_t column = 0;
+
+    hkc_error code = hkc_error::none;
+
+    /** An extra message for this specific diagnostic.
+     */
+    std::string message = {};
+};
+
+/** Streams machine readable diagnostics to a file descriptor.
+ *
+ * Compiler threads hand diagnostics to the sink through a lock-free queue.
+ * A writer thread formats them as JSON Lines or SARIF and writes each batch
+ * it takes from the queue, so that the output can be consumed while the
+ * compiler is still running.
+ */
+class diagnostic_sink {
+public:
+    /** Start the writer thread.
+     *
+     * For SARIF the opening of the log is written immediately.
+     *
+     * @param format The format, `diagnostic_format::jsonl` or `diagnostic_format::sarif`.
+     * @param fd The file descriptor to write to.
+     */
+    diagnostic_sink(diagnostic_format format, int fd);
+
+    /** Write the remaining diagnostics and stop the writer thread.
+     */
+    ~diagnostic_sink();
+
+    diagnostic_sink(diagnostic_sink const&) = delete;
+    diagnostic_sink(diagnostic_sink&&) = delete;
+    diagnostic_sink& operator=(diagnostic_sink const&) = delete;
+    diagnostic_sink& operator=(diagnostic_sink&&) = delete;
+
+    /** Add a diagnostic.
+     *
+     * This function may be called from any thread, and does not block.
+     *
+     * @param d The diagnostic.
+     */
+    void push(diagnostic d);
+
+    /** Format a diagnostic as a single line of JSON, without a line-feed.
+     */
+    [[nodiscard]] static std::string to_jsonl(diagnostic const& d);
+
+    /** Format a diagnostic as a SARIF result object.
+     */
+    [[nodiscard]] static std::string to_sarif_result(diagnostic const& d);
+
+private:
+    diagnostic_format _format;
+    int _fd;
+
+    mpsc_queue<diagnostic> _queue;
+
+    /** The number of diagnostics pushed, plus one when stopping.
+     *
+     * The writer thread waits on this counter when the queue is empty.
+     */
+    std::atomic<uint64_t> _sequence = 0;
+    std::atomic<bool> _stop = false;
+
+    /** A SARIF result was written, the next needs a comma separator.
+     */
+    bool _has_results = false;
+
+    std::thread _thread;
+
+    void run();
+};
+
+/** The diagnostic sink selected on the command line, or nullptr for text.
+ */
+inline diagnostic_sink *global_diagnostic_sink = nullptr;
+
+} // namespace hk
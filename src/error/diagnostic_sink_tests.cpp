@@ -0,0 +1,80 @@
+
+#include "diagnostic_sink.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdio>
+#include <string>
+
+/** Read back everything written to a temporary file.
+ */
+static std::string read_back(std::FILE* f)
+{
+    std::fflush(f);
+    std::rewind(f);
+
+    auto r = std::string{};
+    char buffer[256];
+    while (auto n = std::fread(buffer, 1, sizeof(buffer), f)) {
+        r.append(buffer, n);
+    }
+    return r;
+}
+
+TEST_SUITE(diagnostic_sink_suite)
+{
+
+TEST_CASE(to_jsonl)
+{
+    auto d = hk::diagnostic{"dir/foo \"1\".hkm", 1, 4, hk::hkc_error::invalid_fqname, "got\n'bar'"};
+    auto const expected = std::format(
+        "{{\"code\":\"E22001\",\"level\":\"error\",\"message\":\"{}\",\"detail\":\"got\\n'bar'\","
+        "\"file\":\"dir/foo \\\"1\\\".hkm\",\"line\":2,\"column\":5}}",
+        hk::hkc_error::invalid_fqname);
+    REQUIRE(hk::diagnostic_sink::to_jsonl(d) == expected);
+
+    auto w = hk::diagnostic{};
+    w.code = hk::hkc_error::could_not_clone_repository;
+    REQUIRE(hk::diagnostic_sink::to_jsonl(w).starts_with("{\"code\":\"W10000\",\"level\":\"warning\","));
+    REQUIRE(not hk::diagnostic_sink::to_jsonl(w).contains("\"file\""));
+}
+
+TEST_CASE(stream_jsonl)
+{
+    auto f = std::tmpfile();
+    REQUIRE(f != nullptr);
+
+    {
+        auto sink = hk::diagnostic_sink{hk::diagnostic_format::jsonl, fileno(f)};
+        sink.push(hk::diagnostic{"a.hkm", 0, 0, hk::hkc_error::invalid_fqname});
+        sink.push(hk::diagnostic{"b.hkm", 1, 2, hk::hkc_error::missing_semicolon});
+    }
+
+    auto const r = read_back(f);
+    std::fclose(f);
+
+    auto const first = hk::diagnostic_sink::to_jsonl(hk::diagnostic{"a.hkm", 0, 0, hk::hkc_error::invalid_fqname});
+    auto const second = hk::diagnostic_sink::to_jsonl(hk::diagnostic{"b.hkm", 1, 2, hk::hkc_error::missing_semicolon});
+    REQUIRE(r == first + "\n" + second + "\n");
+}
+
+TEST_CASE(stream_sarif)
+{
+    auto f = std::tmpfile();
+    REQUIRE(f != nullptr);
+
+    auto const d = hk::diagnostic{"a.hkm", 2, 3, hk::hkc_error::invalid_fqname, "bar"};
+    {
+        auto sink = hk::diagnostic_sink{hk::diagnostic_format::sarif, fileno(f)};
+        sink.push(d);
+        sink.push(d);
+    }
+
+    auto const r = read_back(f);
+    std::fclose(f);
+
+    auto const result = hk::diagnostic_sink::to_sarif_result(d);
+    REQUIRE(result.contains("\"region\":{\"startLine\":3,\"startColumn\":4}"));
+    REQUIRE(r.starts_with("{\"version\":\"2.1.0\","));
+    REQUIRE(r.ends_with("\"results\":[\n" + result + "\n," + result + "\n]}]}\n"));
+}
+
+};
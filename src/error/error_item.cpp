@@ -9,12 +9,27 @@ namespace hk {
 
 void error_item::print(line_table const& lines) const
 {
-    println(stderr, "{}", to_string(lines));
+    std::print(stderr, "{}", to_string(lines));
 }
 
 [[nodiscard]] std::string error_item::to_string(line_table const& lines) const
 {
-    auto const [first_file, first_lineno, first_colno, location_string] = lines.get_error_location(_first, _last);
+    auto cache = line_table::position_cache{};
+    return to_string(lines, cache);
+}
+
+[[nodiscard]] std::string error_item::to_string(line_table const& lines, line_table::position_cache& cache) const
+{
+    if (_first == nullptr) {
+        auto r = std::format("{} {}", to_code(code()), code());
+        if (auto const& m = message(); not m.empty()) {
+            r += std::format(": {}", m);
+        }
+        r += '\n';
+        return r;
+    }
+
+    auto const [first_file, first_lineno, first_colno, location_string] = lines.get_error_location(_first, _last, cache);
 
     auto r = std::format("{}:{}:{}: {} {}", first_file, first_lineno + 1, first_colno + 1, to_code(code()), code());
 
@@ -22,8 +37,9 @@ void error_item::print(line_table const& lines) const
         r += std::format(": {}", m);
     }
 
+    r += '\n';
     r += location_string;
     return r;
 }
 
-} // namespace hk
\ No newline at end of file
+} // namespace hk
@@ -61,6 +61,18 @@ public:
         return _message;
     }
 
+    /** The error has been written to the console by an `error_reporter`.
+     */
+    [[nodiscard]] constexpr bool reported() const noexcept
+    {
+        return _reported;
+    }
+
+    constexpr void set_reported() noexcept
+    {
+        _reported = true;
+    }
+
     void print(line_table const& lines) const;
 
     /** Create a string to print to the console for the error.
@@ -71,11 +83,21 @@ public:
      */
     [[nodiscard]] std::string to_string(line_table const& lines) const;
 
+    /** Create a string to print to the console for the error.
+     *
+     * @param lines The line table of the source-code.
+     * @param cache The position of the previous error, to speed up finding
+     *              the location of errors in file order.
+     * @return A string to be send to the console.
+     */
+    [[nodiscard]] std::string to_string(line_table const& lines, line_table::position_cache& cache) const;
+
 private:
     char const* _first = {};
     char const* _last = {};
     hkc_error _code = {};
     std::string _message = {};
+    bool _reported = false;
 };
 
 } // namespace hk
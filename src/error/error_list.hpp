@@ -18,40 +18,35 @@ public:
 
     /** Add an error.
      *
-     * This add will make sure the error_list is sorted by file order.
-     * Parsing the file multiple times will not introduce duplicate errors.
+     * The error is appended to the list; call `sort()` when the file has
+     * been processed to put the errors in file order and remove duplicates.
+     * The error is printed later by an `error_reporter`.
      * 
-     * @param lines The line table for this file. Used for print the error
-     *              message to stderr.
+     * @param lines The line table for this file.
      * @param first Pointer to the first character causing the error.
      * @param last Pointer to beyond the last character causing the error.
      * @param error The error code.
      * @param message An extra message to print.
-     * @return The iterator to the error, true if a new error was inserted.
+     * @return The iterator to the error, false if the error is the same as
+     *         the previous error.
      */
     std::pair<iterator, bool> add(line_table const& lines, char const* first, char const* last, hkc_error error, std::string message = std::string{})
     {
         auto e = error_item{error, first, last, std::move(message)};
 
-        auto it = std::lower_bound(begin(), end(), e, [](auto const& item, auto const& x) {
-            return item < x;
-        });
-        if (it != end() and *it == e) {
-            return {it, false};
+        if (not empty() and back() == e) {
+            return {end() - 1, false};
         }
 
-        it = insert(it, std::move(e));
-        it->print(lines);
-        return {it, true};
+        emplace_back(std::move(e));
+        return {end() - 1, true};
     }
 
     /** Add an error.
      *
-     * This add will make sure the error_list is sorted by file order.
-     * Parsing the file multiple times will not introduce duplicate errors.
+     * The error is appended to the list, see `sort()`.
      * 
-     * @param lines The line table for this file. Used for print the error
-     *              message to stderr.
+     * @param lines The line table for this file.
      * @param first Pointer to the first character causing the error.
      * @param last Pointer to beyond the last character causing the error.
      * @param error The error code.
@@ -67,11 +62,9 @@ public:
 
     /** Add an error.
      *
-     * This add will make sure the error_list is sorted by file order.
-     * Parsing the file multiple times will not introduce duplicate errors.
+     * The error is appended to the list, see `sort()`.
      * 
-     * @param lines The line table for this file. Used for print the error
-     *              message to stderr.
+     * @param lines The line table for this file.
      * @param first Pointer to the first character causing the error.
      * @param error The error code.
      * @param fmt Formatting string for an extra error message (optional)
@@ -86,11 +79,9 @@ public:
 
     /** Add an error.
      *
-     * This add will make sure the error_list is sorted by file order.
-     * Parsing the file multiple times will not introduce duplicate errors.
+     * The error is appended to the list, see `sort()`.
      * 
-     * @param lines The line table for this file. Used for print the error
-     *              message to stderr.
+     * @param lines The line table for this file.
      * @param error The error code.
      * @param fmt Formatting string for an extra error message (optional)
      * @param args... Arguments for formatting.
@@ -102,6 +93,18 @@ public:
         return add(lines, nullptr, nullptr, code, std::format(std::move(fmt), std::forward<Args>(args)...));
     }
 
+    /** Sort the errors in file order and remove duplicates.
+     *
+     * Errors with the same location and code are duplicates, for example
+     * when a file is parsed multiple times; the first one added is kept.
+     */
+    void sort()
+    {
+        std::stable_sort(begin(), end());
+        auto const it = std::unique(begin(), end());
+        erase(it, end());
+    }
+
 private:
 };
 
@@ -0,0 +1,71 @@
+
+#include "error_reporter.hpp"
+#include "utility/write_all.hpp"
+
+namespace hk {
+
+[[nodiscard]] std::string error_reporter::format(error_list& errors, line_table const& lines)
+{
+    errors.sort();
+
+    auto r = std::string{};
+    auto cache = line_table::position_cache{};
+    for (auto& e : errors) {
+        if (not e.reported()) {
+            r += e.to_string(lines, cache);
+            e.set_reported();
+        }
+    }
+    return r;
+}
+
+void error_reporter::send(diagnostic_sink& sink, error_list& errors, line_table const& lines)
+{
+    errors.sort();
+
+    auto cache = line_table::position_cache{};
+    for (auto& e : errors) {
+        if (e.reported()) {
+            continue;
+        }
+
+        auto d = diagnostic{};
+        d.code = e.code();
+        d.message = std::string{e.message()};
+        if (e.first() != nullptr) {
+            auto const [path, line, column, _] = lines.get_position(e.first(), cache);
+            d.path = std::string{path.string_view()};
+            d.line = line;
+            d.column = column;
+        }
+
+        sink.push(std::move(d));
+        e.set_reported();
+    }
+}
+
+void error_reporter::add(error_list& errors, line_table const& lines)
+{
+    if (_sink != nullptr) {
+        return send(*_sink, errors, lines);
+    }
+
+    auto text = format(errors, lines);
+    if (text.empty()) {
+        return;
+    }
+
+    auto const lock = std::scoped_lock(_mutex);
+    _files[std::string{lines.path().string_view()}] += text;
+}
+
+void error_reporter::flush()
+{
+    auto const lock = std::scoped_lock(_mutex);
+    for (auto const& [path, text] : _files) {
+        write_all(_fd, text);
+    }
+    _files.clear();
+}
+
+} // namespace hk
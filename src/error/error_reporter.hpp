@@ -0,0 +1,88 @@
+
+#pragma once
+
+#include "error_list.hpp"
+#include "diagnostic_sink.hpp"
+#include "tokenizer/line_table.hpp"
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace hk {
+
+/** Writes the errors of source files to the console in batches.
+ *
+ * The errors of a file are formatted when the file has been processed, in a
+ * single pass over the sorted error list, so that the location of each error
+ * is found by counting forward from the previous error.
+ *
+ * The text for each file is written with a single `write()`. Files are
+ * written in order of their path, so that the output does not depend on the
+ * order in which the files were processed.
+ *
+ * When a diagnostic sink is selected the errors are instead handed to the
+ * sink as soon as a file is added.
+ */
+class error_reporter {
+public:
+    /** Create an error reporter.
+     *
+     * @param fd The file descriptor to write text to, by default stderr.
+     * @param sink The sink for machine readable diagnostics, or nullptr for text.
+     */
+    explicit error_reporter(int fd = 2, diagnostic_sink *sink = global_diagnostic_sink) noexcept : _fd(fd), _sink(sink) {}
+
+    /** Write any remaining errors.
+     */
+    ~error_reporter()
+    {
+        flush();
+    }
+
+    error_reporter(error_reporter const&) = delete;
+    error_reporter(error_reporter&&) = delete;
+    error_reporter& operator=(error_reporter const&) = delete;
+    error_reporter& operator=(error_reporter&&) = delete;
+
+    /** Add the errors of a file.
+     *
+     * The error list is sorted, and the errors that were not reported before
+     * are formatted and marked as reported.
+     *
+     * @param errors The errors of the file.
+     * @param lines The line table of the file.
+     */
+    void add(error_list& errors, line_table const& lines);
+
+    /** Write the errors of all added files.
+     */
+    void flush();
+
+    /** Format the errors of a file that were not reported before.
+     *
+     * @param errors The errors of the file, which will be sorted.
+     * @param lines The line table of the file.
+     * @return The text to write to the console.
+     */
+    [[nodiscard]] static std::string format(error_list& errors, line_table const& lines);
+
+    /** Send the errors of a file that were not reported before to a sink.
+     *
+     * @param sink The sink for the diagnostics.
+     * @param errors The errors of the file, which will be sorted.
+     * @param lines The line table of the file.
+     */
+    static void send(diagnostic_sink& sink, error_list& errors, line_table const& lines);
+
+private:
+    int _fd;
+    diagnostic_sink *_sink;
+
+    std::mutex _mutex;
+
+    /** The formatted errors, by path of the file.
+     */
+    std::map<std::string, std::string, std::less<>> _files;
+};
+
+} // namespace hk
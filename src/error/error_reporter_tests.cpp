@@ -0,0 +1,61 @@
+
+#include "error_reporter.hpp"
+#include <hikotest/hikotest.hpp>
+#include <format>
+#include <string>
+
+TEST_SUITE(error_reporter_suite)
+{
+
+TEST_CASE(format_in_file_order)
+{
+    auto const text = std::string{"module foo;\nbar baz\n  qux\n"};
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "foo.hkm");
+    lines.set_ascii(true);
+
+    auto errors = hk::error_list{};
+    errors.add(lines, text.data() + 22, text.data() + 25, hk::hkc_error::invalid_fqname);
+    errors.add(lines, text.data() + 12, text.data() + 15, hk::hkc_error::invalid_prologue_statement, "bar");
+    errors.add(lines, text.data() + 22, text.data() + 25, hk::hkc_error::invalid_fqname);
+    REQUIRE(errors.size() == 3);
+
+    auto const expected = std::format(
+        "foo.hkm:2:1: {} {}: bar\n"
+        "    2 | bar baz\n"
+        "      | ^~~\n"
+        "foo.hkm:3:3: {} {}\n"
+        "    3 |   qux\n"
+        "      |   ^~~\n",
+        hk::to_code(hk::hkc_error::invalid_prologue_statement),
+        hk::hkc_error::invalid_prologue_statement,
+        hk::to_code(hk::hkc_error::invalid_fqname),
+        hk::hkc_error::invalid_fqname);
+    REQUIRE(hk::error_reporter::format(errors, lines) == expected);
+
+    // Duplicates are removed.
+    REQUIRE(errors.size() == 2);
+    REQUIRE(errors[0].code() == hk::hkc_error::invalid_prologue_statement);
+}
+
+TEST_CASE(report_once)
+{
+    auto const text = std::string{"module foo;\n"};
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "foo.hkm");
+
+    auto errors = hk::error_list{};
+    errors.add(lines, text.data() + 7, text.data() + 10, hk::hkc_error::invalid_fqname);
+    REQUIRE(not hk::error_reporter::format(errors, lines).empty());
+
+    // Parsing the file again adds the same error, which is not reported again.
+    errors.add(lines, text.data() + 7, text.data() + 10, hk::hkc_error::invalid_fqname);
+    errors.add(lines, text.data(), text.data() + 6, hk::hkc_error::unimplemented);
+
+    auto const r = hk::error_reporter::format(errors, lines);
+    REQUIRE(r.starts_with("foo.hkm:1:1: "));
+    REQUIRE(r.find("foo.hkm:1:8: ") == std::string::npos);
+    REQUIRE(errors.size() == 2);
+}
+
+};
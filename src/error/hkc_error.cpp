@@ -69,6 +69,8 @@ std::string hkc_error_category::message(int code) const
         return "Invalid syntax of a fully qualified name."s;
     case hkc_error::invalid_prologue_statement:
         return "A prologue statement has an invalid syntax."s;
+    case hkc_error::invalid_utf8_sequence:
+        return "Invalid UTF-8 sequence."s;
     case hkc_error::invalid_operand_types:
         return "Types of operands are invalid"s;
     case hkc_error::unknown_build_guard_constant:
@@ -81,6 +83,16 @@ std::string hkc_error_category::message(int code) const
         return "Module must be a sub-module of an anchor-module in the same repository."s;
     case hkc_error::imported_module_not_found:
         return "Imported module was not found in project"s;
+    case hkc_error::no_matching_overload:
+        return "No function in the overload set matches the arguments of the call."s;
+    case hkc_error::ambiguous_overload:
+        return "More than one function in the overload set matches the arguments of the call equally well."s;
+    case hkc_error::recursive_instantiation:
+        return "A template instantiation depends on itself."s;
+    case hkc_error::invalid_llvm_ir:
+        return "Internal compiler error: a module was lowered to invalid LLVM IR."s;
+    case hkc_error::llvm_link_failure:
+        return "Internal compiler error: the LLVM modules could not be linked."s;
     case hkc_error::could_not_clone_repository:
         return "Unable to clone a repository."s;
     case hkc_error::insecure_identifier:
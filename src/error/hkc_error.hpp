@@ -54,6 +54,7 @@ enum class hkc_error : int {
     // Error: syntax error 22xxx
     invalid_fqname = 22001,
     invalid_prologue_statement = 22002,
+    invalid_utf8_sequence = 22003,
 
     // Error: compile time evaluation 23xxx
     invalid_operand_types = 23001,
@@ -62,8 +63,13 @@ enum class hkc_error : int {
     duplicate_module = 23004,
     missing_anchor_module = 23005,
     imported_module_not_found = 23006,
+    no_matching_overload = 23007,
+    ambiguous_overload = 23008,
+    recursive_instantiation = 23009,
     
     // Fatal: 30xxx
+    invalid_llvm_ir = 30001,
+    llvm_link_failure = 30002,
 
     // Security: 40xxx
     insecure_identifier = 40001,
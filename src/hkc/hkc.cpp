@@ -1,7 +1,12 @@
 
 #include "options.hpp"
+#include "error/diagnostic_sink.hpp"
+#include "utility/defer.hpp"
+#include "utility/trace.hpp"
 #include <utility/command_line.hpp>
 #include <print>
+#include <cstdio>
+#include <memory>
 
 
 int main(int argc, char const *const *argv)
@@ -11,5 +16,41 @@ int main(int argc, char const *const *argv)
         return exit_code;
     }
 
+    auto diagnostics_file = std::unique_ptr<std::FILE, decltype(&std::fclose)>{nullptr, &std::fclose};
+    auto diagnostics_sink = std::unique_ptr<hk::diagnostic_sink>{};
+    if (o.diagnostics_format != hk::diagnostic_format::text) {
+        auto fd = 2;
+        if (not o.diagnostics_output.empty()) {
+            diagnostics_file.reset(std::fopen(o.diagnostics_output.string().c_str(), "wb"));
+            if (diagnostics_file == nullptr) {
+                std::println(stderr, "Could not open diagnostics output '{}'.", o.diagnostics_output.string());
+                return 1;
+            }
+            fd = fileno(diagnostics_file.get());
+        }
+
+        diagnostics_sink = std::make_unique<hk::diagnostic_sink>(o.diagnostics_format, fd);
+        hk::global_diagnostic_sink = diagnostics_sink.get();
+    }
+    auto const d = hk::defer([] {
+        hk::global_diagnostic_sink = nullptr;
+    });
+
+    if (not o.trace_output.empty()) {
+        hk::start_trace();
+    }
+    auto const d2 = hk::defer([&] {
+        if (o.trace_output.empty()) {
+            return;
+        }
+
+        hk::stop_trace();
+        auto trace_file = std::unique_ptr<std::FILE, decltype(&std::fclose)>{
+            std::fopen(o.trace_output.string().c_str(), "wb"), &std::fclose};
+        if (trace_file == nullptr or not hk::write_trace(fileno(trace_file.get()))) {
+            std::println(stderr, "Could not write trace output '{}'.", o.trace_output.string());
+        }
+    });
+
     return 0;
 }
\ No newline at end of file
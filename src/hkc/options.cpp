@@ -230,6 +230,55 @@ options::options()
             return std::string{};
         });
 
+    parser.add(
+        "--diagnostics=",
+        "Specify the format of errors and warnings: `text`, `jsonl` or `sarif`.\n"
+        "The `jsonl` and `sarif` formats are streamed while the compiler runs.",
+        [this](std::string_view value) {
+            if (value == "text") {
+                diagnostics_format = hk::diagnostic_format::text;
+            } else if (value == "jsonl") {
+                diagnostics_format = hk::diagnostic_format::jsonl;
+            } else if (value == "sarif") {
+                diagnostics_format = hk::diagnostic_format::sarif;
+            } else if (value.empty()) {
+                return std::string{"Diagnostics format is required."};
+            } else {
+                return std::format("Invalid diagnostics format '{}'.", value);
+            }
+            return std::string{};
+        });
+
+    parser.add("--diagnostics-output=", "Write the diagnostics to a file instead of stderr.", [this](std::string_view value) {
+        if (value.empty()) {
+            return std::string{"Diagnostics output path is required."};
+        }
+
+        try {
+            diagnostics_output = std::filesystem::path{value};
+        } catch (std::exception const& e) {
+            return std::format("Invalid diagnostics output path '{}': {}", value, e.what());
+        }
+        return std::string{};
+    });
+
+    parser.add(
+        "--trace=",
+        "Write the time spent in each phase of the compiler to a file.\n"
+        "The file is a Chrome trace that can be opened in Perfetto.",
+        [this](std::string_view value) {
+            if (value.empty()) {
+                return std::string{"Trace output path is required."};
+            }
+
+            try {
+                trace_output = std::filesystem::path{value};
+            } catch (std::exception const& e) {
+                return std::format("Invalid trace output path '{}': {}", value, e.what());
+            }
+            return std::string{};
+        });
+
     parser.add([this, &num_positional_arguments](std::string_view value) {
         if (num_positional_arguments == 0) {
             try {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "command.hpp"
+#include "error/diagnostic_sink.hpp"
 #include <string>
 #include <expected>
 #include <filesystem>
@@ -107,6 +108,18 @@ struct options {
      */
     std::filesystem::path compile_directory = {};
 
+    /** The format of the diagnostics (errors and warnings) of the compiler.
+     */
+    hk::diagnostic_format diagnostics_format = hk::diagnostic_format::text;
+
+    /** The file to write the diagnostics to, empty for stderr.
+     */
+    std::filesystem::path diagnostics_output = {};
+
+    /** The file to write a Chrome trace of the compiler phases to, empty for no tracing.
+     */
+    std::filesystem::path trace_output = {};
+
     options();
 
     /** Parse command line options for the Hikolang compiler.
@@ -0,0 +1,94 @@
+
+#include "om_dictionary.hpp"
+#include "om_object.hpp"
+#include <bit>
+#include <cassert>
+#include <functional>
+
+namespace hk {
+
+om_dictionary::~om_dictionary() = default;
+
+om_dictionary::om_dictionary() noexcept = default;
+
+om_object *om_dictionary::insert(interned_string name, om_ptr<om_object> object)
+{
+    assert(object != nullptr);
+
+    if (auto *r = find(name)) {
+        return r;
+    }
+
+    if (not _large and _size < max_inline_size) {
+        _inline[_size++] = value_type{name, std::move(object)};
+        return nullptr;
+    }
+
+    if (not _large) {
+        grow();
+    }
+
+    // Keep the load factor below one half, so that probe sequences stay short.
+    if ((_size + 1) * 2 > _large->index.size()) {
+        reindex(_large->index.size() * 2);
+    }
+
+    auto const mask = _large->index.size() - 1;
+    auto i = std::hash<interned_string>{}(name) & mask;
+    while (_large->index[i] != 0) {
+        i = (i + 1) & mask;
+    }
+
+    _large->items.emplace_back(name, std::move(object));
+    _large->index[i] = static_cast<std::uint32_t>(++_size);
+    return nullptr;
+}
+
+[[nodiscard]] om_object *om_dictionary::find_large(interned_string name) const noexcept
+{
+    assert(_large);
+
+    auto const mask = _large->index.size() - 1;
+    auto i = std::hash<interned_string>{}(name) & mask;
+    while (auto const j = _large->index[i]) {
+        auto const& item = _large->items[j - 1];
+        if (item.name == name) {
+            return item.object.get();
+        }
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+void om_dictionary::grow()
+{
+    assert(not _large);
+
+    _large = std::make_unique<large_type>();
+    _large->items.reserve(_size * 2);
+    for (auto i = 0uz; i != _size; ++i) {
+        _large->items.push_back(std::move(_inline[i]));
+        _inline[i] = value_type{};
+    }
+    reindex(std::bit_ceil(_size * 4));
+}
+
+void om_dictionary::reindex(std::size_t capacity)
+{
+    assert(_large);
+    assert(std::has_single_bit(capacity));
+
+    auto& index = _large->index;
+    index.assign(capacity, 0);
+
+    auto const mask = capacity - 1;
+    for (auto j = 0uz; j != _large->items.size(); ++j) {
+        auto i = std::hash<interned_string>{}(_large->items[j].name) & mask;
+        while (index[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        index[i] = static_cast<std::uint32_t>(j + 1);
+    }
+}
+
+}
@@ -0,0 +1,128 @@
+
+#pragma once
+
+#include "om_ptr.hpp"
+#include "utility/interned_string.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace hk {
+
+class om_object;
+
+/** The members of an object, by name.
+ *
+ * The names are interned, so that looking up a member compares pointers
+ * instead of strings.
+ *
+ * Most objects have only a few members, which are stored in an inline
+ * array and found with a linear scan. When a dictionary grows beyond
+ * `max_inline_size` members, they are moved to the heap together with an
+ * open-addressing hash index, for the namespaces of large programs.
+ *
+ * The members are kept in the order they were inserted.
+ */
+class om_dictionary {
+public:
+    struct value_type {
+        interned_string name;
+        om_ptr<om_object> object;
+    };
+
+    constexpr static auto max_inline_size = 7uz;
+
+    ~om_dictionary();
+    om_dictionary(om_dictionary const&) = delete;
+    om_dictionary(om_dictionary&&) = delete;
+    om_dictionary& operator=(om_dictionary const&) = delete;
+    om_dictionary& operator=(om_dictionary&&) = delete;
+    om_dictionary() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /** The members, in the order they were inserted.
+     */
+    [[nodiscard]] std::span<value_type const> items() const noexcept
+    {
+        if (_large) {
+            return _large->items;
+        }
+        return std::span{_inline}.first(_size);
+    }
+
+    [[nodiscard]] auto begin() const noexcept
+    {
+        return items().begin();
+    }
+
+    [[nodiscard]] auto end() const noexcept
+    {
+        return items().end();
+    }
+
+    /** Find a member.
+     *
+     * @param name The name of the member.
+     * @return The member.
+     * @retval nullptr The member was not found.
+     */
+    [[nodiscard]] om_object *find(interned_string name) const noexcept
+    {
+        if (_large) {
+            return find_large(name);
+        }
+
+        for (auto i = 0uz; i != _size; ++i) {
+            if (_inline[i].name == name) {
+                return _inline[i].object.get();
+            }
+        }
+        return nullptr;
+    }
+
+    /** Insert a member.
+     *
+     * @param name The name of the member.
+     * @param object The member.
+     * @return The existing member with the same name.
+     * @retval nullptr Successfully inserted.
+     */
+    om_object *insert(interned_string name, om_ptr<om_object> object);
+
+private:
+    struct large_type {
+        std::vector<value_type> items;
+
+        /** The index + 1 of each item in the hash index, zero for an empty slot.
+         */
+        std::vector<std::uint32_t> index;
+    };
+
+    std::array<value_type, max_inline_size> _inline = {};
+    std::size_t _size = 0;
+    std::unique_ptr<large_type> _large = nullptr;
+
+    [[nodiscard]] om_object *find_large(interned_string name) const noexcept;
+
+    /** Move the inline members to the heap.
+     */
+    void grow();
+
+    /** Rebuild the hash index with @a capacity slots.
+     */
+    void reindex(std::size_t capacity);
+};
+
+}
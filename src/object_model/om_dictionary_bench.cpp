@@ -0,0 +1,86 @@
+
+#include "om_dictionary.hpp"
+#include "om_object.hpp"
+#include "utility/vector_map.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** `state.range(0)` member names like they appear in source code.
+ */
+[[nodiscard]] std::vector<std::string> make_names(benchmark::State const& state)
+{
+    auto r = std::vector<std::string>{};
+    for (auto i = int64_t{0}; i != state.range(0); ++i) {
+        r.push_back(std::format("member_identifier_{}", i));
+    }
+    return r;
+}
+
+/** 1024 random indices into the names, so that lookups are not predictable.
+ */
+[[nodiscard]] std::vector<std::size_t> make_lookups(std::size_t num_names)
+{
+    auto engine = std::mt19937{42};
+
+    auto r = std::vector<std::size_t>{};
+    r.reserve(1024);
+    for (auto i = 0uz; i != 1024; ++i) {
+        r.push_back(engine() % num_names);
+    }
+    return r;
+}
+
+/** Look up members of an `om_dictionary` by interned name.
+ */
+void bm_om_dictionary_find(benchmark::State& state)
+{
+    auto const names = make_names(state);
+    auto const lookups = make_lookups(names.size());
+
+    auto dict = hk::om_dictionary{};
+    auto keys = std::vector<hk::interned_string>{};
+    for (auto const& name : names) {
+        keys.emplace_back(name);
+        dict.insert(keys.back(), hk::make_om<hk::om_object>());
+    }
+
+    for (auto _ : state) {
+        for (auto const i : lookups) {
+            benchmark::DoNotOptimize(dict.find(keys[i]));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lookups.size()));
+}
+
+/** The same as `bm_om_dictionary_find()` with the previous layout as a baseline.
+ */
+void bm_vector_map_find(benchmark::State& state)
+{
+    auto const names = make_names(state);
+    auto const lookups = make_lookups(names.size());
+
+    auto dict = hk::vector_map<std::string, std::shared_ptr<hk::om_object>>{};
+    for (auto const& name : names) {
+        dict.try_emplace(name, std::make_shared<hk::om_object>());
+    }
+
+    for (auto _ : state) {
+        for (auto const i : lookups) {
+            benchmark::DoNotOptimize(dict.find(names[i]));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lookups.size()));
+}
+
+} // namespace
+
+BENCHMARK(bm_om_dictionary_find)->Arg(4)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK(bm_vector_map_find)->Arg(4)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
@@ -0,0 +1,135 @@
+
+#include "om_dictionary.hpp"
+#include "om_namespace.hpp"
+#include "om_object.hpp"
+#include <hikotest/hikotest.hpp>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** An object that counts how many of its kind are alive.
+ */
+class counted_object : public hk::om_object {
+public:
+    static inline auto num_alive = 0;
+
+    ~counted_object() override
+    {
+        --num_alive;
+    }
+
+    counted_object()
+    {
+        ++num_alive;
+    }
+};
+
+[[nodiscard]] std::vector<hk::interned_string> make_names(std::size_t n)
+{
+    auto r = std::vector<hk::interned_string>{};
+    for (auto i = 0uz; i != n; ++i) {
+        r.emplace_back(std::format("member_{}", i));
+    }
+    return r;
+}
+
+} // namespace
+
+TEST_SUITE(om_dictionary_suite)
+{
+
+TEST_CASE(om_ptr_ref_count)
+{
+    {
+        auto a = hk::make_om<counted_object>();
+        REQUIRE(counted_object::num_alive == 1);
+
+        auto b = hk::om_ptr<hk::om_object>{a};
+        a = nullptr;
+        REQUIRE(counted_object::num_alive == 1);
+
+        auto c = std::move(b);
+        REQUIRE(b == nullptr);
+        REQUIRE(counted_object::num_alive == 1);
+    }
+    REQUIRE(counted_object::num_alive == 0);
+}
+
+TEST_CASE(small)
+{
+    auto const names = make_names(hk::om_dictionary::max_inline_size);
+
+    auto dict = hk::om_dictionary{};
+    auto objects = std::vector<hk::om_object *>{};
+    for (auto const& name : names) {
+        auto object = hk::make_om<counted_object>();
+        objects.push_back(object.get());
+        REQUIRE(dict.insert(name, std::move(object)) == nullptr);
+    }
+    REQUIRE(dict.size() == names.size());
+
+    for (auto i = 0uz; i != names.size(); ++i) {
+        REQUIRE(dict.find(names[i]) == objects[i]);
+    }
+    REQUIRE(dict.find(hk::interned_string{"member_not_found"}) == nullptr);
+
+    // A duplicate is not inserted, and the existing member is returned.
+    REQUIRE(dict.insert(names[3], hk::make_om<counted_object>()) == objects[3]);
+    REQUIRE(dict.size() == names.size());
+}
+
+TEST_CASE(large)
+{
+    auto const names = make_names(1000);
+
+    {
+        auto dict = hk::om_dictionary{};
+        auto objects = std::vector<hk::om_object *>{};
+        for (auto i = 0uz; i != names.size(); ++i) {
+            auto object = hk::make_om<counted_object>();
+            objects.push_back(object.get());
+            REQUIRE(dict.insert(names[i], std::move(object)) == nullptr);
+
+            // Every member is still found after the inline array is moved to the heap.
+            if (i == hk::om_dictionary::max_inline_size) {
+                for (auto j = 0uz; j <= i; ++j) {
+                    REQUIRE(dict.find(names[j]) == objects[j]);
+                }
+            }
+        }
+        REQUIRE(dict.size() == 1000);
+        REQUIRE(counted_object::num_alive == 1000);
+
+        for (auto i = 0uz; i != names.size(); ++i) {
+            REQUIRE(dict.find(names[i]) == objects[i]);
+        }
+        REQUIRE(dict.insert(names[500], hk::make_om<counted_object>()) == objects[500]);
+
+        // The members are kept in the order they were inserted.
+        auto i = 0uz;
+        for (auto const& [name, object] : dict) {
+            REQUIRE(name == names[i]);
+            REQUIRE(object.get() == objects[i]);
+            ++i;
+        }
+    }
+    REQUIRE(counted_object::num_alive == 0);
+}
+
+TEST_CASE(parent)
+{
+    auto ns = hk::make_om<hk::om_namespace>();
+    auto member = hk::make_om<counted_object>();
+    auto *const ptr = member.get();
+
+    REQUIRE(ns->add(hk::interned_string{"foo"}, std::move(member)) == nullptr);
+    REQUIRE(ns->get(hk::interned_string{"foo"}) == ptr);
+    REQUIRE(ptr->parent() == ns.get());
+
+    ns = nullptr;
+    REQUIRE(counted_object::num_alive == 0);
+}
+
+}; // TEST_SUITE(om_dictionary_suite)
@@ -0,0 +1,171 @@
+
+#include "om_instantiation_table.hpp"
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace hk {
+
+[[nodiscard]] om_instantiation_table& om_instantiation_table::global() noexcept
+{
+    static auto r = om_instantiation_table{};
+    return r;
+}
+
+[[nodiscard]] om_instantiation_table::result_type
+om_instantiation_table::instantiate(om_instantiation_key key, make_function const& make)
+{
+    assert(key.t != nullptr);
+
+    auto& s = shard(std::hash<om_instantiation_key>{}(key));
+
+    auto promise = std::promise<result_type>{};
+    auto future = std::shared_future<result_type>{};
+    {
+        auto const lock = std::scoped_lock(s.mutex);
+        auto const [it, inserted] = s.entries.try_emplace(key, promise.get_future().share(), std::this_thread::get_id());
+        if (not inserted) {
+            auto const& entry = it->second;
+            auto const ready = entry.future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+            if (not ready and entry.owner == std::this_thread::get_id()) {
+                return std::unexpected{hkc_error::recursive_instantiation};
+            }
+            future = entry.future;
+        }
+    }
+
+    // Another thread made or is making the instantiation, wait outside the lock.
+    if (future.valid()) {
+        return future.get();
+    }
+
+    try {
+        auto r = make(*key.t, key.arguments);
+        promise.set_value(r);
+        return r;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+[[nodiscard]] om_object *om_instantiation_table::find(om_instantiation_key const& key) const
+{
+    auto const& s = shard(std::hash<om_instantiation_key>{}(key));
+
+    auto const lock = std::scoped_lock(s.mutex);
+    auto const it = s.entries.find(key);
+    if (it == s.entries.end() or it->second.future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+        return nullptr;
+    }
+
+    try {
+        auto const& r = it->second.future.get();
+        return r ? r->get() : nullptr;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+[[nodiscard]] std::size_t om_instantiation_table::size() const
+{
+    auto r = 0uz;
+    for (auto const& s : _shards) {
+        auto const lock = std::scoped_lock(s.mutex);
+        r += s.entries.size();
+    }
+    return r;
+}
+
+void om_instantiation_table::save(std::ostream& out, name_function const& name_of) const
+{
+    for (auto const& s : _shards) {
+        auto const lock = std::scoped_lock(s.mutex);
+        for (auto const& [key, entry] : s.entries) {
+            if (entry.future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+                continue;
+            }
+
+            auto line = name_of(key.t);
+            if (not line) {
+                continue;
+            }
+
+            auto const named = [&] {
+                for (auto const& argument : key.arguments) {
+                    auto const& value = argument.value();
+                    if (auto const *type = std::get_if<om_object const *>(&value)) {
+                        auto const name = name_of(*type);
+                        if (not name) {
+                            return false;
+                        }
+                        *line += "\tt:";
+                        *line += *name;
+                    } else if (auto const *integer = std::get_if<builtin::long_int>(&value)) {
+                        *line += "\ti:";
+                        *line += integer->to_string();
+                    } else {
+                        *line += "\ts:";
+                        *line += std::get<interned_string>(value).string_view();
+                    }
+                }
+                return true;
+            }();
+
+            if (named) {
+                out << *line << '\n';
+            }
+        }
+    }
+}
+
+[[nodiscard]] std::vector<om_instantiation_key> om_instantiation_table::load(std::istream& in, lookup_function const& lookup)
+{
+    auto r = std::vector<om_instantiation_key>{};
+
+    auto line = std::string{};
+    while (std::getline(in, line)) {
+        auto fields = std::string_view{line};
+        auto const next_field = [&] {
+            auto const i = fields.find('\t');
+            auto const field = fields.substr(0, i);
+            fields = i == fields.npos ? std::string_view{} : fields.substr(i + 1);
+            return field;
+        };
+
+        auto const *t = dynamic_cast<om_template const *>(lookup(next_field()));
+        if (t == nullptr) {
+            continue;
+        }
+
+        auto key = om_instantiation_key{t};
+        auto valid = true;
+        while (valid and not fields.empty()) {
+            auto const field = next_field();
+            auto const value = field.substr(std::min(field.size(), 2uz));
+            if (field.starts_with("t:")) {
+                auto const *type = lookup(value);
+                valid = type != nullptr;
+                key.arguments.emplace_back(type);
+            } else if (field.starts_with("i:")) {
+                auto integer = builtin::long_int::from_string(value);
+                valid = integer.has_value();
+                if (valid) {
+                    key.arguments.emplace_back(std::move(*integer));
+                }
+            } else if (field.starts_with("s:")) {
+                key.arguments.emplace_back(interned_string{value});
+            } else {
+                valid = false;
+            }
+        }
+
+        if (valid) {
+            r.push_back(std::move(key));
+        }
+    }
+    return r;
+}
+
+}
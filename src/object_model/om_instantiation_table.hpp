@@ -0,0 +1,157 @@
+
+#pragma once
+
+#include "om_object.hpp"
+#include "om_ptr.hpp"
+#include "om_template.hpp"
+#include "om_template_argument.hpp"
+#include "error/hkc_error.hpp"
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <future>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hk {
+
+/** A template and its arguments.
+ */
+struct om_instantiation_key {
+    om_template const *t = nullptr;
+    std::vector<om_template_argument> arguments = {};
+
+    [[nodiscard]] friend bool operator==(om_instantiation_key const&, om_instantiation_key const&) noexcept = default;
+};
+
+}
+
+template<>
+struct std::hash<hk::om_instantiation_key> {
+    [[nodiscard]] std::size_t operator()(hk::om_instantiation_key const& x) const noexcept
+    {
+        auto h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(x.t));
+        for (auto const& argument : x.arguments) {
+            h = (h ^ argument.hash()) * 0x9e37'79b9'7f4a'7c15;
+        }
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
+
+namespace hk {
+
+/** The instantiations of templates, keyed by template and arguments.
+ *
+ * The same instantiation is requested many times, for example `string[utf8]`
+ * or `int[0..=255]`. The table makes sure that each instantiation is made
+ * once, so that equal instantiations are the same object and the resulting
+ * types can be compared by address.
+ *
+ * Concurrent requests for the same instantiation are single-flighted: the
+ * first thread makes the instantiation, the other threads wait for it. A
+ * failed instantiation is remembered as well.
+ */
+class om_instantiation_table {
+public:
+    using result_type = std::expected<om_ptr<om_object>, hkc_error>;
+    using make_function = std::function<result_type(om_template const&, std::span<om_template_argument const>)>;
+
+    /** Get the name of a template or type, to persist an instantiation.
+     *
+     * @return The fully qualified name, or empty if the object can not be named.
+     */
+    using name_function = std::function<std::optional<std::string>(om_object const *)>;
+
+    /** Find a template or type by name, to load a persisted instantiation.
+     *
+     * @return The object, or nullptr if it no longer exists.
+     */
+    using lookup_function = std::function<om_object const *(std::string_view)>;
+
+    om_instantiation_table(om_instantiation_table const&) = delete;
+    om_instantiation_table(om_instantiation_table&&) = delete;
+    om_instantiation_table& operator=(om_instantiation_table const&) = delete;
+    om_instantiation_table& operator=(om_instantiation_table&&) = delete;
+    om_instantiation_table() = default;
+
+    /** The table shared by all modules.
+     */
+    [[nodiscard]] static om_instantiation_table& global() noexcept;
+
+    /** Instantiate a template.
+     *
+     * @param key The template and its arguments.
+     * @param make The function that makes the instantiation, called only
+     *             when the instantiation is not in the table.
+     * @return The instantiation.
+     * @retval hkc_error::recursive_instantiation When @a make requests the
+     *         instantiation that it is making.
+     */
+    [[nodiscard]] result_type instantiate(om_instantiation_key key, make_function const& make);
+
+    /** Find a completed instantiation.
+     *
+     * @return The instantiation, or nullptr if it was not made, is still
+     *         being made, or failed.
+     */
+    [[nodiscard]] om_object *find(om_instantiation_key const& key) const;
+
+    /** The number of instantiations, including those still being made.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /** Write the keys of the completed instantiations to a build cache.
+     *
+     * Each line is the name of the template followed by the arguments,
+     * separated by tabs: `t:` and the name of a type, `i:` and a decimal
+     * integer, or `s:` and a name. Instantiations that can not be named are
+     * skipped.
+     */
+    void save(std::ostream& out, name_function const& name_of) const;
+
+    /** Read the keys written by `save()`.
+     *
+     * The compiler instantiates these ahead of time in a next build. Lines
+     * that name templates or types that no longer exist are skipped.
+     */
+    [[nodiscard]] static std::vector<om_instantiation_key> load(std::istream& in, lookup_function const& lookup);
+
+private:
+    struct entry_type {
+        std::shared_future<result_type> future;
+
+        /** The thread that is making the instantiation.
+         */
+        std::thread::id owner;
+    };
+
+    struct shard_type {
+        mutable std::mutex mutex;
+        std::unordered_map<om_instantiation_key, entry_type> entries;
+    };
+
+    constexpr static auto num_shards = 16uz;
+
+    std::array<shard_type, num_shards> _shards;
+
+    [[nodiscard]] shard_type& shard(std::size_t hash) noexcept
+    {
+        return _shards[(hash >> 8) % num_shards];
+    }
+
+    [[nodiscard]] shard_type const& shard(std::size_t hash) const noexcept
+    {
+        return _shards[(hash >> 8) % num_shards];
+    }
+};
+
+}
@@ -0,0 +1,165 @@
+
+#include "om_instantiation_table.hpp"
+#include <hikotest/hikotest.hpp>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using hk::builtin::long_int;
+
+/** Make a new object for each instantiation, and count the calls.
+ */
+struct counting_make {
+    std::atomic<int>* num_calls;
+
+    hk::om_instantiation_table::result_type operator()(hk::om_template const&, std::span<hk::om_template_argument const>) const
+    {
+        ++*num_calls;
+        return hk::make_om<hk::om_object>();
+    }
+};
+
+} // namespace
+
+TEST_SUITE(om_instantiation_table_suite)
+{
+
+TEST_CASE(hash_consing)
+{
+    auto table = hk::om_instantiation_table{};
+    auto const t = hk::make_om<hk::om_template>();
+    auto const int_type = hk::make_om<hk::om_object>();
+    auto num_calls = std::atomic<int>{0};
+    auto const make = counting_make{&num_calls};
+
+    // int[0..=255], the bounds are compared by value.
+    auto const a = table.instantiate({t.get(), {long_int{0}, long_int{255}}}, make);
+    auto const b = table.instantiate({t.get(), {long_int{0}, long_int{255}}}, make);
+    REQUIRE(a.value() == b.value());
+    REQUIRE(num_calls.load() == 1);
+
+    auto const c = table.instantiate({t.get(), {long_int{0}, long_int{256}}}, make);
+    REQUIRE(a.value() != c.value());
+    REQUIRE(num_calls.load() == 2);
+
+    // Values larger than 64 bits.
+    auto const big = long_int::from_string("123456789012345678901234567890").value();
+    auto const d = table.instantiate({t.get(), {big}}, make);
+    auto const e = table.instantiate({t.get(), {long_int::from_string("123456789012345678901234567890").value()}}, make);
+    REQUIRE(d.value() == e.value());
+    REQUIRE(num_calls.load() == 3);
+
+    // Types and names.
+    auto const f = table.instantiate({t.get(), {int_type.get(), hk::interned_string{"utf8"}}}, make);
+    auto const g = table.instantiate({t.get(), {int_type.get(), hk::interned_string{"utf8"}}}, make);
+    REQUIRE(f.value() == g.value());
+    REQUIRE(num_calls.load() == 4);
+
+    REQUIRE(table.size() == 4);
+    REQUIRE(table.find({t.get(), {int_type.get(), hk::interned_string{"utf8"}}}) == f.value().get());
+    REQUIRE(table.find({t.get(), {int_type.get(), hk::interned_string{"utf16"}}}) == nullptr);
+}
+
+TEST_CASE(errors)
+{
+    auto table = hk::om_instantiation_table{};
+    auto const t = hk::make_om<hk::om_template>();
+    auto num_calls = 0;
+
+    // A failed instantiation is remembered.
+    auto const fail = [&](hk::om_template const&, std::span<hk::om_template_argument const>) -> hk::om_instantiation_table::result_type {
+        ++num_calls;
+        return std::unexpected{hk::hkc_error::invalid_operand_types};
+    };
+    REQUIRE(table.instantiate({t.get(), {long_int{1}}}, fail).error() == hk::hkc_error::invalid_operand_types);
+    REQUIRE(table.instantiate({t.get(), {long_int{1}}}, fail).error() == hk::hkc_error::invalid_operand_types);
+    REQUIRE(num_calls == 1);
+    REQUIRE(table.find({t.get(), {long_int{1}}}) == nullptr);
+
+    // An instantiation that depends on itself.
+    auto recursive = hk::om_instantiation_table::make_function{};
+    recursive = [&](hk::om_template const& x, std::span<hk::om_template_argument const> arguments) -> hk::om_instantiation_table::result_type {
+        auto const r = table.instantiate({&x, {arguments.begin(), arguments.end()}}, recursive);
+        REQUIRE(r.error() == hk::hkc_error::recursive_instantiation);
+        return r;
+    };
+    REQUIRE(table.instantiate({t.get(), {long_int{2}}}, recursive).error() == hk::hkc_error::recursive_instantiation);
+}
+
+TEST_CASE(single_flight)
+{
+    constexpr auto num_threads = 8;
+
+    auto table = hk::om_instantiation_table{};
+    auto const t = hk::make_om<hk::om_template>();
+    auto num_calls = std::atomic<int>{0};
+
+    auto const slow_make = [&](hk::om_template const&, std::span<hk::om_template_argument const>) -> hk::om_instantiation_table::result_type {
+        ++num_calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        return hk::make_om<hk::om_object>();
+    };
+
+    auto results = std::vector<hk::om_object *>(num_threads);
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i != num_threads; ++i) {
+        threads.emplace_back([&, i] {
+            results[i] = table.instantiate({t.get(), {long_int{42}}}, slow_make).value().get();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(num_calls.load() == 1);
+    for (auto const *result : results) {
+        REQUIRE(result == results[0]);
+    }
+}
+
+TEST_CASE(save_load)
+{
+    auto table = hk::om_instantiation_table{};
+    auto const t = hk::make_om<hk::om_template>();
+    auto const int_type = hk::make_om<hk::om_object>();
+    auto const unnamed_type = hk::make_om<hk::om_object>();
+    auto num_calls = std::atomic<int>{0};
+    auto const make = counting_make{&num_calls};
+
+    std::ignore = table.instantiate({t.get(), {int_type.get(), long_int{-5}, hk::interned_string{"utf8"}}}, make);
+    std::ignore = table.instantiate({t.get(), {unnamed_type.get()}}, make);
+
+    auto const names = std::map<hk::om_object const *, std::string>{{t.get(), ".std.foo"}, {int_type.get(), ".std.int"}};
+    auto out = std::stringstream{};
+    table.save(out, [&](hk::om_object const *x) -> std::optional<std::string> {
+        if (auto const it = names.find(x); it != names.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    });
+
+    // The instantiation with an unnamed type is skipped.
+    REQUIRE(out.str() == ".std.foo\tt:.std.int\ti:-5\ts:utf8\n");
+
+    auto in = std::stringstream{out.str() + ".std.removed\ti:1\n"};
+    auto const keys = hk::om_instantiation_table::load(in, [&](std::string_view name) -> hk::om_object const * {
+        for (auto const& [object, object_name] : names) {
+            if (object_name == name) {
+                return object;
+            }
+        }
+        return nullptr;
+    });
+    REQUIRE(keys.size() == 1);
+    REQUIRE(keys[0].t == t.get());
+    REQUIRE(keys[0].arguments.size() == 3);
+    REQUIRE(table.find(keys[0]) != nullptr);
+}
+
+}; // TEST_SUITE(om_instantiation_table_suite)
@@ -1,13 +1,18 @@
 
 #pragma once
 
-#include "utility/vector_map.hpp"
-#include <memory>
+#include "om_dictionary.hpp"
+#include "om_ptr.hpp"
+#include "utility/interned_string.hpp"
+#include <atomic>
+#include <cstddef>
 
 namespace hk {
 
 /** Base object.
- * 
+ *
+ * Objects are reference counted intrusively, and are owned through an
+ * `om_ptr`, usually by the dictionary of their parent.
  */
 class om_object {
 public:
@@ -18,13 +23,73 @@ public:
     om_object& operator=(om_object&&) = delete;
     om_object() = default;
 
+    /** The object that has this object as a member.
+     */
+    [[nodiscard]] om_object *parent() const noexcept
+    {
+        return _parent;
+    }
+
+    /** The members of this object.
+     */
+    [[nodiscard]] om_dictionary const& members() const noexcept
+    {
+        return _dict;
+    }
+
+    /** Get a member.
+     *
+     * @param name The name of the member.
+     * @return The member.
+     * @retval nullptr The member was not found.
+     */
+    [[nodiscard]] om_object *get(interned_string name) const noexcept
+    {
+        return _dict.find(name);
+    }
+
+    /** Add a member.
+     *
+     * @param name The name of the member.
+     * @param member The member, this object becomes its parent.
+     * @return The existing member with the same name.
+     * @retval nullptr Successfully added.
+     */
+    om_object *add(interned_string name, om_ptr<om_object> member)
+    {
+        auto *const ptr = member.get();
+        auto *const r = _dict.insert(name, std::move(member));
+        if (r == nullptr) {
+            ptr->_parent = this;
+        }
+        return r;
+    }
 
 private:
     om_object *_parent = nullptr;
 
+    /** The number of `om_ptr` that point to this object.
+     */
+    mutable std::atomic<std::size_t> _ref_count = 0;
+
     /** The dictionary of the object
      */
-    vector_map<std::string, std::shared_ptr<om_object>> _dict;
+    om_dictionary _dict;
+
+    void retain() const noexcept
+    {
+        _ref_count.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    void release() const noexcept
+    {
+        if (_ref_count.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    template<typename T>
+    friend class om_ptr;
 };
 
 }
@@ -0,0 +1,171 @@
+
+#include "om_overload_set.hpp"
+#include <cassert>
+#include <compare>
+#include <optional>
+
+namespace hk {
+
+namespace {
+
+/** How well a template matches a call-site.
+ *
+ * Compared in the priority order of "Best matching function" in
+ * doc/language/data_model.md; a larger rank is a better match.
+ */
+struct rank_type {
+    /** The longest start sequence of perfect matching arguments.
+     */
+    std::size_t perfect_prefix = 0;
+
+    /** The number of perfect matching arguments.
+     */
+    std::size_t num_perfect = 0;
+
+    /** The longest start sequence of arguments with a matching type.
+     */
+    std::size_t typed_prefix = 0;
+
+    /** The number of arguments with a matching type.
+     */
+    std::size_t num_typed = 0;
+
+    /** The sum of the passing costs, negated.
+     */
+    int passing = 0;
+
+    /** The declared return type is the expected return type.
+     */
+    bool exact_return_type = false;
+
+    [[nodiscard]] friend auto operator<=>(rank_type const&, rank_type const&) = default;
+};
+
+/** Match the arguments of a call-site with the parameters of a template.
+ *
+ * An argument matches perfectly when the type is the same and it is passed
+ * the exact way for its value category. An argument of the same type that
+ * is passed in another allowed way has a matching type. A parameter
+ * without a type accepts any argument.
+ *
+ * @return The rank, or empty when the template does not match.
+ */
+[[nodiscard]] std::optional<rank_type> match(om_template const& t, om_call_signature const& signature) noexcept
+{
+    auto const parameters = t.parameters();
+    if (parameters.size() != signature.arguments.size()) {
+        return std::nullopt;
+    }
+
+    if (signature.return_type != nullptr and t.return_type() != nullptr and signature.return_type != t.return_type()) {
+        return std::nullopt;
+    }
+
+    auto r = rank_type{};
+    r.exact_return_type = signature.return_type != nullptr and signature.return_type == t.return_type();
+
+    auto perfect_prefix = true;
+    auto typed_prefix = true;
+    for (auto i = 0uz; i != parameters.size(); ++i) {
+        auto const& parameter = parameters[i];
+        auto const& argument = signature.arguments[i];
+
+        if (parameter.type != nullptr and parameter.type != argument.type) {
+            return std::nullopt;
+        }
+
+        auto const cost = passing_cost(argument.category, parameter.passing);
+        if (cost < 0) {
+            return std::nullopt;
+        }
+        r.passing -= cost;
+
+        auto const typed = parameter.type != nullptr;
+        auto const perfect = typed and cost == 0;
+
+        perfect_prefix = perfect_prefix and perfect;
+        typed_prefix = typed_prefix and typed;
+        r.perfect_prefix += perfect_prefix;
+        r.num_perfect += perfect;
+        r.typed_prefix += typed_prefix;
+        r.num_typed += typed;
+    }
+    return r;
+}
+
+} // namespace
+
+void om_overload_set::add(om_ptr<om_template> t)
+{
+    assert(t != nullptr);
+
+    auto const lock = std::scoped_lock(_mutex);
+    _templates.push_back(std::move(t));
+    ++_version;
+    _cache.clear();
+}
+
+[[nodiscard]] std::vector<om_ptr<om_template>> om_overload_set::templates() const
+{
+    auto const lock = std::shared_lock(_mutex);
+    return _templates;
+}
+
+[[nodiscard]] std::expected<om_template *, hkc_error> om_overload_set::resolve(om_call_signature const& signature) const
+{
+    auto version = std::uint64_t{};
+    auto r = result_type{};
+    {
+        auto const lock = std::shared_lock(_mutex);
+        if (auto const it = _cache.find(signature); it != _cache.end()) {
+            return it->second;
+        }
+
+        version = _version;
+        r = rank_locked(signature);
+    }
+
+    // Only cache the result when no template was added while ranking.
+    auto const lock = std::scoped_lock(_mutex);
+    if (_version == version) {
+        _cache.try_emplace(signature, r);
+    }
+    return r;
+}
+
+[[nodiscard]] std::expected<om_template *, hkc_error> om_overload_set::rank(om_call_signature const& signature) const
+{
+    auto const lock = std::shared_lock(_mutex);
+    return rank_locked(signature);
+}
+
+[[nodiscard]] om_overload_set::result_type om_overload_set::rank_locked(om_call_signature const& signature) const
+{
+    auto best = std::optional<rank_type>{};
+    auto best_template = static_cast<om_template *>(nullptr);
+    auto ambiguous = false;
+
+    for (auto const& t : _templates) {
+        auto const rank = match(*t, signature);
+        if (not rank) {
+            continue;
+        }
+
+        if (not best or *rank > *best) {
+            best = rank;
+            best_template = t.get();
+            ambiguous = false;
+        } else if (*rank == *best) {
+            ambiguous = true;
+        }
+    }
+
+    if (not best) {
+        return std::unexpected{hkc_error::no_matching_overload};
+    } else if (ambiguous) {
+        return std::unexpected{hkc_error::ambiguous_overload};
+    }
+    return best_template;
+}
+
+}
@@ -2,15 +2,73 @@
 #pragma once
 
 #include "om_object.hpp"
+#include "om_ptr.hpp"
+#include "om_signature.hpp"
+#include "om_template.hpp"
+#include "error/hkc_error.hpp"
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace hk {
 
+/** The templates with the same name, see doc/language/data_model.md.
+ *
+ * A call is resolved to the best matching template of the overload set.
+ * The result is cached per call-site signature, so that call-sites with
+ * the same argument types, value categories and expected return type do
+ * not rank every template again. Adding a template invalidates the cache.
+ *
+ * The overload set may be resolved concurrently from multiple threads;
+ * cache hits only take a shared lock.
+ */
 class om_overload_set : public om_object {
 public:
+    /** Add a template to the overload set.
+     */
+    void add(om_ptr<om_template> t);
+
+    /** A copy of the templates of the overload set.
+     */
+    [[nodiscard]] std::vector<om_ptr<om_template>> templates() const;
+
+    /** The number of times a template was added, used to invalidate the cache.
+     */
+    [[nodiscard]] std::uint64_t version() const noexcept
+    {
+        auto const lock = std::shared_lock(_mutex);
+        return _version;
+    }
+
+    /** Resolve a call to the best matching template, using the cache.
+     *
+     * @param signature The signature of the call-site.
+     * @return The best matching template.
+     * @retval hkc_error::no_matching_overload No template matches.
+     * @retval hkc_error::ambiguous_overload Multiple templates match equally well.
+     */
+    [[nodiscard]] std::expected<om_template *, hkc_error> resolve(om_call_signature const& signature) const;
+
+    /** Rank the templates for a call, without using the cache.
+     *
+     * @see resolve()
+     */
+    [[nodiscard]] std::expected<om_template *, hkc_error> rank(om_call_signature const& signature) const;
 
 private:
-    std::vector<std::unique_ptr<om_template>> _templates;
+    using result_type = std::expected<om_template *, hkc_error>;
+
+    mutable std::shared_mutex _mutex;
+    std::vector<om_ptr<om_template>> _templates;
+    std::uint64_t _version = 0;
+    mutable std::unordered_map<om_call_signature, result_type> _cache;
+
+    [[nodiscard]] result_type rank_locked(om_call_signature const& signature) const;
 };
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,60 @@
+
+#include "om_overload_set.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+/** An overload set of `state.range(0)` templates with one parameter each,
+ * and the call-sites that select each of them.
+ */
+struct fixture {
+    std::vector<hk::om_ptr<hk::om_object>> types;
+    hk::om_ptr<hk::om_overload_set> set = hk::make_om<hk::om_overload_set>();
+    std::vector<hk::om_call_signature> calls;
+
+    explicit fixture(benchmark::State const& state)
+    {
+        for (auto i = int64_t{0}; i != state.range(0); ++i) {
+            auto const& type = types.emplace_back(hk::make_om<hk::om_object>());
+            set->add(hk::make_om<hk::om_template>(std::vector<hk::om_parameter>{{type.get(), hk::om_passing::automatic}}));
+            calls.push_back(hk::om_call_signature{{{type.get(), hk::om_value_category::value}}});
+        }
+        set->add(hk::make_om<hk::om_template>(std::vector<hk::om_parameter>{{nullptr, hk::om_passing::automatic}}));
+    }
+};
+
+/** Resolve calls through the cache of the overload set.
+ */
+void bm_om_overload_set_resolve(benchmark::State& state)
+{
+    auto const f = fixture{state};
+
+    for (auto _ : state) {
+        for (auto const& call : f.calls) {
+            benchmark::DoNotOptimize(f.set->resolve(call));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(f.calls.size()));
+}
+
+/** The same as `bm_om_overload_set_resolve()` ranking every template at every call.
+ */
+void bm_om_overload_set_rank(benchmark::State& state)
+{
+    auto const f = fixture{state};
+
+    for (auto _ : state) {
+        for (auto const& call : f.calls) {
+            benchmark::DoNotOptimize(f.set->rank(call));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(f.calls.size()));
+}
+
+} // namespace
+
+BENCHMARK(bm_om_overload_set_resolve)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(bm_om_overload_set_rank)->Arg(2)->Arg(8)->Arg(32);
@@ -0,0 +1,155 @@
+
+#include "om_overload_set.hpp"
+#include <hikotest/hikotest.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using hk::om_value_category;
+using hk::om_passing;
+
+/** Types are objects, they are compared by address.
+ */
+[[nodiscard]] hk::om_ptr<hk::om_object> const& int_type()
+{
+    static auto const r = hk::make_om<hk::om_object>();
+    return r;
+}
+
+[[nodiscard]] hk::om_ptr<hk::om_object> const& float_type()
+{
+    static auto const r = hk::make_om<hk::om_object>();
+    return r;
+}
+
+[[nodiscard]] hk::om_ptr<hk::om_template>
+make_template(std::vector<hk::om_parameter> parameters, hk::om_object const *return_type = nullptr)
+{
+    return hk::make_om<hk::om_template>(std::move(parameters), return_type);
+}
+
+[[nodiscard]] hk::om_call_signature make_call(
+    std::vector<hk::om_argument> arguments, hk::om_object const *return_type = nullptr)
+{
+    return hk::om_call_signature{std::move(arguments), return_type};
+}
+
+} // namespace
+
+TEST_SUITE(om_overload_set_suite)
+{
+
+TEST_CASE(exact_type)
+{
+    // fn foo(x: int), fn foo(x)
+    auto set = hk::make_om<hk::om_overload_set>();
+    auto const typed = make_template({{int_type().get(), om_passing::automatic}});
+    auto const generic = make_template({{nullptr, om_passing::automatic}});
+    set->add(generic);
+    set->add(typed);
+
+    REQUIRE(set->resolve(make_call({{int_type().get(), om_value_category::value}})).value() == typed.get());
+    REQUIRE(set->resolve(make_call({{float_type().get(), om_value_category::value}})).value() == generic.get());
+    REQUIRE(set->resolve(make_call({})).error() == hk::hkc_error::no_matching_overload);
+}
+
+TEST_CASE(passing)
+{
+    // fn foo(a <- &), fn foo(a <- &&)
+    auto set = hk::make_om<hk::om_overload_set>();
+    auto const by_reference = make_template({{int_type().get(), om_passing::reference}});
+    auto const by_movable = make_template({{int_type().get(), om_passing::movable}});
+    set->add(by_reference);
+    set->add(by_movable);
+
+    REQUIRE(set->resolve(make_call({{int_type().get(), om_value_category::reference}})).value() == by_reference.get());
+    REQUIRE(set->resolve(make_call({{int_type().get(), om_value_category::movable}})).value() == by_movable.get());
+    REQUIRE(set->resolve(make_call({{int_type().get(), om_value_category::value}})).value() == by_reference.get());
+
+    // A const reference can not be passed as a mutable reference or a movable.
+    REQUIRE(set->resolve(make_call({{int_type().get(), om_value_category::const_reference}})).error() == hk::hkc_error::no_matching_overload);
+}
+
+TEST_CASE(priority)
+{
+    // fn foo(x: int, y), fn foo(x, y: int)
+    auto set = hk::make_om<hk::om_overload_set>();
+    auto const first = make_template({{int_type().get(), om_passing::copy}, {nullptr, om_passing::copy}});
+    auto const second = make_template({{nullptr, om_passing::copy}, {int_type().get(), om_passing::copy}});
+    set->add(second);
+    set->add(first);
+
+    // The longest start sequence of perfect matching arguments wins.
+    auto const int_argument = hk::om_argument{int_type().get(), om_value_category::value};
+    REQUIRE(set->resolve(make_call({int_argument, int_argument})).value() == first.get());
+
+    // The same signature twice is ambiguous.
+    set->add(make_template({{int_type().get(), om_passing::copy}, {nullptr, om_passing::copy}}));
+    REQUIRE(set->resolve(make_call({int_argument, int_argument})).error() == hk::hkc_error::ambiguous_overload);
+}
+
+TEST_CASE(return_type)
+{
+    auto set = hk::make_om<hk::om_overload_set>();
+    auto const returns_int = make_template({}, int_type().get());
+    auto const returns_float = make_template({}, float_type().get());
+    set->add(returns_int);
+    set->add(returns_float);
+
+    REQUIRE(set->resolve(make_call({}, int_type().get())).value() == returns_int.get());
+    REQUIRE(set->resolve(make_call({}, float_type().get())).value() == returns_float.get());
+    REQUIRE(set->resolve(make_call({})).error() == hk::hkc_error::ambiguous_overload);
+}
+
+TEST_CASE(invalidate)
+{
+    auto set = hk::make_om<hk::om_overload_set>();
+    auto const generic = make_template({{nullptr, om_passing::automatic}});
+    set->add(generic);
+
+    auto const call = make_call({{int_type().get(), om_value_category::value}});
+    REQUIRE(set->resolve(call).value() == generic.get());
+    REQUIRE(set->resolve(call).value() == generic.get());
+
+    // Adding a better matching template invalidates the cached result.
+    auto const typed = make_template({{int_type().get(), om_passing::copy}});
+    auto const version = set->version();
+    set->add(typed);
+    REQUIRE(set->version() != version);
+    REQUIRE(set->resolve(call).value() == typed.get());
+    REQUIRE(set->rank(call).value() == typed.get());
+}
+
+TEST_CASE(concurrent_resolve)
+{
+    constexpr auto num_threads = 4;
+
+    auto set = hk::make_om<hk::om_overload_set>();
+    auto const typed = make_template({{int_type().get(), om_passing::automatic}});
+    auto const generic = make_template({{nullptr, om_passing::automatic}});
+    set->add(generic);
+    set->add(typed);
+
+    auto num_errors = std::atomic<int>{0};
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t != num_threads; ++t) {
+        threads.emplace_back([&] {
+            for (auto i = 0; i != 1000; ++i) {
+                auto const type = i % 2 == 0 ? int_type().get() : float_type().get();
+                auto const expected = i % 2 == 0 ? typed.get() : generic.get();
+                if (set->resolve(make_call({{type, om_value_category::value}})) != expected) {
+                    ++num_errors;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(num_errors.load() == 0);
+}
+
+}; // TEST_SUITE(om_overload_set_suite)
@@ -0,0 +1,114 @@
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace hk {
+
+/** An intrusive reference counted pointer to an object of the object model.
+ *
+ * The reference count is stored in the object itself, see `om_object`, so
+ * that a pointer is a single word and no control block is allocated.
+ *
+ * @tparam T A type derived from `om_object`.
+ */
+template<typename T>
+class om_ptr {
+public:
+    using element_type = T;
+
+    ~om_ptr()
+    {
+        if (_ptr != nullptr) {
+            _ptr->release();
+        }
+    }
+
+    om_ptr(om_ptr const& other) noexcept : _ptr(other._ptr)
+    {
+        if (_ptr != nullptr) {
+            _ptr->retain();
+        }
+    }
+
+    om_ptr(om_ptr&& other) noexcept : _ptr(std::exchange(other._ptr, nullptr)) {}
+
+    om_ptr& operator=(om_ptr const& other) noexcept
+    {
+        return *this = om_ptr{other};
+    }
+
+    om_ptr& operator=(om_ptr&& other) noexcept
+    {
+        std::swap(_ptr, other._ptr);
+        return *this;
+    }
+
+    constexpr om_ptr() noexcept = default;
+    constexpr om_ptr(std::nullptr_t) noexcept {}
+
+    /** Take a reference to an object.
+     */
+    explicit om_ptr(T *ptr) noexcept : _ptr(ptr)
+    {
+        if (_ptr != nullptr) {
+            _ptr->retain();
+        }
+    }
+
+    template<typename U>
+        requires(std::is_convertible_v<U *, T *>)
+    om_ptr(om_ptr<U> other) noexcept : _ptr(other.detach()) {}
+
+    [[nodiscard]] T *get() const noexcept
+    {
+        return _ptr;
+    }
+
+    [[nodiscard]] T& operator*() const noexcept
+    {
+        return *_ptr;
+    }
+
+    [[nodiscard]] T *operator->() const noexcept
+    {
+        return _ptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _ptr != nullptr;
+    }
+
+    /** Release ownership without decrementing the reference count.
+     */
+    [[nodiscard]] T *detach() noexcept
+    {
+        return std::exchange(_ptr, nullptr);
+    }
+
+    [[nodiscard]] friend bool operator==(om_ptr const& lhs, om_ptr const& rhs) noexcept
+    {
+        return lhs._ptr == rhs._ptr;
+    }
+
+    [[nodiscard]] friend bool operator==(om_ptr const& lhs, std::nullptr_t) noexcept
+    {
+        return lhs._ptr == nullptr;
+    }
+
+private:
+    T *_ptr = nullptr;
+};
+
+/** Allocate an object of the object model.
+ */
+template<typename T, typename... Args>
+[[nodiscard]] om_ptr<T> make_om(Args&&... args)
+{
+    return om_ptr<T>{new T(std::forward<Args>(args)...)};
+}
+
+}
@@ -0,0 +1,137 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace hk {
+
+class om_object;
+
+/** The value category of an argument expression.
+ *
+ * See "Overload resolution" in doc/tutorial/Values_and_References.md.
+ */
+enum class om_value_category : std::uint8_t {
+    /** `x : T`, `*x`
+     */
+    value,
+
+    /** `x : &T`, `&x`, and `x : &&T` which is treated as a reference.
+     */
+    reference,
+
+    /** `x : &const T`, `&const x`
+     */
+    const_reference,
+
+    /** `&&x`, or a temporary.
+     */
+    movable,
+};
+
+/** How an argument is passed to a parameter.
+ */
+enum class om_passing : std::uint8_t {
+    /** `<-`, the default.
+     */
+    automatic,
+
+    /** `<- *`
+     */
+    copy,
+
+    /** `<- &`
+     */
+    reference,
+
+    /** `<- &const`
+     */
+    const_reference,
+
+    /** `<- &&`
+     */
+    movable,
+};
+
+/** The cost of passing an argument to a parameter.
+ *
+ * @retval 0 The exact passing for the value category.
+ * @retval 1.. The position in the priority list of the value category.
+ * @retval -1 The argument can not be passed this way.
+ */
+[[nodiscard]] constexpr int passing_cost(om_value_category category, om_passing passing) noexcept
+{
+    // automatic, copy, reference, const_reference, movable
+    constexpr int table[4][5] = {
+        {1, 0, 3, 2, -1}, // value
+        {1, 3, 0, 2, -1}, // reference
+        {1, 2, -1, 0, -1}, // const_reference
+        {1, 4, 3, 2, 0}, // movable
+    };
+    return table[std::to_underlying(category)][std::to_underlying(passing)];
+}
+
+/** An argument of a call-site.
+ */
+struct om_argument {
+    /** The type of the argument, or the value of a non-type argument.
+     *
+     * Types and values are interned objects, so they are compared by address.
+     */
+    om_object const *type = nullptr;
+
+    om_value_category category = om_value_category::value;
+
+    [[nodiscard]] constexpr friend bool operator==(om_argument const&, om_argument const&) noexcept = default;
+};
+
+/** A parameter of a template.
+ */
+struct om_parameter {
+    /** The type of the parameter, or the value of a non-type parameter.
+     *
+     * @retval nullptr The parameter accepts any type.
+     */
+    om_object const *type = nullptr;
+
+    om_passing passing = om_passing::automatic;
+
+    [[nodiscard]] constexpr friend bool operator==(om_parameter const&, om_parameter const&) noexcept = default;
+};
+
+/** The signature of a call-site, used to select a template from an overload set.
+ */
+struct om_call_signature {
+    std::vector<om_argument> arguments = {};
+
+    /** The type that the call-site expects the call to return.
+     *
+     * @retval nullptr Any return type.
+     */
+    om_object const *return_type = nullptr;
+
+    [[nodiscard]] friend bool operator==(om_call_signature const&, om_call_signature const&) noexcept = default;
+};
+
+}
+
+template<>
+struct std::hash<hk::om_call_signature> {
+    [[nodiscard]] std::size_t operator()(hk::om_call_signature const& x) const noexcept
+    {
+        auto const mix = [](std::uint64_t h, std::uint64_t v) {
+            return (h ^ v) * 0x9e37'79b9'7f4a'7c15;
+        };
+
+        auto h = mix(0, reinterpret_cast<std::uintptr_t>(x.return_type));
+        for (auto const& argument : x.arguments) {
+            h = mix(h, reinterpret_cast<std::uintptr_t>(argument.type));
+            h = mix(h, static_cast<std::uint64_t>(argument.category));
+        }
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
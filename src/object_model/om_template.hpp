@@ -2,14 +2,41 @@
 #pragma once
 
 #include "om_object.hpp"
+#include "om_signature.hpp"
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace hk {
 
 class om_template : public om_object {
 public:
+    om_template() = default;
+
+    /** Create a template with a signature.
+     *
+     * @param parameters The parameters of the template.
+     * @param return_type The declared return type, nullptr when it is deduced.
+     */
+    explicit om_template(std::vector<om_parameter> parameters, om_object const *return_type = nullptr) :
+        _parameters(std::move(parameters)), _return_type(return_type)
+    {
+    }
+
+    [[nodiscard]] std::span<om_parameter const> parameters() const noexcept
+    {
+        return _parameters;
+    }
+
+    [[nodiscard]] om_object const *return_type() const noexcept
+    {
+        return _return_type;
+    }
 
 private:
+    std::vector<om_parameter> _parameters = {};
+    om_object const *_return_type = nullptr;
 };
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,61 @@
+
+#pragma once
+
+#include "om_object.hpp"
+#include "utility/interned_string.hpp"
+#include "values/long_int.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <variant>
+
+namespace hk {
+
+/** An argument of a template instantiation.
+ *
+ * An argument is a type, or the value of a non-type argument: an integer,
+ * like the bounds of `int[a..=b]`, or a name, like the encoding of
+ * `string[encoding]`. Types are interned objects and compared by address;
+ * values are compared structurally.
+ */
+class om_template_argument {
+public:
+    using value_type = std::variant<om_object const *, builtin::long_int, interned_string>;
+
+    om_template_argument(om_object const *type) noexcept : _value(type) {}
+    om_template_argument(builtin::long_int value) noexcept : _value(std::move(value)) {}
+    om_template_argument(interned_string value) noexcept : _value(value) {}
+
+    [[nodiscard]] value_type const& value() const noexcept
+    {
+        return _value;
+    }
+
+    /** The structural hash of the argument.
+     */
+    [[nodiscard]] std::size_t hash() const noexcept
+    {
+        auto const h = std::visit(
+            []<typename T>(T const& x) {
+                return std::hash<T>{}(x);
+            },
+            _value);
+        return h ^ _value.index();
+    }
+
+    [[nodiscard]] friend bool operator==(om_template_argument const&, om_template_argument const&) noexcept = default;
+
+private:
+    value_type _value;
+};
+
+}
+
+template<>
+struct std::hash<hk::om_template_argument> {
+    [[nodiscard]] std::size_t operator()(hk::om_template_argument const& x) const noexcept
+    {
+        return x.hash();
+    }
+};
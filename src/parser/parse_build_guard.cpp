@@ -1,7 +1,7 @@
 
 #include "parse_build_guard.hpp"
 #include "parse_build_guard_expression.hpp"
-#include "parse_build_guard_primary.hpp"
+#include "ast/build_guard_cache.hpp"
 
 namespace hk {
 
@@ -15,17 +15,13 @@ namespace hk {
     }
     ++it;
 
-    if (auto node = parse_build_guard_primary(it, ctx)) {
-        if (auto top_node = parse_build_guard_expression(it, ctx, std::move(node).value(), 0)) {
-            return std::move(top_node).value();
-        } else if (to_bool(node.error())) {
-            return std::unexpected(node.error());
-        } else {
-            std::unreachable();
-        }
-
-    } else if (to_bool(node.error())) {
-        return std::unexpected(node.error());
+    if (auto optional_expr = parse_build_guard_expression(it, ctx)) {
+        auto expr = std::move(optional_expr).value();
+        expr->program_index = ast::global_build_guard_cache.add(*expr);
+        return expr;
+
+    } else if (to_bool(optional_expr.error())) {
+        return std::unexpected{optional_expr.error()};
     } else {
         return ctx.add(it->begin(), hkc_error::missing_expression);
     }
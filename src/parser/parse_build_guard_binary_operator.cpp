@@ -1,44 +1,106 @@
 
 #include "parse_build_guard_binary_operator.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 
 namespace hk {
 
-[[nodiscard]] parse_result_ptr<ast::build_guard_binary_operator_node>
-parse_build_guard_binary_operator(token_iterator& it, parse_context& ctx)
+/** Get the id of the spelling of an identifier or operator.
+ *
+ * The id is the spelling packed into an integer, so that operators are found
+ * by comparing integers instead of strings.
+ *
+ * @return The id, or zero if the spelling is longer than four characters.
+ */
+[[nodiscard]] constexpr static uint32_t spelling_id(std::string_view str) noexcept
+{
+    if (str.size() > 4) {
+        return 0;
+    }
+
+    auto r = uint32_t{0};
+    for (auto const c : str) {
+        r = (r << 8) | static_cast<uint8_t>(c);
+    }
+    return r;
+}
+
+[[nodiscard]] constexpr static uint32_t token_id(token const& t) noexcept
+{
+    if (t != token::identifier and t != token::_operator) {
+        return 0;
+    }
+    return spelling_id(t.string_view());
+}
+
+struct binary_operator_entry {
+    uint32_t id;
+    ast::build_guard_binary_operator_node::op_type op;
+};
+
+/** The binary operators sorted by the id of their first token.
+ *
+ * `not` is the first token of `not in`.
+ */
+constexpr static auto binary_operator_table = [] {
+    using enum ast::build_guard_binary_operator_node::op_type;
+
+    auto r = std::array{
+        binary_operator_entry{spelling_id("and"), _and},
+        binary_operator_entry{spelling_id("or"), _or},
+        binary_operator_entry{spelling_id("in"), in},
+        binary_operator_entry{spelling_id("not"), not_in},
+        binary_operator_entry{spelling_id("=="), eq},
+        binary_operator_entry{spelling_id("!="), ne},
+        binary_operator_entry{spelling_id("<"), lt},
+        binary_operator_entry{spelling_id(">"), gt},
+        binary_operator_entry{spelling_id("<="), le},
+        binary_operator_entry{spelling_id(">="), ge},
+    };
+    std::ranges::sort(r, {}, &binary_operator_entry::id);
+    return r;
+}();
+
+[[nodiscard]] std::optional<std::pair<ast::build_guard_binary_operator_node::op_type, size_t>>
+find_build_guard_binary_operator(token_iterator const& it)
 {
     using enum ast::build_guard_binary_operator_node::op_type;
 
+    auto const id = token_id(it[0]);
+    if (id == 0) {
+        return std::nullopt;
+    }
+
+    auto const entry = std::ranges::lower_bound(binary_operator_table, id, {}, &binary_operator_entry::id);
+    if (entry == binary_operator_table.end() or entry->id != id) {
+        return std::nullopt;
+    }
+
+    if (entry->op == not_in) {
+        if (token_id(it[1]) != spelling_id("in")) {
+            return std::nullopt;
+        }
+        return std::pair{not_in, 2uz};
+    }
+
+    return std::pair{entry->op, 1uz};
+}
+
+[[nodiscard]] parse_result_ptr<ast::build_guard_binary_operator_node>
+parse_build_guard_binary_operator(token_iterator& it, parse_context& ctx)
+{
     auto const first = it->begin();
-    auto last = it->end();
-    auto kind = _and;
-
-    if (it[0] == "and") {
-        kind = _and;
-    } else if (it[0] == "or") {
-        kind = _or;
-    } else if (it[0] == "in") {
-        kind = in;
-    } else if (it[0] == "not" and it[1] == "in") {
-        kind = not_in;
-        ++it;
-    } else if (it[0] == "==") {
-        kind = eq;
-    } else if (it[0] == "!=") {
-        kind = ne;
-    } else if (it[0] == "<") {
-        kind = lt;
-    } else if (it[0] == ">") {
-        kind = gt;
-    } else if (it[0] == "<=") {
-        kind = le;
-    } else if (it[0] == ">=") {
-        kind = ge;
-    } else {
+    auto const last = it->end();
+
+    auto const found = find_build_guard_binary_operator(it);
+    if (not found) {
         return tokens_did_not_match;
     }
 
-    ++it;
+    auto const [kind, num_tokens] = *found;
+    it += static_cast<ptrdiff_t>(num_tokens);
     return std::make_unique<ast::build_guard_binary_operator_node>(first, last, kind);
 }
 
-} // namespace hk
\ No newline at end of file
+} // namespace hk
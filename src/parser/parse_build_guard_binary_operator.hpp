@@ -5,9 +5,18 @@
 #include "parse_context.hpp"
 #include "ast/build_guard_binary_operator_node.hpp"
 #include "tokenizer/token_vector.hpp"
+#include <optional>
 
 namespace hk {
 
+/** Find the binary operator at the iterator, without consuming tokens.
+ *
+ * @param it The iterator to the first token of the operator.
+ * @return The operator and the number of tokens it is made of, or std::nullopt.
+ */
+[[nodiscard]] std::optional<std::pair<ast::build_guard_binary_operator_node::op_type, size_t>>
+find_build_guard_binary_operator(token_iterator const& it);
+
 [[nodiscard]] parse_result_ptr<ast::build_guard_binary_operator_node>
 parse_build_guard_binary_operator(token_iterator& it, parse_context& ctx);
 
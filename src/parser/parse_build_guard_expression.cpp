@@ -8,60 +8,49 @@ namespace hk {
 [[nodiscard]] parse_result_ptr<ast::build_guard_expression_node> parse_build_guard_expression(
     token_iterator& it,
     parse_context& ctx,
-    std::unique_ptr<ast::build_guard_expression_node> lhs,
-    size_t min_precedence)
+    size_t max_precedence)
 {
+    using ast::build_guard_binary_operator_node;
+
     auto const first = it->begin();
 
-    auto lookahead_it = it;
-    auto lookahead = parse_build_guard_binary_operator(lookahead_it, ctx);
-    while (lookahead and (*lookahead)->precedence() >= min_precedence) {
-        auto op = std::move(lookahead).value();
-        it = lookahead_it;
+    auto lhs = std::unique_ptr<ast::build_guard_expression_node>{};
+    if (auto optional_lhs = parse_build_guard_primary(it, ctx)) {
+        lhs = std::move(optional_lhs).value();
+    } else {
+        return std::unexpected{optional_lhs.error()};
+    }
 
-        auto rhs = std::unique_ptr<ast::build_guard_expression_node>{};
-        if (auto optional_rhs = parse_build_guard_primary(it, ctx)) {
-            rhs = std::move(optional_rhs).value();
-        } else if (to_bool(optional_rhs.error())) {
-            return std::unexpected{optional_rhs.error()};
-        } else {
-            return ctx.add(first, it->begin(), hkc_error::missing_rhs_of_binary_operator);
+    while (auto const found = find_build_guard_binary_operator(it)) {
+        auto const precedence = build_guard_binary_operator_node::precedence(found->first);
+        if (precedence >= max_precedence) {
+            break;
         }
 
-        lookahead_it = it;
-        lookahead = parse_build_guard_binary_operator(lookahead_it, ctx);
-        while (lookahead and
-               ((*lookahead)->precedence() > op->precedence() or
-                ((*lookahead)->left_to_right() and (*lookahead)->precedence() == op->precedence()))) {
-            auto const new_precedence = [&] {
-                if ((*lookahead)->precedence() > op->precedence()) {
-                    return op->precedence() + 1;
-                } else {
-                    return op->precedence();
-                }
-            }();
+        auto op = std::unique_ptr<build_guard_binary_operator_node>{};
+        if (auto optional_op = parse_build_guard_binary_operator(it, ctx)) {
+            op = std::move(optional_op).value();
+        } else {
+            std::unreachable();
+        }
 
-            if (auto optional_rhs = parse_build_guard_expression(it, ctx, std::move(rhs), new_precedence)) {
-                rhs = std::move(optional_rhs).value();
-            } else if (to_bool(optional_rhs.error())) {
-                return std::unexpected{optional_rhs.error()};
-            } else {
-                std::unreachable();
-            }
+        // A left-to-right operator stops the right hand side at operators
+        // with the same precedence, so that they become the new root.
+        auto const rhs_max_precedence =
+            build_guard_binary_operator_node::left_to_right(op->op) ? precedence : precedence + 1;
 
-            lookahead_it = it;
-            lookahead = parse_build_guard_binary_operator(lookahead_it, ctx);
+        if (auto optional_rhs = parse_build_guard_expression(it, ctx, rhs_max_precedence)) {
+            op->rhs = std::move(optional_rhs).value();
+        } else if (to_bool(optional_rhs.error())) {
+            return std::unexpected{optional_rhs.error()};
+        } else {
+            return ctx.add(first, it->begin(), hkc_error::missing_rhs_of_binary_operator);
         }
 
         op->lhs = std::move(lhs);
-        op->rhs = std::move(rhs);
         lhs = std::move(op);
     }
 
-    if (to_bool(lookahead.error())) {
-        return std::unexpected{lookahead.error()};
-    }
-
     return lhs;
 }
 
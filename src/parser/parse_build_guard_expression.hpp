@@ -5,13 +5,24 @@
 #include "parse_context.hpp"
 #include "ast/build_guard_expression_node.hpp"
 #include "tokenizer/token_vector.hpp"
+#include <limits>
 
 namespace hk {
 
+/** Parse a build-guard expression.
+ *
+ * This is a precedence climbing (Pratt) parser: after parsing a primary
+ * expression it keeps consuming binary operators that bind tighter than
+ * @a max_precedence.
+ *
+ * @param it The iterator to the first token of the expression.
+ * @param ctx The parse context.
+ * @param max_precedence Stop at operators with a precedence equal or larger than this.
+ * @return The expression, or tokens_did_not_match if there is no primary expression.
+ */
 [[nodiscard]] parse_result_ptr<ast::build_guard_expression_node> parse_build_guard_expression(
     token_iterator& it,
     parse_context& ctx,
-    std::unique_ptr<ast::build_guard_expression_node> lhs,
-    size_t min_precedence);
+    size_t max_precedence = std::numeric_limits<size_t>::max());
 
-}
\ No newline at end of file
+}
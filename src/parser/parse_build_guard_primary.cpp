@@ -13,25 +13,22 @@ namespace hk {
 {
     auto const first = it->begin();
 
-    if (auto optional_name = parse_absolute_fqname(it, ctx)) {
-        return std::make_unique<ast::build_guard_variable_node>(first, it->begin(), std::move(optional_name).value());
-    } else if (to_bool(optional_name.error())) {
-        return std::unexpected{optional_name.error()};
-    }
-
     if (*it == token::integer_literal) {
+        auto value = it->integer_value();
         ++it;
-        return std::make_unique<ast::build_guard_literal_node>(first, it->begin(), it->integer_value());
+        return std::make_unique<ast::build_guard_literal_node>(first, it->begin(), std::move(value));
     }
 
     if (*it == token::version_literal) {
+        auto value = it->version_value();
         ++it;
-        return std::make_unique<ast::build_guard_literal_node>(first, it->begin(), it->version_value());
+        return std::make_unique<ast::build_guard_literal_node>(first, it->begin(), std::move(value));
     }
 
     if (*it == token::string_literal) {
+        auto value = it->raw_string_value();
         ++it;
-        return std::make_unique<ast::build_guard_literal_node>(first, it->begin(), it->raw_string_value());
+        return std::make_unique<ast::build_guard_literal_node>(first, it->begin(), std::move(value));
     }
 
     if (*it == "true") {
@@ -45,47 +42,42 @@ namespace hk {
     }
 
     if (*it == "not") {
+        using ast::build_guard_unary_operator_node;
         ++it;
 
-        if (auto optional_primary = parse_build_guard_primary(it, ctx)) {
-            if (auto optional_expr = parse_build_guard_expression(it, ctx, std::move(optional_primary).value(), 0)) {
-                auto op = std::make_unique<ast::build_guard_unary_operator_node>(first, it->begin(), ast::build_guard_unary_operator_node::op_type::_not);
-                op->rhs = std::move(optional_expr).value();
-                return op;
-
-            } else if (to_bool(optional_expr.error())) {
-                return std::unexpected{optional_expr.error()};
-            } else {
-                std::unreachable();
-            }
+        auto const precedence = build_guard_unary_operator_node::precedence(build_guard_unary_operator_node::op_type::_not);
+        if (auto optional_expr = parse_build_guard_expression(it, ctx, precedence)) {
+            auto op = std::make_unique<build_guard_unary_operator_node>(first, it->begin(), build_guard_unary_operator_node::op_type::_not);
+            op->rhs = std::move(optional_expr).value();
+            return op;
 
-        } else if (to_bool(optional_primary.error())) {
-            return std::unexpected{optional_primary.error()};
+        } else if (to_bool(optional_expr.error())) {
+            return std::unexpected{optional_expr.error()};
         } else {
             return ctx.add(first, it->begin(), hkc_error::missing_expression);
         }
     }
 
+    // After the keywords, which would otherwise be parsed as names.
+    if (auto optional_name = parse_absolute_fqname(it, ctx)) {
+        return std::make_unique<ast::build_guard_variable_node>(first, it->begin(), std::move(optional_name).value());
+    } else if (to_bool(optional_name.error())) {
+        return std::unexpected{optional_name.error()};
+    }
+
     if (*it == '(') {
         ++it;
 
-        if (auto optional_primary = parse_build_guard_primary(it, ctx)) {
-            if (auto optional_expr = parse_build_guard_expression(it, ctx, std::move(optional_primary).value(), 0)) {
-                if (*it != ')') {
-                    return ctx.add(first, it->begin(), hkc_error::missing_closing_parenthesis);
-                }
-                ++it;
-
-                return std::move(optional_expr).value();
-
-            } else if (to_bool(optional_expr.error())) {
-                return std::unexpected{optional_expr.error()};
-            } else {
-                std::unreachable();
+        if (auto optional_expr = parse_build_guard_expression(it, ctx)) {
+            if (*it != ')') {
+                return ctx.add(first, it->begin(), hkc_error::missing_closing_parenthesis);
             }
+            ++it;
+
+            return std::move(optional_expr).value();
 
-        } else if (to_bool(optional_primary.error())) {
-            return std::unexpected{optional_primary.error()};
+        } else if (to_bool(optional_expr.error())) {
+            return std::unexpected{optional_expr.error()};
         } else {
             return ctx.add(first, it->begin(), hkc_error::missing_expression);
         }
@@ -0,0 +1,104 @@
+
+#include "parse_build_guard.hpp"
+#include "ast/build_guard_binary_operator_node.hpp"
+#include "ast/build_guard_unary_operator_node.hpp"
+#include "tokenizer/tokenizer.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+
+TEST_SUITE(parse_build_guard_suite)
+{
+
+/** Parse a build-guard and evaluate its expression tree.
+ */
+static std::expected<hk::datum, hk::hkc_error> evaluate(std::string text, hk::datum_namespace const& ns)
+{
+    // The tokenizer reads ahead, like source files the text is padded with nul-bytes.
+    text.append(8, '\0');
+
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<text>");
+    auto token_generator = hk::tokenize(text.data(), lines);
+    auto tokens = hk::lazy_vector{token_generator.cbegin(), token_generator.cend()};
+    auto it = tokens.cbegin();
+
+    auto ctx = hk::parse_context{lines};
+    auto optional_expr = hk::parse_build_guard(it, ctx);
+    if (not optional_expr) {
+        return std::unexpected{optional_expr.error()};
+    }
+    return (*optional_expr)->evaluate_expression(ns);
+}
+
+TEST_CASE(comparison_binds_tighter_than_and)
+{
+    auto ns = hk::datum_namespace{};
+    ns.set(hk::fqname{".a"}, hk::datum{1LL});
+    ns.set(hk::fqname{".b"}, hk::datum{2LL});
+
+    REQUIRE(evaluate("if a == 1 and b == 2", ns) == hk::datum{true});
+    REQUIRE(evaluate("if a == 1 and b == 3", ns) == hk::datum{false});
+    REQUIRE(evaluate("if a < b == true", ns) == hk::datum{true});
+}
+
+TEST_CASE(and_binds_tighter_than_or)
+{
+    auto ns = hk::datum_namespace{};
+
+    REQUIRE(evaluate("if true or false and false", ns) == hk::datum{true});
+    REQUIRE(evaluate("if false and false or true", ns) == hk::datum{true});
+    REQUIRE(evaluate("if (true or false) and false", ns) == hk::datum{false});
+}
+
+TEST_CASE(not_binds_tightest)
+{
+    auto ns = hk::datum_namespace{};
+
+    REQUIRE(evaluate("if not false and false", ns) == hk::datum{false});
+    REQUIRE(evaluate("if not (false and false)", ns) == hk::datum{true});
+    REQUIRE(evaluate("if not not true", ns) == hk::datum{true});
+}
+
+TEST_CASE(not_in)
+{
+    auto text = std::string{"if a not in b and c"};
+    text.append(8, '\0');
+
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<text>");
+    auto token_generator = hk::tokenize(text.data(), lines);
+    auto tokens = hk::lazy_vector{token_generator.cbegin(), token_generator.cend()};
+    auto it = tokens.cbegin();
+
+    auto ctx = hk::parse_context{lines};
+    auto const optional_expr = hk::parse_build_guard(it, ctx);
+    REQUIRE(optional_expr.has_value());
+
+    using hk::ast::build_guard_binary_operator_node;
+    auto const and_ = dynamic_cast<build_guard_binary_operator_node const*>(optional_expr->get());
+    REQUIRE(and_ != nullptr);
+    REQUIRE(and_->op == build_guard_binary_operator_node::op_type::_and);
+
+    auto const not_in = dynamic_cast<build_guard_binary_operator_node const*>(and_->lhs.get());
+    REQUIRE(not_in != nullptr);
+    REQUIRE(not_in->op == build_guard_binary_operator_node::op_type::not_in);
+}
+
+TEST_CASE(literals)
+{
+    auto ns = hk::datum_namespace{};
+
+    REQUIRE(evaluate("if 42", ns) == hk::datum{42LL});
+    REQUIRE(evaluate("if \"foo\"", ns) == hk::datum{std::string{"foo"}});
+}
+
+TEST_CASE(missing_rhs)
+{
+    auto ns = hk::datum_namespace{};
+
+    REQUIRE(evaluate("if true and", ns) == std::unexpected{hk::hkc_error::missing_rhs_of_binary_operator});
+    REQUIRE(evaluate("if (true", ns) == std::unexpected{hk::hkc_error::missing_closing_parenthesis});
+    REQUIRE(evaluate("if", ns) == std::unexpected{hk::hkc_error::missing_expression});
+}
+
+};
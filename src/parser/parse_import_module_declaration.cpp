@@ -19,7 +19,6 @@ namespace hk {
 
     if (auto name = parse_relative_fqname(it, ctx)) {
         r->name = std::move(name).value();
-        ++it;
     } else if (not name.error()) {
         return ctx.add(first, it->end(), hkc_error::missing_module_name);
     } else {
@@ -30,7 +29,6 @@ namespace hk {
         ++it;
         if (auto as = parse_relative_fqname(it, ctx)) {
             r->as = std::move(as).value();
-            ++it;
         } else if (to_bool(as.error())) {
             return std::unexpected{as.error()};
         } else {
@@ -9,7 +9,7 @@ namespace hk {
 {
     auto const first = it->begin();
 
-    if (it[0] != "import" and (it[1] == "git" or it[1] == "zip") and it[2] == token::string_literal) {
+    if (it[0] != "import" or (it[1] != "git" and it[1] != "zip")) {
         return tokens_did_not_match;
     }
 
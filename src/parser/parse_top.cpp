@@ -7,6 +7,7 @@
 #include "parse_program_declaration.hpp"
 #include "parse_library_declaration.hpp"
 #include "consume.hpp"
+#include "utility/trace.hpp"
 #include "ast/module_node.hpp"
 #include "ast/program_node.hpp"
 #include "ast/library_node.hpp"
@@ -82,6 +83,8 @@ namespace hk {
 
 [[nodiscard]] parse_result_ptr<ast::top_node> parse_top(char const *p, parse_context &ctx, bool only_prologue)
 {
+    auto const trace = trace_scope{"parse_top"};
+
     auto token_generator = hk::tokenize(p, ctx.lines());
     auto lazy_tokens = lazy_vector{token_generator.cbegin(), token_generator.cend()};
 
@@ -0,0 +1,102 @@
+
+#include "parse_top.hpp"
+#include "tokenizer/tokenizer.hpp"
+#include "tokenizer/validate_utf8.hpp"
+#include "bench_utilities/corpus.hpp"
+#include <benchmark/benchmark.h>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/** A generated module; the arguments are the number of imports and the number of declarations.
+ */
+[[nodiscard]] std::string make_text(benchmark::State const& state)
+{
+    auto options = bench::corpus_options{};
+    options.num_imports = static_cast<std::size_t>(state.range(0));
+    options.num_declarations = static_cast<std::size_t>(state.range(1));
+    return bench::pad_source_code(bench::generate_module("bench.parser", options));
+}
+
+[[nodiscard]] hk::parse_context make_context(std::string const& text)
+{
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<bench>");
+    lines.set_ascii(hk::validate_utf8(text.data(), text.data() + text.size()).ascii);
+    return hk::parse_context{std::move(lines)};
+}
+
+/** Check that the generated module parses without errors.
+ */
+void check_text(std::string const& text)
+{
+    auto ctx = make_context(text);
+    if (not hk::parse_top(text.data(), ctx, true) or not ctx.errors().empty()) {
+        throw std::runtime_error("Could not parse the prologue of the generated module");
+    }
+}
+
+void bm_parse_top_prologue(benchmark::State& state)
+{
+    auto const text = make_text(state);
+    check_text(text);
+
+    for (auto _ : state) {
+        auto ctx = make_context(text);
+        auto top = hk::parse_top(text.data(), ctx, true);
+        benchmark::DoNotOptimize(top);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+/** Parse the whole module.
+ *
+ * The body of a module is not parsed into an AST yet, so this parses the
+ * prologue and tokenizes the rest of the module.
+ */
+void bm_parse_top_full(benchmark::State& state)
+{
+    auto const text = make_text(state);
+    check_text(text);
+
+    for (auto _ : state) {
+        auto ctx = make_context(text);
+        auto token_generator = hk::tokenize(text.data(), ctx.lines());
+        auto tokens = hk::token_vector{token_generator.cbegin(), token_generator.cend()};
+
+        auto it = tokens.cbegin();
+        auto top = hk::parse_top(it, ctx, false);
+        benchmark::DoNotOptimize(top);
+        while (it != std::default_sentinel) {
+            ++it;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+void bm_parse_top_source_tree(benchmark::State& state)
+{
+    auto const& corpus = bench::source_tree_corpus();
+
+    auto num_bytes = int64_t{0};
+    for (auto _ : state) {
+        for (auto const& file : corpus) {
+            auto ctx = make_context(file.text);
+            auto top = hk::parse_top(file.text.data(), ctx, true);
+            benchmark::DoNotOptimize(top);
+            num_bytes += static_cast<int64_t>(file.text.size());
+        }
+    }
+
+    state.SetBytesProcessed(num_bytes);
+}
+
+} // namespace
+
+BENCHMARK(bm_parse_top_prologue)->ArgsProduct({{4, 64}, {16, 1024}});
+BENCHMARK(bm_parse_top_full)->ArgsProduct({{4, 64}, {16, 1024}});
+BENCHMARK(bm_parse_top_source_tree);
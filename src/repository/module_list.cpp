@@ -1,6 +1,8 @@
 
 #include "module_list.hpp"
 #include "repository.hpp"
+#include "utility/trace.hpp"
+#include <algorithm>
 #include <compare>
 #include <unordered_set>
 
@@ -18,7 +20,7 @@ void module_list::clear()
 
 void module_list::add(hk::source& source)
 {
-    if (to_bool(source.enabled())) {
+    if (to_bool(source.enabled(_configuration))) {
         _sources.push_back(std::addressof(source));
 
 #ifndef _NDEBUG
@@ -54,35 +56,58 @@ void module_list::add(hk::source& source)
 
 void module_list::deduplicate()
 {
+    auto const trace = trace_scope{"module_list::deduplicate"};
+
+    // A source without a name has an error in its prologue.
+    std::erase_if(_sources, [](auto const& item) {
+        return item->kind() == source::kind_type::unknown;
+    });
+
     // cmp_names will sort on:
-    //  * kind: program, library, module
+    //  * kind: module, program, library
     //  * module name declared in the prologue
     //  * repository path
     std::sort(_sources.begin(), _sources.end(), [](auto const& a, auto const& b) {
         return cmp_names(*a, *b) == std::strong_ordering::less;
     });
 
+    // Remove a fallback source if another source of the same name is
+    // enabled by its build-guard. If there are two fallbacks, then they
+    // remain and cause a duplicate_module error.
+    for (auto first = _sources.begin(); first != _sources.end();) {
+        auto last = std::find_if(first + 1, _sources.end(), [&](auto const& item) {
+            return cmp_names(**first, *item) != std::strong_ordering::equal;
+        });
+
+        auto const is_guarded = [&](auto const& item) {
+            return item->enabled(_configuration) == logic::T;
+        };
+        auto const is_fallback = [&](auto const& item) {
+            return item->enabled(_configuration) == logic::_;
+        };
+
+        if (std::any_of(first, last, is_guarded)) {
+            last = _sources.erase(std::remove_if(first, last, is_fallback), last);
+        }
+        first = last;
+    }
+
     auto anchor_stack = std::vector<source*>{};
 
     for (auto it = _sources.begin(); it != _sources.end(); ++it) {
         if (it != _sources.begin() and cmp_names(**(it - 1), **it) == std::strong_ordering::equal) {
-            // Remove a fallback source if another source of the same name
-            // exists. If there are two fallbacks, then they may remain and
-            // cause a duplicate_module error.
-            if ((*(it - 1))->enabled() == logic::_ and (*it)->enabled() == logic::T) {
-                it = _sources.erase(it - 1);
-            } else if ((*(it - 1))->enabled() == logic::T and (*it)->enabled() == logic::_) {
-                it = _sources.erase(it) - 1;
-            }
-            
             // Two modules with the same name in the same repository.
-            anchor_stack.back()->file_declaration().add(hkc_error::duplicate_module);
+            (*(it - 1))->file_declaration().add(hkc_error::duplicate_module);
             (*it)->file_declaration().add(hkc_error::duplicate_module);
 
             // Keep only one of the duplicate anchors.
             // Adjust for the post-loop increment.
             it = _sources.erase(it) - 1;
 
+        } else if ((*it)->kind() != source::kind_type::module) {
+            // Programs and libraries do not belong to an anchor.
+            continue;
+
         } else if ((*it)->version()) {
             // This is an anchor module.
             if (not anchor_stack.empty() and anchor_stack.back()->module_name() == (*it)->module_name()) {
@@ -135,7 +160,7 @@ void module_list::mark_used(std::vector<source*> todo)
 {
     // Clear the used flag on all sources.
     for (auto source : _sources) {
-        source->set_used(false);
+        source->set_used(_configuration, false);
     }
 
     auto done = std::unordered_set<source*>{};
@@ -145,7 +170,7 @@ void module_list::mark_used(std::vector<source*> todo)
         todo.pop_back();
         done.insert(source);
 
-        source->set_used(true);
+        source->set_used(_configuration, true);
 
         for (auto import_declaration : source->imported_modules()) {
             if (auto imported_module_ptr = find(import_declaration->name)) {
@@ -3,20 +3,45 @@
 
 #include "source.hpp"
 #include <vector>
+#include <cassert>
 
 namespace hk {
 
 /** The list of modules in the project.
  * 
  * This holds the list of all module files.
+ *
+ * Each list belongs to a single build configuration, so that the sources
+ * that are parsed once can be planned for several configurations.
  */
 class module_list {
 public:
+    /** Create a module list for a configuration.
+     *
+     * @param configuration The index of the configuration.
+     */
+    explicit module_list(size_t configuration = 0) : _configuration(configuration)
+    {
+        assert(configuration < max_num_configurations);
+    }
+
+    [[nodiscard]] size_t configuration() const noexcept
+    {
+        return _configuration;
+    }
+
+    /** The number of sources in the list.
+     */
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _sources.size();
+    }
+
     void clear();
 
     /** Add a source to the module-list.
      *
-     * @note Filters away disabled or non-module sources.
+     * @note Filters away sources that are disabled in the configuration.
      * @param source The source to add.
      */
     void add(hk::source& source);
@@ -43,11 +68,14 @@ public:
 
     /** Mark all the modules that are used in this project.
      * 
+     * @pre The build-guards were last evaluated with the namespace of this
+     *      configuration, so that the import declarations are enabled for it.
      * @param todo A list of sources that must be compiled.
      */
     void mark_used(std::vector<source *> todo);
 
 private:
+    size_t _configuration = 0;
     std::vector<source *> _sources;
 
 #ifndef _NDEBUG
@@ -0,0 +1,53 @@
+
+#include "module_list.hpp"
+#include "repository.hpp"
+#include "bench_utilities/corpus.hpp"
+#include "utility/datum_namespace.hpp"
+#include "utility/path.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+/** Deduplicate the modules of a repository.
+ *
+ * The repository has `state.range(0)` sub-modules of one anchor, and a
+ * quarter of them, and the anchor, have a duplicate with a build-guard, which
+ * replaces the fallback.
+ */
+void bm_module_list_deduplicate(benchmark::State& state)
+{
+    auto const num_modules = static_cast<std::size_t>(state.range(0));
+
+    auto const directory = hk::scoped_temporary_directory{"hkbench"};
+    auto options = bench::corpus_options{};
+    options.num_declarations = 1;
+    options.num_imports = 2;
+    bench::write_corpus(directory.path() / "base", num_modules, options);
+    options.build_guard = "target.os == \"linux\"";
+    bench::write_corpus(directory.path() / "linux", num_modules / 4, options);
+
+    auto guard_namespace = hk::datum_namespace{};
+    guard_namespace.set(hk::fqname{".target.os"}, std::string{"linux"});
+    guard_namespace.set(hk::fqname{".target.cpu"}, std::string{"x86_64"});
+    guard_namespace.set(hk::fqname{".debug"}, false);
+
+    auto repository = hk::repository{std::filesystem::canonical(directory.path())};
+    auto modules = hk::module_list{};
+    repository.scan_prologues(guard_namespace, modules);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto tmp = modules;
+        state.ResumeTiming();
+
+        tmp.deduplicate();
+        benchmark::DoNotOptimize(tmp);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(modules.size()));
+}
+
+} // namespace
+
+BENCHMARK(bm_module_list_deduplicate)->Arg(64)->Arg(1024)->Arg(8192);
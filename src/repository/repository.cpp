@@ -3,12 +3,15 @@
 #include "utility/path.hpp"
 #include "utility/vector_set.hpp"
 #include "utility/git.hpp"
+#include "utility/trace.hpp"
 #include "parser/parse_top.hpp"
 #include <cassert>
 #include <algorithm>
+#include <array>
 #include <map>
 #include <set>
 #include <print>
+#include <chrono>
 
 namespace hk {
 
@@ -31,14 +34,55 @@ repository::repository(std::filesystem::path path, repository_url remote) : remo
 
 void repository::scan_prologues(datum_namespace const& guard_namespace, module_list& modules)
 {
+    auto const configurations = std::array{&guard_namespace};
+    scan_prologues(configurations, std::span{&modules, 1});
+}
+
+void repository::scan_prologues(std::span<datum_namespace const* const> configurations, std::span<module_list> modules)
+{
+    assert(configurations.size() == modules.size());
+    auto const trace = trace_scope{"repository::scan_prologues"};
+
+    statistics = scan_statistics{};
+    statistics.num_repositories = 1;
+
+    auto const t0 = std::chrono::steady_clock::now();
     gather_modules();
+    statistics.num_sources = _sources_by_path.size();
+
+    auto const t1 = std::chrono::steady_clock::now();
     parse_prologues();
     _sources_by_name = sort_by_name(_sources_by_path);
-    evaluate_build_guard(guard_namespace);
+
+    auto const t2 = std::chrono::steady_clock::now();
+    evaluate_build_guards(configurations);
+
+    for (auto& source : _sources_by_path) {
+        for (auto& m : modules) {
+            m.add(*source);
+        }
+    }
+
+    auto const t3 = std::chrono::steady_clock::now();
+    statistics.walk = t1 - t0;
+    statistics.parse = t2 - t1;
+    statistics.guard = t3 - t2;
+
+    auto reporter = error_reporter{};
+    report_errors(reporter);
+}
+
+void repository::report_errors(error_reporter& reporter)
+{
+    for (auto& source : _sources_by_path) {
+        reporter.add(source->errors(), source->lines());
+    }
 }
 
 bool repository::gather_modules()
 {
+    auto const trace = trace_scope{"repository::gather_modules"};
+
     auto first = std::filesystem::recursive_directory_iterator{path};
     auto last = std::filesystem::recursive_directory_iterator{};
 
@@ -134,8 +178,28 @@ std::expected<void, hkc_error> repository::evaluate_build_guard(datum_namespace
     return {};
 }
 
+std::expected<void, hkc_error> repository::evaluate_build_guards(std::span<datum_namespace const* const> configurations)
+{
+    auto const trace = trace_scope{"repository::evaluate_build_guards"};
+
+    auto last_error = hkc_error::none;
+    for (auto &source : _sources_by_path) {
+        if (auto r = source->evaluate_build_guards(configurations); not r.has_value()) {
+            last_error = r.error();
+        }
+    }
+    
+    if (last_error != hkc_error::none) {
+        return std::unexpected{last_error};
+    }
+
+    return {};
+}
+
 bool repository::parse_prologues()
 {
+    auto const trace = trace_scope{"repository::parse_prologues"};
+
     auto modified = false;
 
     for (auto& source : _sources_by_path) {
@@ -157,6 +221,8 @@ bool repository::parse_prologues()
 
 void repository::recursive_scan_prologues(datum_namespace const& guard_namespace, repository_flags flags)
 {
+    auto const trace = trace_scope{"repository::recursive_scan_prologues"};
+
     struct all_nodes_item {
         std::set<ast::node*> nodes;
         std::set<hkc_error> errors;
@@ -171,6 +237,7 @@ void repository::recursive_scan_prologues(datum_namespace const& guard_namespace
     auto modules = module_list{};
 
     scan_prologues(guard_namespace, modules);
+    auto total_statistics = statistics;
     for (auto const node_ptr : remote_repositories()) {
         auto [it, inserted] = all_nodes.emplace(node_ptr->url, all_nodes_item{});
         it->second.nodes.insert(node_ptr);
@@ -200,7 +267,10 @@ void repository::recursive_scan_prologues(datum_namespace const& guard_namespace
         }
 
         child_repo.mark = true;
-        if (auto r = git_checkout_or_clone(child_remote, child_local_path, flags); r != git_error::ok) {
+        auto const clone_start = std::chrono::steady_clock::now();
+        auto const clone_result = git_checkout_or_clone(child_remote, child_local_path, flags);
+        total_statistics.clone += std::chrono::steady_clock::now() - clone_start;
+        if (clone_result != git_error::ok) {
             auto short_hkdeps = std::format("_hkdeps/{}", child_remote.directory());
 
             auto it = all_nodes.find(child_remote);
@@ -212,6 +282,7 @@ void repository::recursive_scan_prologues(datum_namespace const& guard_namespace
         }
 
         child_repo.scan_prologues(guard_namespace, modules);
+        total_statistics += child_repo.statistics;
         for (auto node_ptr : child_repo.remote_repositories()) {
             all_nodes.emplace(node_ptr->url, node_ptr);
             todo.emplace(node_ptr->url);
@@ -223,6 +294,11 @@ void repository::recursive_scan_prologues(datum_namespace const& guard_namespace
         return not item->mark;
     });
 
+    auto const dedup_start = std::chrono::steady_clock::now();
+    modules.deduplicate();
+    total_statistics.dedup = std::chrono::steady_clock::now() - dedup_start;
+    statistics = total_statistics;
+
     // Add error to each import statement that tried to import the repository.
     for (auto const& [url, item] : all_nodes) {
         for (auto error : item.errors) {
@@ -231,6 +307,12 @@ void repository::recursive_scan_prologues(datum_namespace const& guard_namespace
             }
         }
     }
+
+    auto reporter = error_reporter{};
+    report_errors(reporter);
+    for (auto& repo : child_repositories()) {
+        repo->report_errors(reporter);
+    }
 }
 
 [[nodiscard]] generator<ast::import_repository_declaration_node*> repository::remote_repositories() const
@@ -3,15 +3,18 @@
 
 #include "parser/parse_context.hpp"
 #include "error/error_list.hpp"
+#include "error/error_reporter.hpp"
 #include "utility/repository_url.hpp"
 #include "utility/repository_flags.hpp"
 #include "utility/generator.hpp"
 #include "source.hpp"
 #include "module_list.hpp"
+#include "scan_statistics.hpp"
 #include <filesystem>
 #include <memory>
 #include <chrono>
 #include <vector>
+#include <span>
 
 namespace hk {
 
@@ -29,6 +32,13 @@ public:
      */
     bool mark = false;
 
+    /** The time spent in each phase of the last scan.
+     *
+     * After `recursive_scan_prologues()` this includes the time spent on the
+     * child repositories.
+     */
+    scan_statistics statistics = {};
+
     /** Construct a repository.
      * 
      * @param path The disk location of the repository.
@@ -46,12 +56,46 @@ public:
      */
     void scan_prologues(datum_namespace const& guard_namespace, module_list& modules);
 
+    /** Scan the prologue of each *.hkm in the repository for several configurations.
+     *
+     * The sources are parsed once, then the build-guards are evaluated for
+     * each configuration. Each source is added to the module list of every
+     * configuration in which it is enabled.
+     *
+     * @param configurations The namespaces of up to 64 configurations.
+     * @param modules A module list for each configuration.
+     */
+    void scan_prologues(std::span<datum_namespace const* const> configurations, std::span<module_list> modules);
+
+    /** Evaluate the build guards.
+     *
+     * This also selects the configuration for which the declarations are
+     * enabled, for example before `module_list::mark_used()`.
+     */
+    std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx);
+
+    /** Evaluate the build guards for several configurations.
+     *
+     * @see source::evaluate_build_guards()
+     * @param configurations The namespaces of up to 64 configurations.
+     */
+    std::expected<void, hkc_error> evaluate_build_guards(std::span<datum_namespace const* const> configurations);
+
     /** Recusively clone and scan repositories.
-     * 
+     *
+     * The modules of all the repositories are deduplicated afterwards, which
+     * resolves anchors that are declared with different versions.
+     *
      * @param force Force scanning even on files that were already parsed.
      */
     void recursive_scan_prologues(datum_namespace const& guard_namespace, repository_flags flags);
 
+    /** Report the errors of each source file that were not reported before.
+     *
+     * @param reporter The reporter to add the errors to.
+     */
+    void report_errors(error_reporter& reporter);
+
     /** Get the remote repositories imported by this repository.
      * 
      * @pre `scan_prologues()` must be called first.
@@ -107,10 +151,6 @@ private:
      */
     bool gather_modules();
 
-    /** Evaluate the build guards.
-     */
-    std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx);
-
     /** Parse all the modules in a repository.
      * 
      * @pre `sort_modules()` may need to be called.
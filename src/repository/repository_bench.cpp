@@ -0,0 +1,91 @@
+
+#include "repository.hpp"
+#include "bench_utilities/repository_graph.hpp"
+#include "utility/datum_namespace.hpp"
+#include "utility/path.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace {
+
+[[nodiscard]] double to_seconds(hk::scan_statistics::duration_type d)
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+/** Recursively scan a generated graph of git repositories.
+ *
+ * The arguments are the number of repositories, the number of modules in
+ * each repository, the fan-out of the `import git` declarations and the
+ * depth of the graph. A quarter of the repositories declare the same anchor
+ * with different versions.
+ *
+ * Each iteration clones the repositories into an empty `_hkdeps` directory.
+ * The time spent in each phase of the scan is reported as a counter, in
+ * seconds per iteration.
+ */
+void bm_repository_recursive_scan_prologues(benchmark::State& state)
+{
+    auto options = bench::repository_graph_options{};
+    options.num_repositories = static_cast<std::size_t>(state.range(0));
+    options.num_modules = static_cast<std::size_t>(state.range(1));
+    options.fan_out = static_cast<std::size_t>(state.range(2));
+    options.depth = static_cast<std::size_t>(state.range(3));
+    options.num_anchor_conflicts = options.num_repositories / 4;
+    options.modules.num_declarations = 2;
+    options.modules.max_depth = 2;
+    options.modules.num_imports = 4;
+
+    auto const directory = hk::scoped_temporary_directory{"hkbench"};
+    auto const root_path = std::filesystem::canonical(bench::write_repository_graph(directory.path(), options));
+
+    auto guard_namespace = hk::datum_namespace{};
+    guard_namespace.set(hk::fqname{".target.os"}, std::string{"linux"});
+    guard_namespace.set(hk::fqname{".target.cpu"}, std::string{"x86_64"});
+    guard_namespace.set(hk::fqname{".debug"}, false);
+
+    auto total = hk::scan_statistics{};
+    auto repository = std::optional<hk::repository>{};
+    for (auto _ : state) {
+        state.PauseTiming();
+        repository.reset();
+        std::filesystem::remove_all(root_path / "_hkdeps");
+        state.ResumeTiming();
+
+        repository.emplace(root_path);
+        repository->recursive_scan_prologues(guard_namespace, hk::repository_flags{});
+
+        state.PauseTiming();
+        if (repository->child_repositories().size() != options.num_repositories) {
+            state.SkipWithError("Could not clone every generated repository");
+            break;
+        }
+        total += repository->statistics;
+        state.ResumeTiming();
+    }
+
+    auto const avg = [](double value) {
+        return benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+    };
+    state.counters["clone"] = avg(to_seconds(total.clone));
+    state.counters["walk"] = avg(to_seconds(total.walk));
+    state.counters["parse"] = avg(to_seconds(total.parse));
+    state.counters["guard"] = avg(to_seconds(total.guard));
+    state.counters["dedup"] = avg(to_seconds(total.dedup));
+    state.counters["repositories"] = avg(static_cast<double>(total.num_repositories));
+    state.SetItemsProcessed(static_cast<int64_t>(total.num_sources));
+}
+
+} // namespace
+
+// From 10 to 100k generated modules.
+BENCHMARK(bm_repository_recursive_scan_prologues)
+    ->Args({1, 10, 1, 1})
+    ->Args({10, 100, 2, 2})
+    ->Args({100, 100, 4, 3})
+    ->Args({100, 1000, 4, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
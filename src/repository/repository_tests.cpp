@@ -5,6 +5,8 @@
 #include <hikotest/hikotest.hpp>
 #include <ranges>
 #include <filesystem>
+#include <array>
+#include <string>
 
 TEST_SUITE(repository_suite) 
 {
@@ -23,6 +25,31 @@ TEST_CASE(single_repository_scan)
     REQUIRE(nodes[0]->url.rev() == "main");
 }
 
+TEST_CASE(multi_configuration_scan)
+{
+    auto test_data_path = test::test_data_path();
+    auto repository_path = std::filesystem::canonical(test_data_path / "multi_configuration_scan");
+    auto repository = hk::repository{repository_path};
+
+    auto config_linux = hk::datum_namespace{};
+    config_linux.set(hk::fqname{".target.os"}, std::string{"linux"});
+    auto config_windows = hk::datum_namespace{};
+    config_windows.set(hk::fqname{".target.os"}, std::string{"windows"});
+    auto config_macos = hk::datum_namespace{};
+    config_macos.set(hk::fqname{".target.os"}, std::string{"macos"});
+
+    auto const configurations = std::array<hk::datum_namespace const*, 3>{&config_linux, &config_windows, &config_macos};
+    auto modules = std::array{hk::module_list{0}, hk::module_list{1}, hk::module_list{2}};
+    repository.scan_prologues(configurations, modules);
+    REQUIRE(repository.statistics.num_repositories == 1);
+    REQUIRE(repository.statistics.num_sources == 3);
+
+    // common.hkm is a fallback in every configuration.
+    REQUIRE(modules[0].size() == 2);
+    REQUIRE(modules[1].size() == 2);
+    REQUIRE(modules[2].size() == 1);
+}
+
 TEST_CASE(recursive_repository_scan) 
 {
     auto source_path = std::filesystem::canonical(test::test_data_path() / "recursive_repository_scan");
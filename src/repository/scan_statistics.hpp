@@ -0,0 +1,62 @@
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace hk {
+
+/** The time spent in each phase of scanning the prologues of repositories.
+ */
+struct scan_statistics {
+    using duration_type = std::chrono::steady_clock::duration;
+
+    /** Cloning or updating remote repositories.
+     */
+    duration_type clone = {};
+
+    /** Walking the directory tree to find the `.hkm` files.
+     */
+    duration_type walk = {};
+
+    /** Reading, tokenizing and parsing the prologues, and sorting the sources by name.
+     */
+    duration_type parse = {};
+
+    /** Evaluating the build-guards and adding the sources to the module list.
+     */
+    duration_type guard = {};
+
+    /** Deduplicating the module list.
+     */
+    duration_type dedup = {};
+
+    /** The number of repositories scanned, including the root repository.
+     */
+    std::size_t num_repositories = 0;
+
+    /** The number of `.hkm` files found.
+     */
+    std::size_t num_sources = 0;
+
+    scan_statistics& operator+=(scan_statistics const& rhs) noexcept
+    {
+        clone += rhs.clone;
+        walk += rhs.walk;
+        parse += rhs.parse;
+        guard += rhs.guard;
+        dedup += rhs.dedup;
+        num_repositories += rhs.num_repositories;
+        num_sources += rhs.num_sources;
+        return *this;
+    }
+
+    /** The total time of all phases.
+     */
+    [[nodiscard]] duration_type total() const noexcept
+    {
+        return clone + walk + parse + guard + dedup;
+    }
+};
+
+}
@@ -2,8 +2,13 @@
 #include "source.hpp"
 #include "repository.hpp"
 #include "utility/read_file.hpp"
+#include "tokenizer/validate_utf8.hpp"
 #include "parser/parse_top.hpp"
 #include "parser/parse_context.hpp"
+#include "utility/trace.hpp"
+#include "ast/module_declaration_node.hpp"
+#include "ast/program_declaration_node.hpp"
+#include "ast/library_declaration_node.hpp"
 #include <cassert>
 
 namespace hk {
@@ -35,7 +40,7 @@ source::source(hk::repository &parent, fqname generating_module, size_t lineno)
     case 2:
         return kind_type::program;
     case 3:
-        return kind_type::unknown;
+        return kind_type::library;
     }
     std::unreachable();
 }
@@ -53,6 +58,7 @@ source::source(hk::repository &parent, fqname generating_module, size_t lineno)
 
 [[nodiscard]] std::expected<bool, std::error_code> source::load()
 {
+    auto const trace = trace_scope{"source::load"};
     auto modified = false;
 
     if (is_generated()) {
@@ -85,10 +91,36 @@ source::source(hk::repository &parent, fqname generating_module, size_t lineno)
             _source_code = std::move(optional_text).value();
             _source_code_time = write_time;
             _lines.add_file(_source_code.data(), _source_code.data() + _source_code.size(), path().string());
+            validate_source_code();
         }
     }
 }
 
+void source::validate_source_code()
+{
+    using namespace std::literals;
+
+    auto const first = _source_code.data();
+    auto const last = first + _source_code.size();
+    auto const [ascii, errors] = validate_utf8(first, last);
+
+    _lines.set_ascii(ascii);
+    for (auto const& t : errors) {
+        auto const message = [&] {
+            switch (t.kind()) {
+            case token::invalid_surrogate_code_point_error:
+                return "UTF-16 surrogate code-point encoded in UTF-8."s;
+            case token::invalid_code_point_error:
+                return "Overlong encoding or code-point beyond U+10FFFF."s;
+            default:
+                return "Unexpected or missing continuation byte."s;
+            }
+        }();
+
+        _errors.add(_lines, t.begin(), t.end(), hkc_error::invalid_utf8_sequence, message);
+    }
+}
+
 std::expected<bool, std::error_code> source::parse_prologue()
 {
     if (auto optional_modified = load(); not optional_modified) {
@@ -98,13 +130,31 @@ std::expected<bool, std::error_code> source::parse_prologue()
     }
 
     _prologue_ast = nullptr;
+    _build_guard_version = 0;
+    _name = {};
+    _version = {};
 
     auto ctx = parse_context(_lines);
     auto p = const_cast<char const*>(_source_code.data());
     auto path_ = path().string();
-    if (auto optional_ast = parse_top(p, ctx, false)) {
+    auto optional_ast = parse_top(p, ctx, false);
+    _errors.insert(_errors.end(), std::make_move_iterator(ctx.errors().begin()), std::make_move_iterator(ctx.errors().end()));
+
+    if (optional_ast) {
         _prologue_ast = std::move(optional_ast).value();
         _prologue_ast->fixup_top(this);
+
+        auto const& declaration = _prologue_ast->declaration();
+        if (auto module = dynamic_cast<ast::module_declaration_node const*>(&declaration)) {
+            _name.emplace<1>(module->name);
+            _version = module->version;
+        } else if (auto program = dynamic_cast<ast::program_declaration_node const*>(&declaration)) {
+            _name.emplace<2>(program->filename_stem);
+            _version = program->version;
+        } else if (auto library = dynamic_cast<ast::library_declaration_node const*>(&declaration)) {
+            _name.emplace<3>(library->filename_stem);
+            _version = library->version;
+        }
     } else if (to_bool(optional_ast.error())) {
         return std::unexpected{optional_ast.error()};
     } else {
@@ -117,6 +167,14 @@ std::expected<bool, std::error_code> source::parse_prologue()
 
 std::expected<void, hkc_error> source::evaluate_build_guard(datum_namespace const& ctx)
 {
+    if (_build_guard_version == ctx.version()) {
+        // The build-guards were already evaluated with this configuration.
+        if (_build_guard_error != hkc_error::none) {
+            return std::unexpected{_build_guard_error};
+        }
+        return {};
+    }
+
     auto last_error = hkc_error::none;
 
     if (_prologue_ast != nullptr) {
@@ -131,6 +189,40 @@ std::expected<void, hkc_error> source::evaluate_build_guard(datum_namespace cons
         }
     }
     
+    _build_guard_version = ctx.version();
+    _build_guard_error = last_error;
+
+    if (last_error != hkc_error::none) {
+        return std::unexpected{last_error};
+    }
+
+    return {};
+}
+
+std::expected<void, hkc_error> source::evaluate_build_guards(std::span<datum_namespace const* const> configurations)
+{
+    assert(configurations.size() <= max_num_configurations);
+
+    _enabled_configurations = 0;
+    _fallback_configurations = 0;
+
+    auto last_error = hkc_error::none;
+    for (auto i = 0uz; i != configurations.size(); ++i) {
+        assert(configurations[i] != nullptr);
+        if (auto r = evaluate_build_guard(*configurations[i]); not r) {
+            last_error = r.error();
+        }
+
+        auto const bit = configuration_mask{1} << i;
+        auto const e = enabled();
+        if (to_bool(e)) {
+            _enabled_configurations |= bit;
+        }
+        if (e == logic::_) {
+            _fallback_configurations |= bit;
+        }
+    }
+
     if (last_error != hkc_error::none) {
         return std::unexpected{last_error};
     }
@@ -15,11 +15,22 @@
 #include <variant>
 #include <compare>
 #include <mutex>
+#include <span>
+#include <cstdint>
+#include <cassert>
 
 namespace hk {
 
 class repository;
 
+/** A set of build configurations, bit `i` is set for configuration `i`.
+ */
+using configuration_mask = uint64_t;
+
+/** The maximum number of configurations that are planned at once.
+ */
+constexpr auto max_num_configurations = 64uz;
+
 class source {
 public:
     enum class kind_type { unknown, module, library, program };
@@ -78,19 +89,54 @@ public:
         return logic::X;
     }
 
+    /** The source file is enabled in a configuration.
+     *
+     * @pre `evaluate_build_guards()` must be called first.
+     * @param configuration The index of the configuration.
+     * @return T when the build-guard is true, _ when the source is a
+     *         fallback without a build-guard, otherwise F.
+     */
+    [[nodiscard]] logic enabled(size_t configuration) const noexcept
+    {
+        assert(configuration < max_num_configurations);
+        auto const bit = configuration_mask{1} << configuration;
+
+        if (_fallback_configurations & bit) {
+            return logic::_;
+        } else if (_enabled_configurations & bit) {
+            return logic::T;
+        } else {
+            return logic::F;
+        }
+    }
+
+    /** The configurations in which the source file is enabled.
+     *
+     * @pre `evaluate_build_guards()` must be called first.
+     */
+    [[nodiscard]] configuration_mask enabled_configurations() const noexcept
+    {
+        return _enabled_configurations;
+    }
+
     /** Is this module used by this project.
      * 
      *  * Is the module imported by programs or libraries that are compiled.
      *  * Is this source a program or library to be compiled.
+     *
+     * @param configuration The index of the configuration.
      */
-    [[nodiscard]] bool used() const noexcept
+    [[nodiscard]] bool used(size_t configuration = 0) const noexcept
     {
-        return _used;
+        assert(configuration < max_num_configurations);
+        return static_cast<bool>(_used_configurations & (configuration_mask{1} << configuration));
     }
 
-    void set_used(bool used) noexcept
+    void set_used(size_t configuration, bool used) noexcept
     {
-        _used = used;
+        assert(configuration < max_num_configurations);
+        auto const bit = configuration_mask{1} << configuration;
+        _used_configurations = used ? _used_configurations | bit : _used_configurations & ~bit;
     }
 
     /** The kind of source this is.
@@ -185,8 +231,25 @@ public:
 
     [[nodiscard]] generator<ast::import_module_declaration_node*> imported_modules() const;
 
+    /** Evaluate the build-guards of the declarations in the source.
+     *
+     * The results are memoized; evaluating again with a namespace of the same
+     * version returns immediately, until the source is parsed again.
+     *
+     * @param ctx The namespace used by the build-guards.
+     */
     std::expected<void, hkc_error> evaluate_build_guard(datum_namespace const& ctx);
 
+    /** Evaluate the build-guards for each configuration.
+     *
+     * Afterwards `enabled(configuration)` returns the result for each
+     * configuration, and the declarations hold the results of the last
+     * configuration.
+     *
+     * @param configurations The namespaces of up to 64 configurations.
+     */
+    std::expected<void, hkc_error> evaluate_build_guards(std::span<datum_namespace const* const> configurations);
+
 private:
     mutable std::mutex _mutex;
 
@@ -211,9 +274,17 @@ private:
      */
     mutable error_list _errors;
 
-    /** If the module is used in the project.
+    /** The configurations in which the module is used in the project.
+     */
+    configuration_mask _used_configurations = 0;
+
+    /** The configurations in which the build-guard is true or a fallback.
+     */
+    configuration_mask _enabled_configurations = 0;
+
+    /** The configurations in which the source is a fallback.
      */
-    bool _used = false;
+    configuration_mask _fallback_configurations = 0;
 
     /** The source of the module.
      *
@@ -256,6 +327,16 @@ private:
      */
     std::unique_ptr<ast::top_node> _ast;
 
+    /** The version of the namespace of the last build-guard evaluation.
+     *
+     * - Zero when the build-guards have not been evaluated since parsing.
+     */
+    uint64_t _build_guard_version = 0;
+
+    /** The last error of the last build-guard evaluation.
+     */
+    hkc_error _build_guard_error = hkc_error::none;
+
     /** Reset compilation state when the file has been loaded.
      *
      */
@@ -265,6 +346,13 @@ private:
      *
      */
     std::expected<bool, std::error_code> load();
+
+    /** Validate the UTF-8 of the source code after it was loaded.
+     *
+     * Reports invalid UTF-8 sequences and marks the line table as ASCII
+     * for the fast paths of the tokenizer.
+     */
+    void validate_source_code();
 };
 
 [[nodiscard]] std::strong_ordering cmp_sources(source const& lhs, source const& rhs) noexcept;
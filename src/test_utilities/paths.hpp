@@ -5,6 +5,8 @@
 
 namespace test {
 
+[[nodiscard]] std::filesystem::path source_path();
+
 [[nodiscard]] std::filesystem::path test_data_path();
 
 
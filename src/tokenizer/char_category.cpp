@@ -1,10 +1,6 @@
 
 #include "char_category.hpp"
 
-extern "C" {
-#include <unicode/uchar.h>
-}
-
 namespace hk {
 
 [[nodiscard]] std::pair<char32_t, uint8_t> get_cp(char const* const p) noexcept
@@ -61,19 +57,4 @@ namespace hk {
     return {cp, length + 1};
 }
 
-[[nodiscard]] bool is_identifier_start(char32_t cp) noexcept
-{
-    return ::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_ID_START) or cp == '_'  or cp == U'°';
-}
-
-[[nodiscard]] bool is_identifier_continue(char32_t cp) noexcept
-{
-    return ::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_ID_CONTINUE) or cp == '_' or cp == U'°';
-}
-
-[[nodiscard]] bool is_pattern_syntax(char32_t cp) noexcept
-{
-    return ::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_PATTERN_SYNTAX) and cp != '_' and cp != U'°';
-}
-
-} // namespace hk
\ No newline at end of file
+} // namespace hk
@@ -6,6 +6,7 @@
 #include <bit>
 #include <cstdint>
 #include <cstring>
+#include "char_category_table.hpp"
 #include "utility/fixed_string.hpp"
 
 /** @file char_category.hpp
@@ -34,6 +35,20 @@ namespace hk {
  */
 [[nodiscard]] std::pair<char32_t, uint8_t> get_cp(char const* const p) noexcept;
 
+/** Get a code-point from a text that only contains ASCII characters.
+ *
+ * This is the fast path of `get_cp()` for text that was validated to be pure
+ * ASCII by `validate_utf8()`.
+ *
+ * @param p Pointer to the next code-point in an ASCII stream.
+ * @return code-point, number-of-code-units (always 1).
+ */
+[[nodiscard]] constexpr std::pair<char32_t, uint8_t> get_ascii_cp(char const* const p) noexcept
+{
+    assert(static_cast<uint8_t>(p[0]) < 0x80);
+    return {static_cast<char32_t>(p[0]), 1};
+}
+
 /** Is a code-point a vertical space.
  * 
  * A vertical space includes:
@@ -186,7 +201,10 @@ template<typename T, T... Values>
  * @param cp The code-point to check.
  * @retval true if the code-point is a valid identifier start character.
  */
-[[nodiscard]] bool is_identifier_start(char32_t cp) noexcept;
+[[nodiscard]] inline bool is_identifier_start(char32_t cp) noexcept
+{
+    return (char_category(cp) & char_category_flags::identifier_start) != 0;
+}
 
 /** Check if a code-point is a valid identifier continuation character.
  * 
@@ -201,7 +219,37 @@ template<typename T, T... Values>
  * @param cp The code-point to check.
  * @retval true if the code-point is a valid identifier continuation character.
  */
-[[nodiscard]] bool is_identifier_continue(char32_t cp) noexcept;
+[[nodiscard]] inline bool is_identifier_continue(char32_t cp) noexcept
+{
+    return (char_category(cp) & char_category_flags::identifier_continue) != 0;
+}
+
+/** Check if an ASCII character is a valid identifier start character.
+ *
+ * This is the same as `is_identifier_start()` restricted to ASCII: `a-z`,
+ * `A-Z` and `_`.
+ *
+ * @param c The ASCII character to check.
+ * @retval true if the character is a valid identifier start character.
+ */
+[[nodiscard]] constexpr bool is_ascii_identifier_start(char c) noexcept
+{
+    auto const lower = static_cast<uint8_t>(c | 0x20);
+    return (lower >= 'a' and lower <= 'z') or c == '_';
+}
+
+/** Check if an ASCII character is a valid identifier continuation character.
+ *
+ * This is the same as `is_identifier_continue()` restricted to ASCII: `a-z`,
+ * `A-Z`, `0-9` and `_`.
+ *
+ * @param c The ASCII character to check.
+ * @retval true if the character is a valid identifier continuation character.
+ */
+[[nodiscard]] constexpr bool is_ascii_identifier_continue(char c) noexcept
+{
+    return is_ascii_identifier_start(c) or (c >= '0' and c <= '9');
+}
 
 /** Check if a code-point is a pattern syntax character.
  * 
@@ -217,6 +265,35 @@ template<typename T, T... Values>
  * @param cp The code-point to check.
  * @retval true if the code-point is a pattern syntax character.
  */
-[[nodiscard]] bool is_pattern_syntax(char32_t cp) noexcept;
+[[nodiscard]] inline bool is_pattern_syntax(char32_t cp) noexcept
+{
+    return (char_category(cp) & char_category_flags::pattern_syntax) != 0;
+}
+
+/** Check if a code-point is a vertical space.
+ *
+ * Unlike `is_vertical_space(char const*)` this does not handle CR+LF, the
+ * code-point `\r` is always a vertical space.
+ *
+ * @param cp The code-point to check.
+ * @retval true if the code-point is `\n`, `\v`, `\f`, `\r`, U+0085, U+2028 or U+2029.
+ */
+[[nodiscard]] inline bool is_vertical_space(char32_t cp) noexcept
+{
+    return (char_category(cp) & char_category_flags::vertical_space) != 0;
+}
+
+/** Check if a code-point is a horizontal space.
+ *
+ * A horizontal space is a Unicode White_Space character that is not a
+ * vertical space, such as `\t`, ` `, U+00A0 and U+3000.
+ *
+ * @param cp The code-point to check.
+ * @retval true if the code-point is a horizontal space.
+ */
+[[nodiscard]] inline bool is_horizontal_space(char32_t cp) noexcept
+{
+    return (char_category(cp) & char_category_flags::horizontal_space) != 0;
+}
 
 } // namespace hk
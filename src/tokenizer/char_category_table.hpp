@@ -0,0 +1,87 @@
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/** @file char_category_table.hpp
+ *
+ * A two-level lookup table with the character category of each Unicode
+ * code-point.
+ *
+ * The table is generated at build time by `char_category_table_generator`
+ * from the Unicode properties in ICU. Looking up the category of a code-point
+ * is two memory loads:
+ *  1. `char_category_index[cp >> 8]` gives the index of a block of 256
+ *     code-points.
+ *  2. `char_category_blocks[block * 256 + (cp & 0xff)]` gives the flags.
+ *
+ * Identical blocks are stored only once; most of the 0x1100 blocks are either
+ * all zero, or all identifier characters (CJK, Hangul).
+ */
+
+namespace hk {
+
+/** The flags stored for each code-point in the char-category table.
+ */
+struct char_category_flags {
+    /** Unicode ID_Start, `_` or `°`.
+     */
+    constexpr static uint8_t identifier_start = 0x01;
+
+    /** Unicode ID_Continue, `_` or `°`.
+     */
+    constexpr static uint8_t identifier_continue = 0x02;
+
+    /** Unicode Pattern_Syntax, excluding `_` and `°`.
+     */
+    constexpr static uint8_t pattern_syntax = 0x04;
+
+    /** `\n`, `\v`, `\f`, `\r`, U+0085, U+2028 and U+2029.
+     */
+    constexpr static uint8_t vertical_space = 0x08;
+
+    /** Unicode White_Space that is not a vertical space.
+     */
+    constexpr static uint8_t horizontal_space = 0x10;
+};
+
+/** The number of code-points in a block of the char-category table.
+ */
+constexpr auto char_category_block_size = 256uz;
+
+/** The number of blocks needed to cover all code-points U+0000 to U+10FFFF.
+ */
+constexpr auto char_category_num_blocks = 0x11'0000uz / char_category_block_size;
+
+/** The first level of the char-category table.
+ *
+ * For each block of 256 code-points the index of the block in
+ * `char_category_blocks`.
+ */
+extern std::array<uint16_t, char_category_num_blocks> const char_category_index;
+
+/** The second level of the char-category table.
+ *
+ * The deduplicated blocks of flags, each `char_category_block_size` long.
+ */
+extern uint8_t const char_category_blocks[];
+
+/** Get the char-category flags of a code-point.
+ *
+ * @param cp The code-point to look up.
+ * @return The `char_category_flags` of the code-point, or zero if the
+ *         code-point is beyond U+10FFFF.
+ */
+[[nodiscard]] inline uint8_t char_category(char32_t cp) noexcept
+{
+    if (cp >= 0x11'0000) [[unlikely]] {
+        return 0;
+    }
+
+    auto const block = char_category_index[cp / char_category_block_size];
+    return char_category_blocks[block * char_category_block_size + cp % char_category_block_size];
+}
+
+} // namespace hk
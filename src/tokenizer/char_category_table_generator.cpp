@@ -0,0 +1,106 @@
+
+/** @file char_category_table_generator.cpp
+ *
+ * Build-time tool that writes the char-category table to a C++ source file.
+ *
+ * Usage: char_category_table_generator <output.cpp>
+ *
+ * The categories are taken from the Unicode properties in ICU, so that the
+ * tokenizer does not need to call ICU for each code-point it classifies.
+ */
+
+#include "char_category_table.hpp"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <vector>
+
+extern "C" {
+#include <unicode/uchar.h>
+#include <unicode/uversion.h>
+}
+
+[[nodiscard]] static uint8_t compute_char_category(char32_t cp)
+{
+    using hk::char_category_flags;
+
+    auto const c = static_cast<UChar32>(cp);
+    auto const special = cp == '_' or cp == U'°';
+    auto const vertical = cp == '\n' or cp == '\v' or cp == '\f' or cp == '\r' or cp == 0x85 or cp == 0x2028 or cp == 0x2029;
+
+    auto r = uint8_t{};
+    if (::u_hasBinaryProperty(c, UCHAR_ID_START) or special) {
+        r |= char_category_flags::identifier_start;
+    }
+    if (::u_hasBinaryProperty(c, UCHAR_ID_CONTINUE) or special) {
+        r |= char_category_flags::identifier_continue;
+    }
+    if (::u_hasBinaryProperty(c, UCHAR_PATTERN_SYNTAX) and not special) {
+        r |= char_category_flags::pattern_syntax;
+    }
+    if (vertical) {
+        r |= char_category_flags::vertical_space;
+    } else if (::u_hasBinaryProperty(c, UCHAR_WHITE_SPACE)) {
+        r |= char_category_flags::horizontal_space;
+    }
+    return r;
+}
+
+int main(int argc, char const* const* argv)
+{
+    using block_type = std::array<uint8_t, hk::char_category_block_size>;
+
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s <output.cpp>\n", argv[0]);
+        return 2;
+    }
+
+    auto index = std::array<uint16_t, hk::char_category_num_blocks>{};
+    auto blocks = std::vector<block_type>{};
+    auto block_numbers = std::map<block_type, uint16_t>{};
+
+    for (auto i = 0uz; i != hk::char_category_num_blocks; ++i) {
+        auto block = block_type{};
+        for (auto j = 0uz; j != hk::char_category_block_size; ++j) {
+            block[j] = compute_char_category(static_cast<char32_t>(i * hk::char_category_block_size + j));
+        }
+
+        auto const [it, inserted] = block_numbers.try_emplace(block, static_cast<uint16_t>(blocks.size()));
+        if (inserted) {
+            blocks.push_back(block);
+        }
+        index[i] = it->second;
+    }
+
+    auto out = std::ofstream{argv[1]};
+    if (not out) {
+        std::fprintf(stderr, "Could not open %s for writing.\n", argv[1]);
+        return 1;
+    }
+
+    out << "// Generated by char_category_table_generator from ICU " << U_ICU_VERSION << ", do not edit.\n\n";
+    out << "#include \"tokenizer/char_category_table.hpp\"\n\n";
+    out << "namespace hk {\n\n";
+
+    out << "std::array<uint16_t, char_category_num_blocks> const char_category_index = {";
+    for (auto i = 0uz; i != index.size(); ++i) {
+        out << (i % 16 == 0 ? "\n    " : " ") << index[i] << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "alignas(64) uint8_t const char_category_blocks[" << blocks.size() << " * char_category_block_size] = {";
+    for (auto const& block : blocks) {
+        for (auto j = 0uz; j != block.size(); ++j) {
+            out << (j % 32 == 0 ? "\n    " : " ") << static_cast<unsigned>(block[j]) << ",";
+        }
+    }
+    out << "\n};\n\n";
+
+    out << "} // namespace hk\n";
+
+    if (not out) {
+        std::fprintf(stderr, "Could not write %s.\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+
+#include "char_category.hpp"
+#include <hikotest/hikotest.hpp>
+
+extern "C" {
+#include <unicode/uchar.h>
+}
+
+TEST_SUITE(char_category_suite)
+{
+
+TEST_CASE(identifier_start_matches_icu)
+{
+    for (char32_t cp = 0; cp != 0x11'0000; ++cp) {
+        auto const expected = ::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_ID_START) or cp == '_' or cp == U'°';
+        REQUIRE(hk::is_identifier_start(cp) == static_cast<bool>(expected));
+    }
+}
+
+TEST_CASE(identifier_continue_matches_icu)
+{
+    for (char32_t cp = 0; cp != 0x11'0000; ++cp) {
+        auto const expected = ::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_ID_CONTINUE) or cp == '_' or cp == U'°';
+        REQUIRE(hk::is_identifier_continue(cp) == static_cast<bool>(expected));
+    }
+}
+
+TEST_CASE(pattern_syntax_matches_icu)
+{
+    for (char32_t cp = 0; cp != 0x11'0000; ++cp) {
+        auto const expected = ::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_PATTERN_SYNTAX) and cp != '_' and cp != U'°';
+        REQUIRE(hk::is_pattern_syntax(cp) == static_cast<bool>(expected));
+    }
+}
+
+TEST_CASE(white_space_matches_icu)
+{
+    for (char32_t cp = 0; cp != 0x11'0000; ++cp) {
+        auto const expected = static_cast<bool>(::u_hasBinaryProperty(static_cast<UChar32>(cp), UCHAR_WHITE_SPACE));
+        REQUIRE((hk::is_vertical_space(cp) or hk::is_horizontal_space(cp)) == expected);
+        REQUIRE(not (hk::is_vertical_space(cp) and hk::is_horizontal_space(cp)));
+    }
+}
+
+TEST_CASE(vertical_space)
+{
+    REQUIRE(hk::is_vertical_space(U'\n'));
+    REQUIRE(hk::is_vertical_space(U'\v'));
+    REQUIRE(hk::is_vertical_space(U'\f'));
+    REQUIRE(hk::is_vertical_space(U'\r'));
+    REQUIRE(hk::is_vertical_space(U'\u0085'));
+    REQUIRE(hk::is_vertical_space(U' '));
+    REQUIRE(hk::is_vertical_space(U' '));
+    REQUIRE(not hk::is_vertical_space(U'\t'));
+    REQUIRE(hk::is_horizontal_space(U'\t'));
+    REQUIRE(hk::is_horizontal_space(U' '));
+    REQUIRE(hk::is_horizontal_space(U'　'));
+}
+
+TEST_CASE(out_of_range)
+{
+    REQUIRE(hk::char_category(0x11'0000) == 0);
+    REQUIRE(hk::char_category(0xffff'ffff) == 0);
+}
+
+};
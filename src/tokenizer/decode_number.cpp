@@ -0,0 +1,662 @@
+
+#include "decode_number.hpp"
+#include "power_of_five_table.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <cassert>
+
+namespace hk {
+
+/** Get the value of a digit.
+ *
+ * @param c A digit in radix 2, 8, 10 or 16.
+ * @return The value of the digit, or 0xff if @a c is not a digit.
+ */
+[[nodiscard]] static uint8_t digit_value(char c) noexcept
+{
+    if (c >= '0' and c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    }
+
+    auto const lower = static_cast<char>(c | 0x20);
+    if (lower >= 'a' and lower <= 'f') {
+        return static_cast<uint8_t>(lower - 'a' + 10);
+    }
+    return 0xff;
+}
+
+/** Parse the optional sign and radix prefix of a number literal.
+ *
+ * @param[in,out] p The start of the literal, advanced beyond the prefix.
+ * @param last The end of the literal.
+ * @return Whether the literal is negative, and the radix.
+ */
+[[nodiscard]] static std::pair<bool, unsigned int> parse_prefix(char const*& p, char const* last) noexcept
+{
+    auto negative = false;
+    if (p != last and (p[0] == '+' or p[0] == '-')) {
+        negative = p[0] == '-';
+        ++p;
+    }
+
+    auto radix = 10u;
+    if (last - p >= 2 and p[0] == '0') {
+        switch (p[1]) {
+        case 'b':
+        case 'B':
+            radix = 2;
+            p += 2;
+            break;
+        case 'o':
+        case 'O':
+            radix = 8;
+            p += 2;
+            break;
+        case 'd':
+        case 'D':
+            radix = 10;
+            p += 2;
+            break;
+        case 'x':
+        case 'X':
+            radix = 16;
+            p += 2;
+            break;
+        default:;
+        }
+    }
+
+    return {negative, radix};
+}
+
+/** Parse the decimal exponent after the exponent prefix.
+ *
+ * @param[in,out] p Pointer to the optional sign of the exponent.
+ * @param last The end of the literal.
+ * @return The exponent, clamped so that it can be added without overflow.
+ */
+[[nodiscard]] static int64_t parse_exponent(char const*& p, char const* last) noexcept
+{
+    auto negative = false;
+    if (p != last and (p[0] == '+' or p[0] == '-')) {
+        negative = p[0] == '-';
+        ++p;
+    }
+
+    auto r = int64_t{};
+    for (; p != last; ++p) {
+        if (p[0] != '\'' and r < 1'000'000) {
+            r = r * 10 + (p[0] - '0');
+        }
+    }
+    return negative ? -r : r;
+}
+
+/** Load 8 characters as a little-endian 64-bit integer.
+ */
+[[nodiscard]] static uint64_t load_eight_chars(char const* p) noexcept
+{
+    auto r = uint64_t{};
+    std::memcpy(&r, p, sizeof(r));
+    if constexpr (std::endian::native == std::endian::big) {
+        r = std::byteswap(r);
+    }
+    return r;
+}
+
+/** Check if 8 characters are all decimal digits.
+ *
+ * @param chars The characters loaded by `load_eight_chars()`.
+ */
+[[nodiscard]] static bool is_eight_digits(uint64_t chars) noexcept
+{
+    return ((chars & 0xf0f0'f0f0'f0f0'f0f0) | (((chars + 0x0606'0606'0606'0606) & 0xf0f0'f0f0'f0f0'f0f0) >> 4)) ==
+        0x3333'3333'3333'3333;
+}
+
+/** Convert 8 decimal digits to an integer using SWAR.
+ *
+ * @param chars The characters loaded by `load_eight_chars()`.
+ * @return The value of the 8 digits, between 0 and 99'999'999.
+ */
+[[nodiscard]] static uint32_t parse_eight_digits(uint64_t chars) noexcept
+{
+    constexpr auto mask = uint64_t{0x0000'00ff'0000'00ff};
+    constexpr auto mul1 = uint64_t{0x000f'4240'0000'0064}; // 100 + (1000000 << 32)
+    constexpr auto mul2 = uint64_t{0x0000'2710'0000'0001}; // 1 + (10000 << 32)
+
+    chars -= 0x3030'3030'3030'3030;
+    chars = (chars * 10) + (chars >> 8);
+    chars = (((chars & mask) * mul1) + (((chars >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(chars);
+}
+
+/** Multiply two 64-bit integers into a 128-bit result.
+ *
+ * @return high, low
+ */
+[[nodiscard]] static std::pair<uint64_t, uint64_t> mul_64x64(uint64_t a, uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    auto const r = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<uint64_t>(r >> 64), static_cast<uint64_t>(r)};
+#else
+    auto const a_lo = a & 0xffff'ffff;
+    auto const a_hi = a >> 32;
+    auto const b_lo = b & 0xffff'ffff;
+    auto const b_hi = b >> 32;
+
+    auto const lo_lo = a_lo * b_lo;
+    auto const hi_lo = a_hi * b_lo;
+    auto const lo_hi = a_lo * b_hi;
+    auto const hi_hi = a_hi * b_hi;
+
+    auto const cross = (lo_lo >> 32) + (hi_lo & 0xffff'ffff) + lo_hi;
+    return {(hi_lo >> 32) + (cross >> 32) + hi_hi, (cross << 32) | (lo_lo & 0xffff'ffff)};
+#endif
+}
+
+/** Decode the digits of an integer literal.
+ *
+ * @tparam Radix The radix of the literal.
+ * @param p The first digit of the literal.
+ * @param last The end of the literal.
+ * @param max_value The largest value allowed.
+ * @return The value, or std::nullopt if the value is larger than @a max_value.
+ */
+template<unsigned int Radix>
+[[nodiscard]] static std::optional<uint64_t> decode_integer_digits(char const* p, char const* last, uint64_t max_value) noexcept
+{
+    // The number of digits that can not overflow an int64_t.
+    constexpr auto safe_digits = Radix == 2 ? 63 : Radix == 8 ? 21 : Radix == 10 ? 18 : 15;
+
+    auto digit = [](char c) -> uint8_t {
+        if constexpr (Radix == 16) {
+            return digit_value(c);
+        } else {
+            return static_cast<uint8_t>(c - '0');
+        }
+    };
+
+    auto value = uint64_t{};
+    if (last - p <= safe_digits) {
+        // Most literals are short enough to skip the overflow checks.
+        if constexpr (Radix == 10) {
+            for (; last - p >= 8 and is_eight_digits(load_eight_chars(p)); p += 8) {
+                value = value * 100'000'000 + parse_eight_digits(load_eight_chars(p));
+            }
+        }
+
+        for (; p != last; ++p) {
+            if (p[0] != '\'') {
+                assert(digit(p[0]) < Radix);
+                value = value * Radix + digit(p[0]);
+            }
+        }
+        return value;
+    }
+
+    auto const threshold = max_value / Radix;
+    auto const threshold_digit = max_value % Radix;
+
+    while (p != last) {
+        // Decode 8 decimal digits at a time, as long as this can not overflow.
+        if (Radix == 10 and last - p >= 8 and value < 10'000'000'000) {
+            auto const chars = load_eight_chars(p);
+            if (is_eight_digits(chars)) {
+                value = value * 100'000'000 + parse_eight_digits(chars);
+                p += 8;
+                continue;
+            }
+        }
+
+        if (p[0] != '\'') {
+            auto const d = digit(p[0]);
+            assert(d < Radix);
+
+            if (value > threshold or (value == threshold and d > threshold_digit)) {
+                return std::nullopt;
+            }
+            value = value * Radix + d;
+        }
+        ++p;
+    }
+    return value;
+}
+
+[[nodiscard]] std::optional<int64_t> decode_integer_literal(std::string_view text) noexcept
+{
+    auto p = text.data();
+    auto const last = p + text.size();
+    auto const [negative, radix] = parse_prefix(p, last);
+
+    auto const max_value = negative ? uint64_t{1} << 63 : uint64_t{std::numeric_limits<int64_t>::max()};
+
+    auto value = std::optional<uint64_t>{};
+    switch (radix) {
+    case 2:
+        value = decode_integer_digits<2>(p, last, max_value);
+        break;
+    case 8:
+        value = decode_integer_digits<8>(p, last, max_value);
+        break;
+    case 10:
+        value = decode_integer_digits<10>(p, last, max_value);
+        break;
+    case 16:
+        value = decode_integer_digits<16>(p, last, max_value);
+        break;
+    default:
+        std::unreachable();
+    }
+
+    if (not value) {
+        return std::nullopt;
+    } else if (negative) {
+        return static_cast<int64_t>(0 - *value);
+    } else {
+        return static_cast<int64_t>(*value);
+    }
+}
+
+[[nodiscard]] std::size_t integer_literal_max_limbs(std::string_view text) noexcept
+{
+    // Overestimate the number of bits with 4 bits per character; this
+    // includes the prefix and separators.
+    return (text.size() * 4 + 63) / 64 + 1;
+}
+
+[[nodiscard]] std::pair<bool, std::size_t> decode_integer_literal(std::string_view text, std::span<uint64_t> limbs) noexcept
+{
+    auto p = text.data();
+    auto const last = p + text.size();
+    auto const [negative, radix] = parse_prefix(p, last);
+
+    // The maximum number of digits of which the value and the multiplier fit
+    // in 64 bits.
+    auto const max_chunk_digits = radix == 2 ? 63 : radix == 8 ? 21 : radix == 10 ? 19 : 15;
+
+    auto size = 0uz;
+    auto mul_add = [&](uint64_t multiplier, uint64_t addend) {
+        auto carry = addend;
+        for (auto i = 0uz; i != size; ++i) {
+            auto [hi, lo] = mul_64x64(limbs[i], multiplier);
+            lo += carry;
+            hi += lo < carry ? 1 : 0;
+            limbs[i] = lo;
+            carry = hi;
+        }
+        if (carry != 0) {
+            assert(size < limbs.size());
+            limbs[size++] = carry;
+        }
+    };
+
+    auto chunk = uint64_t{};
+    auto chunk_multiplier = uint64_t{1};
+    auto chunk_digits = 0;
+    for (; p != last; ++p) {
+        if (p[0] == '\'') {
+            continue;
+        }
+
+        auto const d = digit_value(p[0]);
+        assert(d < radix);
+
+        chunk = chunk * radix + d;
+        chunk_multiplier *= radix;
+        if (++chunk_digits == max_chunk_digits) {
+            mul_add(chunk_multiplier, chunk);
+            chunk = 0;
+            chunk_multiplier = 1;
+            chunk_digits = 0;
+        }
+    }
+
+    if (chunk_digits != 0) {
+        mul_add(chunk_multiplier, chunk);
+    }
+
+    return {negative, size};
+}
+
+/** Convert a decimal float using the Eisel-Lemire algorithm.
+ *
+ * @param q The decimal exponent.
+ * @param w The decimal significand, non-zero.
+ * @return The bits of the positive double `w * 10^q`, or std::nullopt if the
+ *         algorithm could not determine the correctly rounded result.
+ */
+[[nodiscard]] static std::optional<uint64_t> eisel_lemire(int64_t q, uint64_t w) noexcept
+{
+    constexpr auto mantissa_bits = 52;
+    constexpr auto infinity = uint64_t{0x7ff} << mantissa_bits;
+
+    assert(w != 0);
+    if (q < smallest_power_of_five) {
+        return 0;
+    } else if (q > largest_power_of_five) {
+        return infinity;
+    }
+
+    auto const lz = std::countl_zero(w);
+    w <<= lz;
+
+    // A 64-bit product is enough for most values, only use the second half of
+    // the 128-bit power when the result is close to a rounding boundary.
+    auto const index = 2 * static_cast<std::size_t>(q - smallest_power_of_five);
+    auto [hi, lo] = mul_64x64(w, power_of_five_table[index]);
+
+    constexpr auto precision_mask = uint64_t{0xffff'ffff'ffff'ffff} >> (mantissa_bits + 3);
+    if ((hi & precision_mask) == precision_mask) {
+        auto const [hi2, lo2] = mul_64x64(w, power_of_five_table[index + 1]);
+        lo += hi2;
+        if (hi2 > lo) {
+            ++hi;
+        }
+    }
+
+    if (lo == 0xffff'ffff'ffff'ffff and (q < -27 or q > 55)) {
+        return std::nullopt;
+    }
+
+    auto const upper_bit = static_cast<int>(hi >> 63);
+    auto const shift = upper_bit + 64 - mantissa_bits - 3;
+    auto mantissa = hi >> shift;
+    // ((152170 + 65536) * q) >> 16 is floor(log2(10^q)).
+    auto power2 = static_cast<int32_t>((((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz + 1023);
+
+    if (power2 <= 0) {
+        // Subnormal.
+        if (-power2 + 1 >= 64) {
+            return 0;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        // Rounding may have turned the subnormal into the smallest normal.
+        return mantissa;
+    }
+
+    // Ties-to-even when the value is exactly between two doubles, which only
+    // happens for small exponents.
+    if (lo <= 1 and q >= -4 and q <= 23 and (mantissa & 3) == 1) {
+        if ((mantissa << shift) == hi) {
+            mantissa &= ~uint64_t{1};
+        }
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (uint64_t{2} << mantissa_bits)) {
+        mantissa = uint64_t{1} << mantissa_bits;
+        ++power2;
+    }
+    mantissa &= ~(uint64_t{1} << mantissa_bits);
+
+    if (power2 >= 0x7ff) {
+        return infinity;
+    }
+    return (static_cast<uint64_t>(power2) << mantissa_bits) | mantissa;
+}
+
+/** Decode a float literal with `std::from_chars()`.
+ *
+ * This is the slow path, it copies the literal without the separators and
+ * prefix.
+ *
+ * @param p The literal after the sign and radix prefix.
+ * @param last The end of the literal.
+ * @return The positive value.
+ */
+[[nodiscard]] static double decode_float_slow(char const* p, char const* last) noexcept
+{
+    auto tmp = std::string{};
+    tmp.reserve(last - p);
+    for (; p != last; ++p) {
+        if (p[0] != '\'') {
+            tmp += p[0];
+        }
+    }
+
+    auto r = 0.0;
+    if (std::from_chars(tmp.data(), tmp.data() + tmp.size(), r).ec == std::errc::result_out_of_range) {
+        // from_chars() does not set the value on overflow or underflow.
+        return std::strtod(tmp.c_str(), nullptr);
+    }
+    return r;
+}
+
+/** Decode a float literal in radix 2, 8 or 16.
+ *
+ * @param p The literal after the sign and radix prefix.
+ * @param last The end of the literal.
+ * @param radix The radix of the literal.
+ * @return The positive value.
+ */
+[[nodiscard]] static double decode_binary_float(char const* p, char const* last, unsigned int radix) noexcept
+{
+    auto const bits_per_digit = std::countr_zero(radix);
+
+    auto mantissa = uint64_t{};
+    auto exponent = int64_t{};
+    auto sticky = false;
+    auto fraction = false;
+    for (; p != last; ++p) {
+        if (p[0] == '\'') {
+            continue;
+        } else if (p[0] == '.') {
+            fraction = true;
+            continue;
+        } else if (radix == 16 ? (p[0] == 'p' or p[0] == 'P') : (p[0] == 'e' or p[0] == 'E')) {
+            ++p;
+            exponent += parse_exponent(p, last);
+            break;
+        }
+
+        auto const d = digit_value(p[0]);
+        assert(d < radix);
+
+        if ((mantissa >> (64 - bits_per_digit)) == 0) {
+            mantissa = (mantissa << bits_per_digit) | d;
+            exponent -= fraction ? bits_per_digit : 0;
+        } else {
+            // The mantissa has more than 60 significant bits, the rest of the
+            // digits only influence rounding.
+            sticky |= d != 0;
+            exponent += fraction ? 0 : bits_per_digit;
+        }
+    }
+
+    if (mantissa == 0) {
+        return 0.0;
+    }
+
+    auto const value = static_cast<double>(mantissa | (sticky ? 1 : 0));
+    return std::ldexp(value, static_cast<int>(std::clamp(exponent, int64_t{-4000}, int64_t{4000})));
+}
+
+/** Scan a decimal float literal.
+ *
+ * @param p The literal after the sign and radix prefix.
+ * @param last The end of the literal.
+ * @return The first 19 significant digits w, the decimal exponent q so that
+ *         the value is about w * 10^q, and if non-zero digits were dropped.
+ */
+[[nodiscard]] static std::tuple<uint64_t, int64_t, bool> scan_decimal_float(char const* p, char const* last) noexcept
+{
+    constexpr auto max_digits = 19;
+
+    auto const first = p;
+    auto w = uint64_t{};
+    auto num_digits = 0;
+    auto q = int64_t{};
+
+    // Fast scan, which assumes that there are no more than 19 digits.
+    auto scan_digits = [&] {
+        while (p != last) {
+            if (last - p >= 8) {
+                auto const chars = load_eight_chars(p);
+                if (is_eight_digits(chars)) {
+                    w = w * 100'000'000 + parse_eight_digits(chars);
+                    num_digits += 8;
+                    p += 8;
+                    continue;
+                }
+            }
+
+            auto const d = static_cast<uint8_t>(p[0] - '0');
+            if (d < 10) {
+                w = w * 10 + d;
+                ++num_digits;
+            } else if (p[0] != '\'') {
+                break;
+            }
+            ++p;
+        }
+    };
+
+    scan_digits();
+    if (p != last and p[0] == '.') {
+        ++p;
+        auto const num_integer_digits = num_digits;
+        scan_digits();
+        q -= num_digits - num_integer_digits;
+    }
+    if (p != last) {
+        assert(p[0] == 'e' or p[0] == 'E');
+        ++p;
+        q += parse_exponent(p, last);
+    }
+
+    if (num_digits <= max_digits) {
+        return {w, q, false};
+    }
+
+    // Slow scan, for literals with many digits, which may only be leading
+    // zeros.
+    p = first;
+    w = 0;
+    num_digits = 0;
+    q = 0;
+    auto truncated = false;
+    auto fraction = false;
+    for (; p != last; ++p) {
+        if (p[0] == '\'') {
+            continue;
+        } else if (p[0] == '.') {
+            fraction = true;
+            continue;
+        } else if (p[0] == 'e' or p[0] == 'E') {
+            ++p;
+            q += parse_exponent(p, last);
+            break;
+        }
+
+        auto const d = static_cast<uint8_t>(p[0] - '0');
+        assert(d < 10);
+
+        if (num_digits < max_digits) {
+            w = w * 10 + d;
+            // Leading zeros are not counted as significant digits.
+            num_digits += w == 0 ? 0 : 1;
+            q -= fraction ? 1 : 0;
+        } else {
+            truncated |= d != 0;
+            q += fraction ? 0 : 1;
+        }
+    }
+
+    return {w, q, truncated};
+}
+
+[[nodiscard]] double decode_float_literal(std::string_view text) noexcept
+{
+    constexpr auto powers_of_ten = std::array<double, 23>{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    auto p = text.data();
+    auto const last = p + text.size();
+    auto const [negative, radix] = parse_prefix(p, last);
+    auto const sign = negative ? -1.0 : 1.0;
+
+    if (radix != 10) {
+        return sign * decode_binary_float(p, last, radix);
+    }
+
+    auto const first = p;
+    auto [w, q, truncated] = scan_decimal_float(p, last);
+    if (truncated) {
+        // The value is between w * 10^q and (w + 1) * 10^q, if both round to
+        // the same double then that is the result.
+        auto const lower = eisel_lemire(q, w);
+        auto const upper = eisel_lemire(q, w + 1);
+        if (lower and upper and *lower == *upper) {
+            return sign * std::bit_cast<double>(*lower);
+        }
+        return sign * decode_float_slow(first, last);
+    }
+
+    if (w == 0) {
+        return sign * 0.0;
+    }
+
+    // Clinger's fast path: both w and 10^q are exact doubles, so a single
+    // multiplication or division is correctly rounded.
+    if (q >= -22 and q <= 22 and w <= (uint64_t{1} << 53)) {
+        auto const value = static_cast<double>(w);
+        return sign * (q < 0 ? value / powers_of_ten[-q] : value * powers_of_ten[q]);
+    }
+
+    if (auto const bits = eisel_lemire(q, w)) {
+        return sign * std::bit_cast<double>(*bits);
+    }
+
+    return sign * decode_float_slow(first, last);
+}
+
+[[nodiscard]] semantic_version decode_version_literal(std::string_view text) noexcept
+{
+    auto p = text.data();
+    auto const last = p + text.size();
+    if (p != last and (p[0] == '+' or p[0] == '-')) {
+        ++p;
+    }
+
+    auto component = [&] {
+        auto r = std::numeric_limits<std::size_t>::max();
+        if (p != last and p[0] == '*') {
+            ++p;
+        } else {
+            r = 0;
+            for (; p != last and p[0] != '.'; ++p) {
+                if (p[0] != '\'') {
+                    r = r * 10 + static_cast<std::size_t>(p[0] - '0');
+                }
+            }
+        }
+
+        if (p != last) {
+            assert(p[0] == '.');
+            ++p;
+        }
+        return r;
+    };
+
+    auto const major = component();
+    auto const minor = component();
+    auto const patch = component();
+    return semantic_version{major, minor, patch};
+}
+
+} // namespace hk
@@ -0,0 +1,74 @@
+
+#pragma once
+
+#include "utility/semantic_version.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+/** @file decode_number.hpp
+ *
+ * Decode the value of number literals found by `tokenize_number()`.
+ *
+ * The decoders work directly on the text of the token, without copying or
+ * allocating. The text must be a literal as accepted by `tokenize_number()`:
+ *  - An optional sign `+` or `-`.
+ *  - An optional radix prefix `0b`, `0o`, `0d` or `0x`.
+ *  - Digits in the radix, which may be separated by `'`.
+ *  - For floats an optional fraction, and an optional exponent. The exponent
+ *    prefix is `p` for radix 16 and `e` otherwise. The exponent is a power of
+ *    10 for radix 10 and a power of 2 for the other radices.
+ */
+
+namespace hk {
+
+/** Decode an integer literal that fits in a 64-bit signed integer.
+ *
+ * @param text The text of an integer literal.
+ * @return The value, or std::nullopt if the value does not fit in int64_t.
+ */
+[[nodiscard]] std::optional<int64_t> decode_integer_literal(std::string_view text) noexcept;
+
+/** The maximum number of limbs needed to decode an integer literal.
+ *
+ * @param text The text of an integer literal.
+ * @return The size of the span to pass to `decode_integer_literal(text, limbs)`.
+ */
+[[nodiscard]] std::size_t integer_literal_max_limbs(std::string_view text) noexcept;
+
+/** Decode an integer literal of any size.
+ *
+ * The magnitude is written as 64-bit limbs with the least significant limb
+ * first, the same layout as `builtin::long_int`.
+ *
+ * @param text The text of an integer literal.
+ * @param limbs The limbs to write to, at least `integer_literal_max_limbs(text)`
+ *              in size.
+ * @return Whether the value is negative, and the number of significant limbs
+ *         written.
+ */
+[[nodiscard]] std::pair<bool, std::size_t> decode_integer_literal(std::string_view text, std::span<uint64_t> limbs) noexcept;
+
+/** Decode a float literal.
+ *
+ * Decimal literals with up to 19 significant digits are converted with the
+ * Clinger fast path or the Eisel-Lemire algorithm. Longer literals and the
+ * rare ambiguous cases fall back to `std::from_chars()`. The result is
+ * correctly rounded.
+ *
+ * @param text The text of a float literal, or of an integer literal.
+ * @return The value, which may be infinite if the value is too large.
+ */
+[[nodiscard]] double decode_float_literal(std::string_view text) noexcept;
+
+/** Decode a version literal.
+ *
+ * @param text The text of a version literal, like `1.2.3`, `1.2.*` or `1.*.*`.
+ * @return The semantic version, with wild cards for `*`.
+ */
+[[nodiscard]] semantic_version decode_version_literal(std::string_view text) noexcept;
+
+} // namespace hk
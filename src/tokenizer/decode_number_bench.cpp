@@ -0,0 +1,157 @@
+
+#include "decode_number.hpp"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+enum class literal_kind {
+    short_decimal,
+    long_decimal,
+    separated_decimal,
+    hexadecimal,
+    simple_float,
+    long_float,
+};
+
+/** 1024 literals of the same kind, with random digits.
+ */
+[[nodiscard]] std::vector<std::string> make_literals(literal_kind kind)
+{
+    auto engine = std::mt19937_64{1};
+
+    auto r = std::vector<std::string>{};
+    r.reserve(1024);
+    for (auto i = 0uz; i != 1024; ++i) {
+        auto const value = engine();
+        switch (kind) {
+        case literal_kind::short_decimal:
+            r.push_back(std::format("{}", value % 1000));
+            break;
+        case literal_kind::long_decimal:
+            r.push_back(std::format("{}", value >> 1));
+            break;
+        case literal_kind::separated_decimal:
+            r.push_back(std::format("{}'{:03}'{:03}", value % 1000, (value >> 10) % 1000, (value >> 20) % 1000));
+            break;
+        case literal_kind::hexadecimal:
+            r.push_back(std::format("0x{:x}", value >> 1));
+            break;
+        case literal_kind::simple_float:
+            r.push_back(std::format("{}.{}", value % 1000, (value >> 10) % 100));
+            break;
+        case literal_kind::long_float:
+            r.push_back(std::format("{}.{}e{}", (value >> 32) % 100'000'000, value % 100'000'000, static_cast<int>((value >> 20) % 600) - 300));
+            break;
+        }
+    }
+    return r;
+}
+
+[[nodiscard]] int64_t total_size(std::vector<std::string> const& literals)
+{
+    auto r = int64_t{0};
+    for (auto const& literal : literals) {
+        r += static_cast<int64_t>(literal.size());
+    }
+    return r;
+}
+
+void bm_decode_integer_literal(benchmark::State& state, literal_kind kind)
+{
+    auto const literals = make_literals(kind);
+
+    for (auto _ : state) {
+        for (auto const& literal : literals) {
+            benchmark::DoNotOptimize(hk::decode_integer_literal(literal));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(literals.size()));
+    state.SetBytesProcessed(state.iterations() * total_size(literals));
+}
+
+void bm_decode_integer_literal_limbs(benchmark::State& state, literal_kind kind)
+{
+    auto const literals = make_literals(kind);
+    auto limbs = std::array<uint64_t, 4>{};
+
+    for (auto _ : state) {
+        for (auto const& literal : literals) {
+            benchmark::DoNotOptimize(hk::decode_integer_literal(literal, limbs));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(literals.size()));
+}
+
+/** The baseline for decoding decimal integers.
+ */
+void bm_from_chars_integer(benchmark::State& state, literal_kind kind)
+{
+    auto const literals = make_literals(kind);
+
+    for (auto _ : state) {
+        for (auto const& literal : literals) {
+            auto value = int64_t{};
+            benchmark::DoNotOptimize(std::from_chars(literal.data(), literal.data() + literal.size(), value));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(literals.size()));
+    state.SetBytesProcessed(state.iterations() * total_size(literals));
+}
+
+void bm_decode_float_literal(benchmark::State& state, literal_kind kind)
+{
+    auto const literals = make_literals(kind);
+
+    for (auto _ : state) {
+        for (auto const& literal : literals) {
+            benchmark::DoNotOptimize(hk::decode_float_literal(literal));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(literals.size()));
+    state.SetBytesProcessed(state.iterations() * total_size(literals));
+}
+
+/** The baseline for decoding decimal floats.
+ */
+void bm_from_chars_float(benchmark::State& state, literal_kind kind)
+{
+    auto const literals = make_literals(kind);
+
+    for (auto _ : state) {
+        for (auto const& literal : literals) {
+            auto value = double{};
+            benchmark::DoNotOptimize(std::from_chars(literal.data(), literal.data() + literal.size(), value));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(literals.size()));
+    state.SetBytesProcessed(state.iterations() * total_size(literals));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(bm_decode_integer_literal, short_decimal, literal_kind::short_decimal);
+BENCHMARK_CAPTURE(bm_decode_integer_literal, long_decimal, literal_kind::long_decimal);
+BENCHMARK_CAPTURE(bm_decode_integer_literal, separated_decimal, literal_kind::separated_decimal);
+BENCHMARK_CAPTURE(bm_decode_integer_literal, hexadecimal, literal_kind::hexadecimal);
+BENCHMARK_CAPTURE(bm_decode_integer_literal_limbs, long_decimal, literal_kind::long_decimal);
+BENCHMARK_CAPTURE(bm_from_chars_integer, short_decimal, literal_kind::short_decimal);
+BENCHMARK_CAPTURE(bm_from_chars_integer, long_decimal, literal_kind::long_decimal);
+BENCHMARK_CAPTURE(bm_decode_float_literal, simple_float, literal_kind::simple_float);
+BENCHMARK_CAPTURE(bm_decode_float_literal, long_float, literal_kind::long_float);
+BENCHMARK_CAPTURE(bm_from_chars_float, simple_float, literal_kind::simple_float);
+BENCHMARK_CAPTURE(bm_from_chars_float, long_float, literal_kind::long_float);
@@ -0,0 +1,119 @@
+
+#include "decode_number.hpp"
+#include <hikotest/hikotest.hpp>
+#include <array>
+#include <cmath>
+#include <limits>
+
+TEST_SUITE(decode_number_suite)
+{
+
+TEST_CASE(integer_radix)
+{
+    REQUIRE(hk::decode_integer_literal("0") == 0);
+    REQUIRE(hk::decode_integer_literal("12") == 12);
+    REQUIRE(hk::decode_integer_literal("-12") == -12);
+    REQUIRE(hk::decode_integer_literal("+12") == 12);
+    REQUIRE(hk::decode_integer_literal("0b1010") == 10);
+    REQUIRE(hk::decode_integer_literal("0o777") == 511);
+    REQUIRE(hk::decode_integer_literal("0d99") == 99);
+    REQUIRE(hk::decode_integer_literal("0xdeadBEEF") == 0xdead'beef);
+    REQUIRE(hk::decode_integer_literal("-0x10") == -16);
+}
+
+TEST_CASE(integer_separators)
+{
+    REQUIRE(hk::decode_integer_literal("1'000'000") == 1'000'000);
+    REQUIRE(hk::decode_integer_literal("1234'5678'9012'3456") == 1234'5678'9012'3456);
+    REQUIRE(hk::decode_integer_literal("0b1111'0000") == 0xf0);
+}
+
+TEST_CASE(integer_overflow)
+{
+    REQUIRE(hk::decode_integer_literal("9223372036854775807") == std::numeric_limits<int64_t>::max());
+    REQUIRE(hk::decode_integer_literal("-9223372036854775808") == std::numeric_limits<int64_t>::min());
+    REQUIRE(not hk::decode_integer_literal("9223372036854775808"));
+    REQUIRE(not hk::decode_integer_literal("-9223372036854775809"));
+    REQUIRE(not hk::decode_integer_literal("100000000000000000000"));
+    REQUIRE(hk::decode_integer_literal("0x7fff'ffff'ffff'ffff") == std::numeric_limits<int64_t>::max());
+    REQUIRE(not hk::decode_integer_literal("0x8000'0000'0000'0000"));
+}
+
+TEST_CASE(integer_limbs)
+{
+    auto const text = std::string_view{"-340282366920938463463374607431768211457"}; // -(2^128 + 1)
+    auto limbs = std::array<uint64_t, 8>{};
+    REQUIRE(hk::integer_literal_max_limbs(text) <= limbs.size());
+
+    auto const [negative, size] = hk::decode_integer_literal(text, limbs);
+    REQUIRE(negative);
+    REQUIRE(size == 3);
+    REQUIRE(limbs[0] == 1);
+    REQUIRE(limbs[1] == 0);
+    REQUIRE(limbs[2] == 1);
+}
+
+TEST_CASE(integer_limbs_hex)
+{
+    auto const text = std::string_view{"0x1234'5678'9abc'def0'0fed'cba9'8765'4321"};
+    auto limbs = std::array<uint64_t, 8>{};
+    auto const [negative, size] = hk::decode_integer_literal(text, limbs);
+    REQUIRE(not negative);
+    REQUIRE(size == 2);
+    REQUIRE(limbs[0] == 0x0fed'cba9'8765'4321);
+    REQUIRE(limbs[1] == 0x1234'5678'9abc'def0);
+}
+
+TEST_CASE(float_decimal)
+{
+    REQUIRE(hk::decode_float_literal("0.0") == 0.0);
+    REQUIRE(std::signbit(hk::decode_float_literal("-0.0")));
+    REQUIRE(hk::decode_float_literal("1.5") == 1.5);
+    REQUIRE(hk::decode_float_literal("-2.25") == -2.25);
+    REQUIRE(hk::decode_float_literal(".5") == 0.5);
+    REQUIRE(hk::decode_float_literal("0.1") == 0.1);
+    REQUIRE(hk::decode_float_literal("3.141592653589793") == 3.141592653589793);
+    REQUIRE(hk::decode_float_literal("1'000.000'1") == 1000.0001);
+    REQUIRE(hk::decode_float_literal("12") == 12.0);
+}
+
+TEST_CASE(float_exponent)
+{
+    REQUIRE(hk::decode_float_literal("1e10") == 1e10);
+    REQUIRE(hk::decode_float_literal("1.5e-7") == 1.5e-7);
+    REQUIRE(hk::decode_float_literal("6.02214076e23") == 6.02214076e23);
+    REQUIRE(hk::decode_float_literal("1.7976931348623157e308") == std::numeric_limits<double>::max());
+    REQUIRE(hk::decode_float_literal("2.2250738585072014e-308") == std::numeric_limits<double>::min());
+    REQUIRE(hk::decode_float_literal("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+    REQUIRE(hk::decode_float_literal("1e309") == std::numeric_limits<double>::infinity());
+    REQUIRE(hk::decode_float_literal("1e-400") == 0.0);
+}
+
+TEST_CASE(float_many_digits)
+{
+    REQUIRE(hk::decode_float_literal("0.1000000000000000055511151231257827021181583404541015625") == 0.1);
+    REQUIRE(hk::decode_float_literal("123456789012345678901234567890") == 123456789012345678901234567890.0);
+    // Exactly halfway between two doubles; ties to even.
+    REQUIRE(hk::decode_float_literal("9007199254740993") == 9007199254740992.0);
+    REQUIRE(hk::decode_float_literal("9007199254740993.0000000000000000001") == 9007199254740994.0);
+}
+
+TEST_CASE(float_binary)
+{
+    REQUIRE(hk::decode_float_literal("0x1.8p1") == 3.0);
+    REQUIRE(hk::decode_float_literal("0x1p-2") == 0.25);
+    REQUIRE(hk::decode_float_literal("0b1.01") == 1.25);
+    REQUIRE(hk::decode_float_literal("0o0.4") == 0.5);
+    REQUIRE(hk::decode_float_literal("-0x10.0") == -16.0);
+}
+
+TEST_CASE(version)
+{
+    REQUIRE(hk::decode_version_literal("1.2.3") == hk::semantic_version(1, 2, 3));
+    REQUIRE(hk::decode_version_literal("10.20.30") == hk::semantic_version(10, 20, 30));
+    REQUIRE(hk::decode_version_literal("1.2.*") == hk::semantic_version(1, 2));
+    REQUIRE(hk::decode_version_literal("1.*.*") == hk::semantic_version(1));
+    REQUIRE(hk::decode_version_literal("2'024.1.0") == hk::semantic_version(2024, 1, 0));
+}
+
+};
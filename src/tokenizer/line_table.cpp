@@ -27,13 +27,13 @@ namespace hk {
             ++p;
 
         } else {
-            auto const [cp, n] = get_cp(first);
+            auto const [cp, n] = get_cp(p);
 
             if (match<char32_t, U'\u0085', U'\u2028', U'\u2029'>(cp)) {
                 ++line;
                 column = 0;
 
-            } if (cp >= 0x01'0000) {
+            } else if (cp >= 0x01'0000) {
                 // code-point is encoded as a surrogate pair in UTF-16.
                 column += 2;
 
@@ -49,9 +49,28 @@ namespace hk {
     return {line, column};
 }
 
+/** Count the lines and columns in a text that only contains ASCII characters.
+ *
+ * @see count_position()
+ */
+[[nodiscard]] static std::pair<uint32_t, uint32_t> count_ascii_position(char const *first, char const *last) noexcept
+{
+    uint32_t line = 0;
+    auto start_of_line = first;
+
+    for (auto p = first; p < last; ++p) {
+        auto const is_vertical_space = match<char, '\n', '\v', '\f'>(p[0]) or (p[0] == '\r' and p[1] != '\n');
+        line += is_vertical_space;
+        start_of_line = is_vertical_space ? p + 1 : start_of_line;
+    }
+
+    return {line, static_cast<uint32_t>(last - start_of_line)};
+}
+
 void line_table::clear()
 {
     _sync_points.clear();
+    _ascii = false;
 }
 
 
@@ -98,7 +117,7 @@ void line_table::clear()
             // Found a single character vertical space.
             return p;
 
-        } else if (c >= 0xc0) {
+        } else if ((c & 0xc0) == 0x80) {
             // Skip continuation bytes.
 
         } else if (c >= 0x80) {
@@ -118,45 +137,72 @@ void line_table::clear()
 {
     auto const first_on_line = rfind_vertical_space(first, p);
     auto const last_on_line = find_vertical_space(last, p);
-    return std::string_view{first, last};
+    return std::string_view{first_on_line, last_on_line};
 }
 
 [[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string_view> line_table::get_position(char const* p) const
+{
+    auto cache = position_cache{};
+    return get_position(p, cache);
+}
+
+[[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string_view> line_table::get_position(char const* p, position_cache& cache) const
 {
     assert(p != nullptr);    
     assert(not _sync_points.empty());
 
-    auto const it = std::lower_bound(_sync_points.begin(), _sync_points.end(), p, [](auto const& a, char const* x) {
-        return a.p < x;
+    // Find the sync point at or before p.
+    auto it = std::upper_bound(_sync_points.begin(), _sync_points.end(), p, [](char const* x, auto const& a) {
+        return x < a.p;
     });
+    assert(it != _sync_points.begin());
+    --it;
 
-    assert(it != _sync_points.end());
+    if (it->kind == sync_type::eof and it != _sync_points.begin()) {
+        // The end of a file is located on the last line of that file.
+        --it;
+    }
     assert(it->kind != sync_type::eof);
 
-    auto const [extra_lines, column] = count_position(it->p, p);
+    auto const index = static_cast<std::size_t>(std::distance(_sync_points.begin(), it));
+    if (cache.p == nullptr or cache.sync_index != index or cache.p > p) {
+        cache = position_cache{it->p, index, it->line, 0};
+    }
+
+    // Only count the characters between the previous position and p.
+    auto const [extra_lines, column] = _ascii ? count_ascii_position(cache.p, p) : count_position(cache.p, p);
+    cache.p = p;
+    cache.line += extra_lines;
+    cache.column = extra_lines == 0 ? cache.column + column : column;
 
     auto const first = it->p;
-    auto const last = (it + 1)->p;
+    auto const last = it + 1 != _sync_points.end() ? (it + 1)->p : p;
     auto const line_text = get_line_text(first, last, p);
 
-    return {it->path, it->line + extra_lines, column, line_text};
+    return {it->path, cache.line, cache.column, line_text};
 }
 
 [[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string> line_table::get_error_location(
         char const *first, char const *last) const
 {
-    auto const [first_path, first_lineno, first_column, first_line] = get_position(first);
+    auto cache = position_cache{};
+    return get_error_location(first, last, cache);
+}
 
-    auto r = std::format("{:5} | {}\n", first_lineno, first_line);
+[[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string> line_table::get_error_location(
+        char const *first, char const *last, position_cache& cache) const
+{
+    auto const [first_path, first_lineno, first_column, first_line] = get_position(first, cache);
+
+    auto r = std::format("{:5} | {}\n", first_lineno + 1, first_line);
 
     r += "      | ";
     r += std::string(first_column, ' ');
     r += '^';
     if (last != nullptr) {
-        auto const [last_path, last_lineno, last_column, last_line] = get_position(last);
-        if (first_path == last_path and first_lineno == last_lineno) {
-            assert(first_column <= last_column);
-
+        auto last_cache = cache;
+        auto const [last_path, last_lineno, last_column, last_line] = get_position(last, last_cache);
+        if (first_path == last_path and first_lineno == last_lineno and first_column < last_column) {
             r += std::string(last_column - first_column - 1, '~');
         }
     }
@@ -180,7 +226,7 @@ void line_table::add(char const* p, std::string_view path, uint32_t line, sync_t
         path = (it - 1)->path;
     }
 
-    if (it->p == p) {
+    if (it != _sync_points.end() and it->p == p) {
         // Duplicates are ignored, so that a file may be parsed twice.
         assert(it->path == path and it->line == line and it->kind == kind);
         return;
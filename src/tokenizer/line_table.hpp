@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 #include <tuple>
+#include <cstddef>
+#include <cstdint>
 
 namespace hk {
 
@@ -21,6 +23,25 @@ public:
 
     constexpr line_table() = default;
 
+    /** Cache of the last position found by `get_position()`.
+     *
+     * When positions are requested in increasing order, for example for a
+     * sorted list of errors, only the characters between the previous and
+     * the next position are counted.
+     */
+    struct position_cache {
+        /** The character pointer of the cached position, or nullptr.
+         */
+        char const* p = nullptr;
+
+        /** Index of the sync point from which the position was counted.
+         */
+        std::size_t sync_index = 0;
+
+        uint32_t line = 0;
+        uint32_t column = 0;
+    };
+
     /** Clear the line table.
      */
     void clear();
@@ -34,6 +55,14 @@ public:
      */
     [[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string_view> get_position(char const *p) const;
 
+    /** Get the source position.
+     *
+     * @param p The character pointer for which the position is needed.
+     * @param cache The cache of the previous position, updated to @a p.
+     * @return source file name, line number, utf-16 column number, the text of the line where the character is located.
+     */
+    [[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string_view> get_position(char const *p, position_cache& cache) const;
+
     /** Get the location of an error.
      * 
      * The textual location are two lines of text, showing graphically where
@@ -48,6 +77,16 @@ public:
     [[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string> get_error_location(
         char const *first, char const *last=nullptr) const;
 
+    /** Get the location of an error.
+     *
+     * @param first Pointer to the first character of a the first token.
+     * @param last Pointer beyond the last character of the last token, or nullptr.
+     * @param cache The cache of the previous position, updated to @a first.
+     * @return path to the source, line number, utf-16 column number, textual location.
+     */
+    [[nodiscard]] std::tuple<interned_string, uint32_t, uint32_t, std::string> get_error_location(
+        char const *first, char const *last, position_cache& cache) const;
+
     void add(char const* p, std::string_view path, uint32_t line, sync_type kind);
 
     /** Start a file.
@@ -61,6 +100,29 @@ public:
 
     void add_sol(char const *p, std::string_view path, uint32_t line);
 
+    /** The path of the first file in the line table.
+     */
+    [[nodiscard]] interned_string path() const noexcept
+    {
+        return _sync_points.empty() ? interned_string{} : _sync_points.front().path;
+    }
+
+    /** The text described by this line table only contains ASCII characters.
+     */
+    [[nodiscard]] bool ascii() const noexcept
+    {
+        return _ascii;
+    }
+
+    /** Mark the text as only containing ASCII characters.
+     *
+     * @see validate_utf8()
+     * @param ascii True if the text only contains ASCII characters.
+     */
+    void set_ascii(bool ascii) noexcept
+    {
+        _ascii = ascii;
+    }
 
 private:
     struct sync_point_type {
@@ -84,6 +146,10 @@ private:
     /** The list of line synchronization points.
      */
     std::vector<sync_point_type> _sync_points = {};
+
+    /** The text only contains ASCII characters.
+     */
+    bool _ascii = false;
 };
 
 }
@@ -0,0 +1,75 @@
+
+#include "line_table.hpp"
+#include "bench_utilities/corpus.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** Pointers into a generated module of `state.range(0)` declarations.
+ *
+ * @param text The text of the module.
+ * @param sorted Return the positions in increasing order, like a sorted error list.
+ */
+[[nodiscard]] std::vector<char const*> make_positions(std::string const& text, bool sorted)
+{
+    auto engine = std::mt19937_64{1};
+
+    auto r = std::vector<char const*>{};
+    r.reserve(1024);
+    for (auto i = 0uz; i != 1024; ++i) {
+        r.push_back(text.data() + engine() % (text.size() - 8));
+    }
+
+    if (sorted) {
+        std::ranges::sort(r);
+    }
+    return r;
+}
+
+void bm_line_table_get_position(benchmark::State& state)
+{
+    auto options = bench::corpus_options{};
+    options.num_declarations = static_cast<std::size_t>(state.range(0));
+    auto const text = bench::pad_source_code(bench::generate_module("bench.line_table", options));
+
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<bench>");
+    auto const positions = make_positions(text, false);
+
+    for (auto _ : state) {
+        for (auto p : positions) {
+            benchmark::DoNotOptimize(lines.get_position(p));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(positions.size()));
+}
+
+void bm_line_table_get_position_sorted(benchmark::State& state)
+{
+    auto options = bench::corpus_options{};
+    options.num_declarations = static_cast<std::size_t>(state.range(0));
+    auto const text = bench::pad_source_code(bench::generate_module("bench.line_table", options));
+
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<bench>");
+    auto const positions = make_positions(text, true);
+
+    for (auto _ : state) {
+        auto cache = hk::line_table::position_cache{};
+        for (auto p : positions) {
+            benchmark::DoNotOptimize(lines.get_position(p, cache));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(positions.size()));
+}
+
+} // namespace
+
+BENCHMARK(bm_line_table_get_position)->Arg(16)->Arg(256);
+BENCHMARK(bm_line_table_get_position_sorted)->Arg(16)->Arg(256)->Arg(4096);
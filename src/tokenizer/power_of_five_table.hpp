@@ -0,0 +1,29 @@
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hk {
+
+/** The smallest power of five in the power-of-five table.
+ */
+constexpr auto smallest_power_of_five = -342;
+
+/** The largest power of five in the power-of-five table.
+ */
+constexpr auto largest_power_of_five = 308;
+
+/** The number of 64-bit words in the power-of-five table.
+ */
+constexpr auto power_of_five_table_size = 2uz * (largest_power_of_five - smallest_power_of_five + 1);
+
+/** The 128-bit normalized significands of 5^q for q in [-342, 308].
+ *
+ * Each power is stored as two 64-bit words, high word first. This table is used
+ * by the Eisel-Lemire algorithm in `decode_float_literal()`.
+ */
+extern std::array<uint64_t, power_of_five_table_size> const power_of_five_table;
+
+} // namespace hk
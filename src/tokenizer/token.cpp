@@ -2,12 +2,19 @@
 #include "token.hpp"
 #include <charconv>
 #include <cassert>
+#include <array>
+#include <functional>
 
 namespace hk {
 
-[[nodiscard]] std::expected<std::string, utf8_security_error> token::identifier_value() const
+/** Normalize and security check a non-ASCII identifier.
+ *
+ * @param text The text of the identifier.
+ * @return A NFC normalized UTF-8 string, or a security error.
+ */
+[[nodiscard]] static std::expected<std::string, utf8_security_error> normalize_identifier(std::string_view text)
 {
-    auto normalized_text = normalize_utf8_string(string());
+    auto normalized_text = normalize_utf8_string(std::string{text});
     if (not normalized_text) {
         return std::unexpected{utf8_security_error::unknown_error};
     }
@@ -19,20 +26,48 @@ namespace hk {
     return std::move(normalized_text).value();
 }
 
-[[nodiscard]] std::expected<std::string, utf8_security_error> token::operator_value() const
+/** Normalize and security check a non-ASCII identifier, with caching.
+ *
+ * The same identifier is often used many times in a file, the result of
+ * recently normalized identifiers is stored in a small direct-mapped
+ * per-thread cache, so that the expensive ICU functions are called once.
+ *
+ * @param text The text of the identifier.
+ * @return A NFC normalized UTF-8 string, or a security error.
+ */
+[[nodiscard]] static std::expected<std::string, utf8_security_error> cached_normalize_identifier(std::string_view text)
 {
-    return identifier_value();
+    struct cache_entry_type {
+        std::string key = {};
+        std::expected<std::string, utf8_security_error> value = std::string{};
+    };
+
+    constexpr auto cache_size = 256uz;
+    thread_local auto cache = std::array<cache_entry_type, cache_size>{};
+
+    auto& entry = cache[std::hash<std::string_view>{}(text) % cache_size];
+    if (entry.key != text) {
+        entry.value = normalize_identifier(text);
+        entry.key = text;
+    }
+
+    return entry.value;
 }
 
-[[nodiscard]] long long token::integer_value() const
+[[nodiscard]] std::expected<std::string, utf8_security_error> token::identifier_value() const
 {
-    assert(_kind == integer_literal);
+    auto const text = string_view();
+    if (is_ascii(text)) {
+        // ASCII is always in NFC and always passes the security check.
+        return std::string{text};
+    }
 
-    long long x = 0;
-    auto const fcr = std::from_chars(begin(), end(), x, 10);
-    assert(fcr.ptr == end());
+    return cached_normalize_identifier(text);
+}
 
-    return x;
+[[nodiscard]] std::expected<std::string, utf8_security_error> token::operator_value() const
+{
+    return identifier_value();
 }
 
 [[nodiscard]] std::pair<size_t, std::string> token::line_value() const
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include "decode_number.hpp"
 #include "utility/unicode.hpp"
 #include "utility/semantic_version.hpp"
 #include <gsl/gsl>
@@ -308,9 +309,26 @@ public:
 
     /** Get integer value.
      * 
-     * @return The integer representation of the integer value.
+     * @note It is UNDEFINED BEHAVIOR to call this function if the token is not an integer literal.
+     * @return The integer representation of the integer value, or zero if
+     *         the value does not fit in 64 bits.
      */
-    [[nodiscard]] long long integer_value() const;
+    [[nodiscard]] long long integer_value() const
+    {
+        assert(_kind == kind_type::integer_literal);
+        return decode_integer_literal(string_view()).value_or(0);
+    }
+
+    /** Get the float value.
+     *
+     * @note It is UNDEFINED BEHAVIOR to call this function if the token is not a float or integer literal.
+     * @return The correctly rounded value of the literal.
+     */
+    [[nodiscard]] double float_value() const
+    {
+        assert(_kind == kind_type::float_literal or _kind == kind_type::integer_literal);
+        return decode_float_literal(string_view());
+    }
 
     /** Convert a version token to its semantic version value.
      * 
@@ -320,7 +338,7 @@ public:
     [[nodiscard]] semantic_version version_value() const
     {
         assert(_kind == kind_type::version_literal);
-        return semantic_version{string_view()};
+        return decode_version_literal(string_view());
     }
 
     /** Get the simple value of the token.
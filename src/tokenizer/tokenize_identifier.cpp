@@ -29,5 +29,20 @@ namespace hk {
     return r;
 }
 
+[[nodiscard]] token tokenize_ascii_identifier(char const*& p)
+{
+    if (not is_ascii_identifier_start(p[0])) {
+        return {};
+    }
+
+    auto r = token{p, token::identifier};
+    do {
+        ++p;
+    } while (is_ascii_identifier_continue(p[0]));
+
+    r.set_last(p);
+    return r;
+}
+
 }
 
@@ -7,4 +7,12 @@ namespace hk {
 
 [[nodiscard]] token tokenize_identifier(char const*& p);
 
+/** Tokenize an identifier in a text that only contains ASCII characters.
+ *
+ * @see validate_utf8()
+ * @param [in,out] p Pointer to the text, advanced beyond the identifier.
+ * @return An identifier token, or an empty token if there is no identifier.
+ */
+[[nodiscard]] token tokenize_ascii_identifier(char const*& p);
+
 }
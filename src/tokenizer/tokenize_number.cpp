@@ -56,7 +56,7 @@ integer_part:
             ++p;
             goto fraction_part;
 
-        } else if (is_exponent_prefix(radix, p[0])) {
+        } else if (is_exponent_prefix(p[0], radix)) {
             r.set_kind(token::float_literal);
             ++p;
             goto exponent_part;
@@ -87,7 +87,7 @@ fraction_part:
             ++p;
             goto patch_part;
 
-        } else if (is_exponent_prefix(radix, p[0])) {
+        } else if (is_exponent_prefix(p[0], radix)) {
             ++p;
             goto exponent_part;
 
@@ -104,12 +104,13 @@ exponent_part:
         ++p;
     }
 
-    if (not is_digit(p[0], radix)) {
+    // The exponent is always written in decimal.
+    if (not is_digit(p[0])) {
         return r.make_error(p, token::invalid_exponent_error);
     }
 
     while (true) {
-        if (is_digit(p[0], radix) or p[0] == '\'') {
+        if (is_digit(p[0]) or p[0] == '\'') {
             ++p;
 
         } else {
@@ -120,7 +121,7 @@ exponent_part:
     }
 
 patch_part:
-    if (p[0] != '*') {
+    if (p[0] == '*') {
         ++p;
         r.set_last(p);
         return r;
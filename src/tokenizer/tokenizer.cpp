@@ -25,7 +25,7 @@
 
 namespace hk {
 
-[[nodiscard]] static hk::generator<token> simple_tokenize(char const* p)
+[[nodiscard]] hk::generator<token> simple_tokenize(char const* p, bool ascii)
 {
     enum class state_type {
         normal,
@@ -94,7 +94,7 @@ namespace hk {
         } else if (auto t = tokenize_tag(p)) {
             co_yield t;
 
-        } else if (auto t = tokenize_identifier(p)) {
+        } else if (auto t = ascii ? tokenize_ascii_identifier(p) : tokenize_identifier(p)) {
             co_yield t;
 
             if (t == "llvm") {
@@ -106,16 +106,15 @@ namespace hk {
 
         } else {
             // Extracting an code-point is slow, so this is done last.
-            auto const [cp, n] = get_cp(p);
+            auto const [cp, n] = ascii ? get_ascii_cp(p) : get_cp(p);
 
-            if (match<char32_t, U'\u0085', U'\u2028', U'\u2029'>(cp)) {
+            if (is_vertical_space(cp)) {
                 co_yield {p, '\n'};
 
             } else if (cp == 0xfeff) {
                 // Ignore BOM.
 
-            } else if (
-                match<char32_t, U'\u00a0', U'\u1680', U'\u202f', U'\u205f', U'\u3000'>(cp) or (cp >= 0x2000 and cp <= 0x200a)) {
+            } else if (is_horizontal_space(cp)) {
                 // Ignore white-space.
 
             } else if (cp == 0xfffd) {
@@ -162,7 +161,7 @@ namespace hk {
         return token{t.data(), ';'};
     };
 
-    for (auto t : simple_tokenize(p)) {
+    for (auto t : simple_tokenize(p, lines.ascii())) {
         if (t == token::comment) {
             // Drop comments.
 
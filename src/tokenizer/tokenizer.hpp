@@ -7,12 +7,23 @@
 
 namespace hk {
 
+/** Split the text into simple tokens.
+ *
+ * The simple tokens include comments and line directives, and no
+ * semicolons are inserted; `tokenize()` does this on top of these tokens.
+ *
+ * @param p Pointer to source code text which has at least 8 nul terminating the text.
+ * @param ascii The text only contains ASCII characters, see `validate_utf8()`.
+ */
+[[nodiscard]] hk::generator<token> simple_tokenize(char const* p, bool ascii);
+
 /** Tokenize all tokens pointed to by the file cursor.
  * 
  * This function will tokenize the input text and call the delegate for each token produced.
  * 
  * @param p Pointer to source code text which has at least 8 nul terminating the text.
- * @param lines A line table that is updated for the #line directive.
+ * @param lines A line table that is updated for the #line directive. When
+ *              `lines.ascii()` is true the ASCII-only fast paths are used.
  */
 [[nodiscard]] hk::generator<token> tokenize(char const* p, line_table &lines);
 
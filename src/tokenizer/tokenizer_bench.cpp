@@ -0,0 +1,84 @@
+
+#include "tokenizer.hpp"
+#include "validate_utf8.hpp"
+#include "bench_utilities/corpus.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+/** A generated module; the arguments are the number of declarations and the maximum depth.
+ */
+[[nodiscard]] std::string make_text(benchmark::State const& state)
+{
+    auto options = bench::corpus_options{};
+    options.num_declarations = static_cast<std::size_t>(state.range(0));
+    options.max_depth = static_cast<std::size_t>(state.range(1));
+    return bench::pad_source_code(bench::generate_module("bench.tokenizer", options));
+}
+
+[[nodiscard]] hk::line_table make_lines(std::string const& text)
+{
+    auto lines = hk::line_table{};
+    lines.add_file(text.data(), text.data() + text.size(), "<bench>");
+    lines.set_ascii(hk::validate_utf8(text.data(), text.data() + text.size()).ascii);
+    return lines;
+}
+
+void bm_simple_tokenize(benchmark::State& state)
+{
+    auto const text = make_text(state);
+    auto const ascii = make_lines(text).ascii();
+
+    auto num_tokens = int64_t{0};
+    for (auto _ : state) {
+        for (auto const& t : hk::simple_tokenize(text.data(), ascii)) {
+            benchmark::DoNotOptimize(t);
+            ++num_tokens;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.SetItemsProcessed(num_tokens);
+}
+
+void bm_tokenize(benchmark::State& state)
+{
+    auto const text = make_text(state);
+
+    auto num_tokens = int64_t{0};
+    for (auto _ : state) {
+        auto lines = make_lines(text);
+        for (auto const& t : hk::tokenize(text.data(), lines)) {
+            benchmark::DoNotOptimize(t);
+            ++num_tokens;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.SetItemsProcessed(num_tokens);
+}
+
+void bm_tokenize_source_tree(benchmark::State& state)
+{
+    auto const& corpus = bench::source_tree_corpus();
+
+    auto num_bytes = int64_t{0};
+    for (auto _ : state) {
+        for (auto const& file : corpus) {
+            auto lines = make_lines(file.text);
+            for (auto const& t : hk::tokenize(file.text.data(), lines)) {
+                benchmark::DoNotOptimize(t);
+            }
+            num_bytes += static_cast<int64_t>(file.text.size());
+        }
+    }
+
+    state.SetBytesProcessed(num_bytes);
+}
+
+} // namespace
+
+BENCHMARK(bm_simple_tokenize)->ArgsProduct({{16, 256, 4096}, {2, 5}});
+BENCHMARK(bm_tokenize)->ArgsProduct({{16, 256, 4096}, {2, 5}});
+BENCHMARK(bm_tokenize_source_tree);
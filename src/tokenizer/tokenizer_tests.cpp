@@ -76,6 +76,46 @@ TEST_CASE(integer_0X2A)
     REQUIRE(tokens[2] == '\0');
 }
 
+TEST_CASE(float_1_5e10)
+{
+    parse_tokens(tokens, "1.5e10");
+    REQUIRE(tokens[0].kind() == hk::token::float_literal);
+    REQUIRE(tokens[0].string_view() == "1.5e10");
+    REQUIRE(tokens[0].float_value() == 1.5e10);
+    REQUIRE(tokens[1] == ';');
+    REQUIRE(tokens[2] == '\0');
+}
+
+TEST_CASE(float_0x1_8p1)
+{
+    parse_tokens(tokens, "0x1.8p1");
+    REQUIRE(tokens[0].kind() == hk::token::float_literal);
+    REQUIRE(tokens[0].string_view() == "0x1.8p1");
+    REQUIRE(tokens[0].float_value() == 3.0);
+    REQUIRE(tokens[1] == ';');
+    REQUIRE(tokens[2] == '\0');
+}
+
+TEST_CASE(version_1_2_34)
+{
+    parse_tokens(tokens, "1.2.34");
+    REQUIRE(tokens[0].kind() == hk::token::version_literal);
+    REQUIRE(tokens[0].string_view() == "1.2.34");
+    REQUIRE(tokens[0].version_value() == hk::semantic_version(1, 2, 34));
+    REQUIRE(tokens[1] == ';');
+    REQUIRE(tokens[2] == '\0');
+}
+
+TEST_CASE(version_1_2_star)
+{
+    parse_tokens(tokens, "1.2.*");
+    REQUIRE(tokens[0].kind() == hk::token::version_literal);
+    REQUIRE(tokens[0].string_view() == "1.2.*");
+    REQUIRE(tokens[0].version_value() == hk::semantic_version(1, 2));
+    REQUIRE(tokens[1] == ';');
+    REQUIRE(tokens[2] == '\0');
+}
+
 TEST_CASE(short_file_file)
 {
     auto test_data_path = test::test_data_path();
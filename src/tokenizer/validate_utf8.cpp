@@ -0,0 +1,151 @@
+
+#include "validate_utf8.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HK_VALIDATE_UTF8_SSE2 1
+#endif
+
+namespace hk {
+
+/** Get a mask of the non-ASCII code-units in the next 16 bytes.
+ *
+ * @param p Pointer to at least 16 code-units.
+ * @return A mask where each bit represents a code-unit with the top bit set.
+ */
+[[nodiscard]] static uint32_t non_ascii_mask16(char const* p) noexcept
+{
+#if defined(HK_VALIDATE_UTF8_SSE2)
+    auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(chunk));
+#else
+    uint64_t lo;
+    uint64_t hi;
+    std::memcpy(&lo, p, sizeof(lo));
+    std::memcpy(&hi, p + sizeof(lo), sizeof(hi));
+
+    // Only the position of the lowest bit matters, so it is not needed to
+    // compact the top-bits of each byte.
+    lo &= 0x8080'8080'8080'8080;
+    hi &= 0x8080'8080'8080'8080;
+    if constexpr (std::endian::native == std::endian::big) {
+        lo = std::byteswap(lo);
+        hi = std::byteswap(hi);
+    }
+
+    if (lo != 0) {
+        return 1U << (std::countr_zero(lo) / 8);
+    } else if (hi != 0) {
+        return 0x100U << (std::countr_zero(hi) / 8);
+    } else {
+        return 0;
+    }
+#endif
+}
+
+/** Validate a single multi-byte UTF-8 sequence.
+ *
+ * @param p Pointer to the first code-unit of the sequence, which must be
+ *          a non-ASCII code-unit.
+ * @param last Pointer beyond the last code-unit of the text.
+ * @return The kind of error or nullopt, the number of code-units of the
+ *         sequence or of the invalid part of the sequence.
+ */
+[[nodiscard]] static std::pair<token::kind_type, uint8_t> validate_utf8_sequence(char const* p, char const* last) noexcept
+{
+    assert(p < last);
+
+    auto const cu0 = static_cast<uint8_t>(p[0]);
+    assert(cu0 >= 0x80);
+
+    auto length = uint8_t{};
+    auto cp = char32_t{};
+    if (cu0 < 0xc0) {
+        // Unexpected continuation byte.
+        return {token::invalid_replacement_character_error, 1};
+    } else if (cu0 < 0xe0) {
+        length = 2;
+        cp = cu0 & 0x1f;
+    } else if (cu0 < 0xf0) {
+        length = 3;
+        cp = cu0 & 0x0f;
+    } else if (cu0 < 0xf8) {
+        length = 4;
+        cp = cu0 & 0x07;
+    } else {
+        // Originally used for sequences of 5 or more bytes.
+        return {token::invalid_replacement_character_error, 1};
+    }
+
+    for (uint8_t i = 1; i != length; ++i) {
+        if (p + i == last) {
+            return {token::invalid_replacement_character_error, i};
+        }
+
+        auto const cu = static_cast<uint8_t>(p[i]);
+        if ((cu & 0xc0) != 0x80) {
+            // Missing continuation byte; the invalid part of the sequence
+            // does not include this code-unit.
+            return {token::invalid_replacement_character_error, i};
+        }
+
+        cp <<= 6;
+        cp |= cu & 0x3f;
+    }
+
+    constexpr auto minimum_cp = std::array<char32_t, 5>{0, 0, 0x80, 0x800, 0x1'0000};
+    if (cp < minimum_cp[length]) {
+        return {token::invalid_code_point_error, length};
+    } else if (cp >= 0xd800 and cp <= 0xdfff) {
+        return {token::invalid_surrogate_code_point_error, length};
+    } else if (cp > 0x10'ffff) {
+        return {token::invalid_code_point_error, length};
+    } else {
+        return {token::nullopt, length};
+    }
+}
+
+[[nodiscard]] validate_utf8_result validate_utf8(char const* first, char const* last)
+{
+    assert(first <= last);
+
+    auto r = validate_utf8_result{};
+
+    auto p = first;
+    while (p != last) {
+        // Skip over runs of ASCII characters, 16 code-units at a time.
+        while (last - p >= 16) {
+            if (auto const mask = non_ascii_mask16(p)) {
+                p += std::countr_zero(mask);
+                break;
+            }
+            p += 16;
+        }
+
+        if (p == last) {
+            break;
+        }
+
+        if (static_cast<uint8_t>(p[0]) < 0x80) {
+            ++p;
+            continue;
+        }
+
+        r.ascii = false;
+        auto const [kind, n] = validate_utf8_sequence(p, last);
+        if (kind != token::nullopt) {
+            r.errors.emplace_back(p, n, kind);
+        }
+        p += n;
+    }
+
+    return r;
+}
+
+} // namespace hk
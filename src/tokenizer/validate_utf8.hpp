@@ -0,0 +1,46 @@
+
+#pragma once
+
+#include "token.hpp"
+#include <vector>
+
+namespace hk {
+
+/** The result of validating a UTF-8 text.
+ */
+struct validate_utf8_result {
+    /** The text only contains ASCII characters.
+     *
+     * When true, the tokenizer and line-table may use the ASCII-only fast
+     * paths; every code-point is a single code-unit.
+     */
+    bool ascii = true;
+
+    /** A token for each invalid UTF-8 sequence, in file order.
+     *
+     * The kind of each token is one of:
+     *  - invalid_replacement_character_error: An unexpected continuation byte,
+     *    a missing continuation byte, or a byte that is never valid in UTF-8.
+     *  - invalid_surrogate_code_point_error: A UTF-16 surrogate encoded in
+     *    UTF-8.
+     *  - invalid_code_point_error: An overlong encoding, or a code-point
+     *    beyond U+10FFFF.
+     */
+    std::vector<token> errors = {};
+};
+
+/** Validate a UTF-8 text in a single pass.
+ *
+ * This function is run once over the source buffer after it is loaded, so
+ * that the tokenizer does not need to check for invalid UTF-8 for each token.
+ *
+ * Runs of ASCII characters are checked 16 bytes at a time, multi-byte
+ * sequences are decoded one at a time to find the exact location of an error.
+ *
+ * @param first Pointer to the first character of the text.
+ * @param last Pointer beyond the last character of the text.
+ * @return Whether the text is pure ASCII, and a list of errors.
+ */
+[[nodiscard]] validate_utf8_result validate_utf8(char const* first, char const* last);
+
+} // namespace hk
@@ -0,0 +1,88 @@
+
+#include "validate_utf8.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+
+TEST_SUITE(validate_utf8_suite)
+{
+
+TEST_CASE(ascii)
+{
+    auto const text = std::string{"module com.example.foo\n\nimport git \"https://github.com/example/baz\" \"main\"\n"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(r.ascii);
+    REQUIRE(r.errors.empty());
+}
+
+TEST_CASE(valid_utf8)
+{
+    auto const text = std::string{"let x = 15.0 min // Hello, 世界! 🐈 and a long tail of ASCII text"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(not r.ascii);
+    REQUIRE(r.errors.empty());
+}
+
+TEST_CASE(continuation_byte)
+{
+    auto const text = std::string{"0123456789abcdefghij\x80klm"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(not r.ascii);
+    REQUIRE(r.errors.size() == 1);
+    REQUIRE(r.errors[0].kind() == hk::token::invalid_replacement_character_error);
+    REQUIRE(r.errors[0].begin() == text.data() + 20);
+    REQUIRE(r.errors[0].size() == 1);
+}
+
+TEST_CASE(missing_continuation_byte)
+{
+    auto const text = std::string{"ab\xe4\xb8x"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(r.errors.size() == 1);
+    REQUIRE(r.errors[0].kind() == hk::token::invalid_replacement_character_error);
+    REQUIRE(r.errors[0].begin() == text.data() + 2);
+    REQUIRE(r.errors[0].size() == 2);
+}
+
+TEST_CASE(truncated_at_end)
+{
+    auto const text = std::string{"ab\xf0\x9f"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(r.errors.size() == 1);
+    REQUIRE(r.errors[0].kind() == hk::token::invalid_replacement_character_error);
+    REQUIRE(r.errors[0].size() == 2);
+}
+
+TEST_CASE(surrogate)
+{
+    auto const text = std::string{"a\xed\xa0\x80z"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(r.errors.size() == 1);
+    REQUIRE(r.errors[0].kind() == hk::token::invalid_surrogate_code_point_error);
+    REQUIRE(r.errors[0].begin() == text.data() + 1);
+    REQUIRE(r.errors[0].size() == 3);
+}
+
+TEST_CASE(overlong)
+{
+    auto const text = std::string{"\xc0\xaf and \xe0\x80\xaf"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(r.errors.size() == 2);
+    REQUIRE(r.errors[0].kind() == hk::token::invalid_code_point_error);
+    REQUIRE(r.errors[0].size() == 2);
+    REQUIRE(r.errors[1].kind() == hk::token::invalid_code_point_error);
+    REQUIRE(r.errors[1].begin() == text.data() + 7);
+    REQUIRE(r.errors[1].size() == 3);
+}
+
+TEST_CASE(out_of_range)
+{
+    auto const text = std::string{"\xf4\x90\x80\x80\xff"};
+    auto const r = hk::validate_utf8(text.data(), text.data() + text.size());
+    REQUIRE(r.errors.size() == 2);
+    REQUIRE(r.errors[0].kind() == hk::token::invalid_code_point_error);
+    REQUIRE(r.errors[0].size() == 4);
+    REQUIRE(r.errors[1].kind() == hk::token::invalid_replacement_character_error);
+    REQUIRE(r.errors[1].size() == 1);
+}
+
+};
@@ -1,46 +1,56 @@
 
 #include "datum_namespace.hpp"
+#include <atomic>
 
 namespace hk {
 
+[[nodiscard]] uint64_t datum_namespace::make_version() noexcept
+{
+    static auto counter = std::atomic<uint64_t>{0};
+    return counter.fetch_add(1, std::memory_order::relaxed) + 1;
+}
+
 [[nodiscard]] datum const* datum_namespace::get(fqname const& name) const
 {
     assert(name.is_absolute());
+    return get(interned_string{name.string()});
+}
 
-    auto const it = std::lower_bound(_items.begin(), _items.end(), name, [](auto const& item, auto const& x) {
-        return item.name < x;
-    });
-    if (it == _items.end() or it->name != name) {
+[[nodiscard]] datum const* datum_namespace::get(interned_string name) const
+{
+    auto const it = _items.find(name);
+    if (it == _items.end()) {
         return nullptr;
     }
 
-    return std::addressof(it->value);
+    return std::addressof(it->second);
 }
 
 datum& datum_namespace::set(fqname name, datum value)
 {
     assert(name.is_absolute());
 
-    auto it = std::lower_bound(_items.begin(), _items.end(), name, [](auto const& item, auto const& x) {
-        return item.name < x;
-    });
-    if (it == _items.end() or it->name != name) {
-        it = _items.emplace(it, std::move(name), std::move(value));
-    }
-    return it->value;
+    auto& r = _items[interned_string{name.string()}];
+    r = std::move(value);
+    _version = make_version();
+    return r;
 }
 
 void datum_namespace::remove(fqname const& name)
 {
     assert(name.is_absolute());
 
-    auto it = std::lower_bound(_items.begin(), _items.end(), name, [](auto const& item, auto const& x) {
-        return item.name < x;
-    });
-    if (it == _items.end() or it->name != name) {
-        return;
+    if (_items.erase(interned_string{name.string()}) != 0) {
+        _version = make_version();
     }
-    _items.erase(it);
+}
+
+[[nodiscard]] std::shared_ptr<datum_namespace const> datum_namespace::snapshot() const
+{
+    auto r = std::make_shared<datum_namespace>();
+    r->_items = _items;
+    r->_version = _version;
+    return r;
 }
 
 }
@@ -4,10 +4,19 @@
 #include "datum.hpp"
 #include "utility/semantic_version.hpp"
 #include "utility/fqname.hpp"
+#include "utility/interned_string.hpp"
 #include <bit>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 
 namespace hk {
 
+/** The named values used by build-guards.
+ *
+ * The values are indexed by their interned name, so that the names used
+ * in a compiled build-guard can be found without string comparisons.
+ */
 class datum_namespace {
 public:
     datum_namespace(datum_namespace const&) = delete;
@@ -23,6 +32,13 @@ public:
      */
     [[nodiscard]] datum const* get(fqname const &name) const;
 
+    /** Get a value by interned name.
+     *
+     * @param name The interned string of an absolute fully qualified name.
+     * @return A pointer to the value, or nullptr if it does not exist.
+     */
+    [[nodiscard]] datum const* get(interned_string name) const;
+
     /** Set a custom value from the environment / command-line.
      * 
      * @param name The name of the value
@@ -35,12 +51,37 @@ public:
      */
     void remove(fqname const& name);
 
+    /** The version of this namespace.
+     *
+     * The version changes whenever the namespace is modified, and is unique
+     * across all namespaces; except for a snapshot, which has the version of
+     * the namespace it was taken from. Results computed from a namespace may
+     * be reused for any namespace with the same version.
+     */
+    [[nodiscard]] uint64_t version() const noexcept
+    {
+        return _version;
+    }
+
+    /** Take an immutable copy of the namespace.
+     *
+     * @return A copy with the same values and version.
+     */
+    [[nodiscard]] std::shared_ptr<datum_namespace const> snapshot() const;
+
 private:
-    struct item_type {
-        fqname name;
-        datum value;
+    struct interned_string_hash {
+        [[nodiscard]] size_t operator()(interned_string const& x) const noexcept
+        {
+            // Interned strings are equal when their storage is the same.
+            return std::hash<char const*>{}(x.data());
+        }
     };
-    std::vector<item_type> _items;
+
+    std::unordered_map<interned_string, datum, interned_string_hash> _items;
+    uint64_t _version = make_version();
+
+    [[nodiscard]] static uint64_t make_version() noexcept;
 };
 
 
@@ -0,0 +1,57 @@
+
+#include "datum_namespace.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+
+TEST_SUITE(datum_namespace_suite)
+{
+
+TEST_CASE(set_get_remove)
+{
+    auto ns = hk::datum_namespace{};
+    REQUIRE(ns.get(hk::fqname{".target.os"}) == nullptr);
+
+    ns.set(hk::fqname{".target.os"}, std::string{"linux"});
+    ns.set(hk::fqname{".debug"}, true);
+    REQUIRE(*ns.get(hk::fqname{".target.os"}) == hk::datum{std::string{"linux"}});
+    REQUIRE(*ns.get(hk::interned_string{".debug"}) == hk::datum{true});
+
+    ns.set(hk::fqname{".target.os"}, std::string{"windows"});
+    REQUIRE(*ns.get(hk::fqname{".target.os"}) == hk::datum{std::string{"windows"}});
+
+    ns.remove(hk::fqname{".target.os"});
+    REQUIRE(ns.get(hk::fqname{".target.os"}) == nullptr);
+    REQUIRE(ns.get(hk::fqname{".debug"}) != nullptr);
+}
+
+TEST_CASE(version)
+{
+    auto a = hk::datum_namespace{};
+    auto b = hk::datum_namespace{};
+    REQUIRE(a.version() != b.version());
+
+    auto const version = a.version();
+    a.set(hk::fqname{".debug"}, true);
+    REQUIRE(a.version() != version);
+
+    // Removing a value that does not exist does not modify the namespace.
+    auto const version2 = a.version();
+    a.remove(hk::fqname{".release"});
+    REQUIRE(a.version() == version2);
+}
+
+TEST_CASE(snapshot)
+{
+    auto ns = hk::datum_namespace{};
+    ns.set(hk::fqname{".debug"}, true);
+
+    auto const snapshot = ns.snapshot();
+    REQUIRE(snapshot->version() == ns.version());
+    REQUIRE(*snapshot->get(hk::fqname{".debug"}) == hk::datum{true});
+
+    ns.set(hk::fqname{".debug"}, false);
+    REQUIRE(snapshot->version() != ns.version());
+    REQUIRE(*snapshot->get(hk::fqname{".debug"}) == hk::datum{true});
+}
+
+};
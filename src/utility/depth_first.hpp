@@ -1,67 +1,108 @@
 
 #pragma once
 
-#include <functional>
+#include <vector>
+#include <span>
 #include <cstddef>
-#include <bit>
+#include <cassert>
+#include <utility>
 
 namespace hk {
 
-
-/** Algorithm to walk a graph, depth first.
- * 
- * The algorithm handles new items to be inserted.
- * 
+/** Algorithm to walk a tree, depth first.
+ *
+ * The walk uses an explicit stack instead of recursion, so that deep trees do
+ * not overflow the call stack. The children of all the nodes on the current
+ * path are kept in a single vector; both the stack and this vector are kept
+ * between walks, so that after a few walks no more memory is allocated.
+ *
+ * @tparam T The type of the nodes of the tree.
  */
 template<typename T>
 class depth_first {
 public:
     using value_type = T;
 
-    class entry_type {
-    public:
-
-    private:
-        value_type const *_ptr = nullptr;
-        std::vector<entry_type *> _to; = {};
-        bool _visitted : 1 = false;
-    };
-
-    using branch_function_proto = std::vector<T const*>(T const &);
-    using branch_function_type = std::function<branch_function_proto>;
-
-    depth_first(branch_function_type f) : _branch_func(std::move(f))
+    /** Walk a tree.
+     *
+     * @param root The root of the tree.
+     * @param append_children `void(T& node, std::vector<T*>& children)`;
+     *        Append the direct children of a node to the vector.
+     * @param enter `bool(T& node, T* parent)`; Called before the children of
+     *        a node are walked. Return false to skip the children and the
+     *        call to @a leave of this node.
+     * @param leave `void(T& node, T* parent, std::span<T* const> children)`;
+     *        Called after all the children of a node are walked.
+     */
+    template<typename AppendChildren, typename Enter, typename Leave>
+    void operator()(T& root, AppendChildren&& append_children, Enter&& enter, Leave&& leave)
     {
-    }
+        assert(_stack.empty());
+        assert(_children.empty());
 
-    void add(T const& obj)
-    {
-        auto const [it, inserted] = _branches.emplace(std::addressof(obj), std::vector<T const*>{});
-        if (inserted) {
-            for (auto const& b : _branch_func(obj)) {
-                it->value.push_back(std::addressof(b));
+        auto push = [&](T& node, T* parent) {
+            if (not enter(node, parent)) {
+                return;
             }
-        }
-    }
 
-    void add_todo(T const& obj)
-    {
-        add(obj);
-        if (_done.contains(std::addressof(obj)) or _todo.contains(std::addressof(obj))) {
-            return;
+            auto const first = _children.size();
+            append_children(node, _children);
+            _stack.emplace_back(&node, parent, first, first);
+        };
+
+        push(root, nullptr);
+        while (not _stack.empty()) {
+            auto& top = _stack.back();
+
+            // All the children of nodes that are higher on the stack have
+            // been removed, so the children of `top` end at the end of the
+            // vector.
+            if (top.next != _children.size()) {
+                auto const child = _children[top.next++];
+                assert(child != nullptr);
+                // `push()` may invalidate `top`.
+                push(*child, top.node);
+
+            } else {
+                auto const entry = top;
+                _stack.pop_back();
+
+                leave(*entry.node, entry.parent, std::span<T* const>{_children.data() + entry.first, _children.size() - entry.first});
+                _children.resize(entry.first);
+            }
         }
-        _todo.emplace(std::addressof(obj));
     }
 
-    [[nodiscard]] T *pop()
+    /** Walk a tree.
+     *
+     * @param root The root of the tree.
+     * @param append_children `void(T& node, std::vector<T*>& children)`;
+     *        Append the direct children of a node to the vector.
+     * @param enter `bool(T& node, T* parent)`; Called before the children of
+     *        a node are walked. Return false to skip the children.
+     */
+    template<typename AppendChildren, typename Enter>
+    void operator()(T& root, AppendChildren&& append_children, Enter&& enter)
     {
-
+        return (*this)(root, std::forward<AppendChildren>(append_children), std::forward<Enter>(enter), [](T&, T*, std::span<T* const>) {});
     }
 
 private:
-    std::vector<std::unique_ptr<entry_type>> _entries;
-    branch_function_type _branch_func;
-};
+    struct entry_type {
+        T* node;
+        T* parent;
 
+        /** Index in `_children` of the first child of the node.
+         */
+        std::size_t first;
+
+        /** Index in `_children` of the next child to walk.
+         */
+        std::size_t next;
+    };
+
+    std::vector<entry_type> _stack;
+    std::vector<T*> _children;
+};
 
-}
\ No newline at end of file
+} // namespace hk
@@ -0,0 +1,124 @@
+
+#include "depth_first.hpp"
+#include <hikotest/hikotest.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct tree_node {
+    char name;
+    std::vector<std::unique_ptr<tree_node>> children;
+
+    tree_node(char name) : name(name) {}
+
+    tree_node& add(char child_name)
+    {
+        return *children.emplace_back(std::make_unique<tree_node>(child_name));
+    }
+};
+
+void append_children(tree_node& n, std::vector<tree_node*>& r)
+{
+    for (auto& child : n.children) {
+        r.push_back(child.get());
+    }
+}
+
+/** Build the tree: a(b(d, e), c(f)).
+ */
+std::unique_ptr<tree_node> make_tree()
+{
+    auto a = std::make_unique<tree_node>('a');
+    auto& b = a->add('b');
+    b.add('d');
+    b.add('e');
+    auto& c = a->add('c');
+    c.add('f');
+    return a;
+}
+
+} // namespace
+
+TEST_SUITE(depth_first_suite)
+{
+
+TEST_CASE(order)
+{
+    auto root = make_tree();
+
+    auto r = std::string{};
+    auto walk = hk::depth_first<tree_node>{};
+    walk(
+        *root,
+        append_children,
+        [&](tree_node& n, tree_node* parent) {
+            r += '<';
+            r += n.name;
+            r += parent ? parent->name : '-';
+            return true;
+        },
+        [&](tree_node& n, tree_node*, std::span<tree_node* const> children) {
+            r += '>';
+            r += n.name;
+            r += static_cast<char>('0' + children.size());
+        });
+
+    REQUIRE(r == "<a-<ba<db>d0<eb>e0>b2<ca<fc>f0>c1>a2");
+}
+
+TEST_CASE(skip_children)
+{
+    auto root = make_tree();
+
+    auto r = std::string{};
+    auto walk = hk::depth_first<tree_node>{};
+    walk(*root, append_children, [&](tree_node& n, tree_node*) {
+        r += n.name;
+        return n.name != 'b';
+    });
+
+    REQUIRE(r == "abcf");
+}
+
+TEST_CASE(reuse)
+{
+    auto root = make_tree();
+
+    auto walk = hk::depth_first<tree_node>{};
+    for (auto i = 0; i != 2; ++i) {
+        auto r = std::string{};
+        walk(*root, append_children, [&](tree_node& n, tree_node*) {
+            r += n.name;
+            return true;
+        });
+        REQUIRE(r == "abdecf");
+    }
+}
+
+TEST_CASE(deep_tree)
+{
+    constexpr auto depth = 100'000;
+
+    auto root = std::make_unique<tree_node>('x');
+    auto p = root.get();
+    for (auto i = 0; i != depth; ++i) {
+        p = &p->add('x');
+    }
+
+    auto count = 0;
+    auto walk = hk::depth_first<tree_node>{};
+    walk(*root, append_children, [&](tree_node&, tree_node*) {
+        ++count;
+        return true;
+    });
+    REQUIRE(count == depth + 1);
+
+    // Destroy iteratively, the recursive destructor would overflow the stack.
+    while (not root->children.empty()) {
+        root = std::move(root->children.front());
+    }
+}
+
+};
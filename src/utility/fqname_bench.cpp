@@ -0,0 +1,74 @@
+
+#include "fqname.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <format>
+#include <random>
+#include <vector>
+
+namespace {
+
+/** `state.range(0)` module names in a few shallow hierarchies.
+ */
+[[nodiscard]] std::vector<hk::fqname> make_names(benchmark::State const& state)
+{
+    auto engine = std::mt19937_64{1};
+
+    auto r = std::vector<hk::fqname>{};
+    for (auto i = int64_t{0}; i != state.range(0); ++i) {
+        auto const organization = engine() % 4;
+        auto const project = engine() % 16;
+        r.emplace_back(std::format(".com.example{}.project{}.module{}", organization, project, i));
+    }
+    return r;
+}
+
+void bm_fqname_equal(benchmark::State& state)
+{
+    auto const names = make_names(state);
+
+    for (auto _ : state) {
+        for (auto i = 1uz; i < names.size(); ++i) {
+            benchmark::DoNotOptimize(names[i - 1] == names[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+}
+
+void bm_fqname_three_way(benchmark::State& state)
+{
+    auto const names = make_names(state);
+
+    for (auto _ : state) {
+        for (auto i = 1uz; i < names.size(); ++i) {
+            benchmark::DoNotOptimize(names[i - 1] <=> names[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+}
+
+/** Sort names, as done when sorting the sources of a repository by name.
+ */
+void bm_fqname_sort(benchmark::State& state)
+{
+    auto const names = make_names(state);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto tmp = names;
+        state.ResumeTiming();
+
+        std::ranges::sort(tmp);
+        benchmark::DoNotOptimize(tmp.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(bm_fqname_equal)->Arg(1024);
+BENCHMARK(bm_fqname_three_way)->Arg(1024);
+BENCHMARK(bm_fqname_sort)->Arg(1024)->Arg(65536);
@@ -2,6 +2,7 @@
 #include "git.hpp"
 #include "defer.hpp"
 #include "path.hpp"
+#include "trace.hpp"
 #include <git2.h>
 #include <mutex>
 #include <format>
@@ -74,6 +75,7 @@ public:
 
 [[nodiscard]] std::expected<git_references, git_error> git_list(std::string const& url)
 {
+    auto const trace = trace_scope{"git_list"};
     auto const& _ = git_lib_initialize();
 
     ::git_remote* remote = nullptr;
@@ -380,6 +382,7 @@ repository_fetch(::git_repository* repository, std::string const& remote_name =
 [[nodiscard]] git_error
 git_fetch_and_update(std::string const& url, std::string const& rev, std::filesystem::path path, repository_flags flags)
 {
+    auto const trace = trace_scope{"git_fetch_and_update"};
     auto const& _ = git_lib_initialize();
 
     auto r = git_error::ok;
@@ -465,6 +468,7 @@ git_fetch_and_update(std::string const& url, std::string const& rev, std::filesy
 
 [[nodiscard]] git_error git_clone(std::string const& url, std::string const& git_rev, std::filesystem::path path)
 {
+    auto const trace = trace_scope{"git_clone"};
     auto const& _ = git_lib_initialize();
 
     auto ref_list = git_references{};
@@ -508,6 +512,8 @@ git_fetch_and_update(std::string const& url, std::string const& rev, std::filesy
 [[nodiscard]] git_error git_checkout_or_clone(
     std::string const& url, std::string const& rev, std::filesystem::path path, repository_flags flags)
 {
+    auto const trace = trace_scope{"git_checkout_or_clone"};
+
     // First try and just update the repository.
     switch(git_fetch_and_update(url, rev, path, flags)) {
     case git_error::ok:
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -19,7 +21,7 @@ public:
     using const_iterator = std::basic_string<CharT>::const_iterator;
 
     basic_interned_string()
-        : _ptr(basic_interned_string::intern(""))
+        : _ptr(basic_interned_string::empty_ptr())
     {}
 
     basic_interned_string(std::string_view sv)
@@ -28,7 +30,7 @@ public:
 
     void clear() noexcept
     {
-        _ptr = basic_interned_string::intern("");
+        _ptr = basic_interned_string::empty_ptr();
     }
 
     [[nodiscard]] std::basic_string<CharT> const& string() const noexcept
@@ -169,8 +171,30 @@ private:
         auto [it, inserted] = _strings.emplace(sv);
         return std::addressof(*it);
     }
+
+    /** The empty string, interned once.
+     *
+     * So that default constructed strings, for example the keys of
+     * pre-allocated table entries, do not take the lock.
+     */
+    static const std::basic_string<CharT>* empty_ptr() {
+        static auto const r = basic_interned_string::intern("");
+        return r;
+    }
 };
 
 using interned_string = basic_interned_string<char>;
 
 }
+
+template<typename CharT>
+struct std::hash<hk::basic_interned_string<CharT>> {
+    [[nodiscard]] std::size_t operator()(hk::basic_interned_string<CharT> const& x) const noexcept
+    {
+        // Interned strings are equal when their storage is the same. The low
+        // bits of the address are mostly zero, fold in the high bits of the
+        // product.
+        auto const h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(x.data())) * 0x9e37'79b9'7f4a'7c15;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
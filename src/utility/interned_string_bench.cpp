@@ -0,0 +1,85 @@
+
+#include "interned_string.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** `state.range(0)` identifiers like they appear in source code.
+ */
+[[nodiscard]] std::vector<std::string> make_identifiers(benchmark::State const& state, std::string_view prefix)
+{
+    auto r = std::vector<std::string>{};
+    for (auto i = int64_t{0}; i != state.range(0); ++i) {
+        r.push_back(std::format("{}_identifier_{}", prefix, i));
+    }
+    return r;
+}
+
+/** Intern strings that are already in the table, the common case.
+ */
+void bm_interned_string_existing(benchmark::State& state)
+{
+    auto const identifiers = make_identifiers(state, "existing");
+    for (auto const& identifier : identifiers) {
+        benchmark::DoNotOptimize(hk::interned_string{identifier});
+    }
+
+    for (auto _ : state) {
+        for (auto const& identifier : identifiers) {
+            benchmark::DoNotOptimize(hk::interned_string{identifier});
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Intern strings that are not in the table yet.
+ *
+ * Interned strings are never removed, so each iteration adds new strings to
+ * the table and the table grows for the duration of the benchmark.
+ */
+void bm_interned_string_new(benchmark::State& state)
+{
+    auto num_strings = int64_t{0};
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto const identifiers = make_identifiers(state, std::format("new{}", num_strings));
+        state.ResumeTiming();
+
+        for (auto const& identifier : identifiers) {
+            benchmark::DoNotOptimize(hk::interned_string{identifier});
+        }
+        num_strings += state.range(0);
+    }
+
+    state.SetItemsProcessed(num_strings);
+}
+
+/** Compare interned strings, which compares pointers.
+ */
+void bm_interned_string_equal(benchmark::State& state)
+{
+    auto const identifiers = make_identifiers(state, "equal");
+    auto interned = std::vector<hk::interned_string>{};
+    for (auto const& identifier : identifiers) {
+        interned.emplace_back(identifier);
+    }
+
+    auto const needle = interned.back();
+    for (auto _ : state) {
+        for (auto const& s : interned) {
+            benchmark::DoNotOptimize(s == needle);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(bm_interned_string_existing)->Arg(64)->Arg(4096);
+BENCHMARK(bm_interned_string_new)->Arg(64)->Iterations(1000);
+BENCHMARK(bm_interned_string_equal)->Arg(64)->Arg(4096);
@@ -0,0 +1,119 @@
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <cassert>
+
+namespace hk {
+
+/** A lock-free multiple-producer, single-consumer queue.
+ *
+ * This is an unbounded queue made from a singly linked list of nodes. A
+ * producer appends a node with a single atomic exchange, so producers never
+ * wait on each other or on the consumer. The consumer owns the tail of the
+ * list and pops without atomic read-modify-write operations.
+ *
+ * The list always contains at least one node, the stub, whose value has
+ * already been consumed.
+ *
+ * @tparam T The type of the values in the queue.
+ */
+template<typename T>
+class mpsc_queue {
+public:
+    using value_type = T;
+
+    /** Destroy the queue and any values that were not popped.
+     */
+    ~mpsc_queue()
+    {
+        while (pop()) {}
+        delete _tail;
+    }
+
+    mpsc_queue() : _head(new node_type{}), _tail(_head.load(std::memory_order::relaxed)) {}
+
+    mpsc_queue(mpsc_queue const&) = delete;
+    mpsc_queue(mpsc_queue&&) = delete;
+    mpsc_queue& operator=(mpsc_queue const&) = delete;
+    mpsc_queue& operator=(mpsc_queue&&) = delete;
+
+    /** Append a value to the queue.
+     *
+     * This function may be called from any thread.
+     *
+     * @param args The arguments to construct the value with.
+     */
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        auto const n = new node_type{};
+        n->value.emplace(std::forward<Args>(args)...);
+
+        auto const prev = _head.exchange(n, std::memory_order::acq_rel);
+        // Between the exchange and this store the consumer sees the queue
+        // end at `prev`; it will pick up `n` on a later pop.
+        prev->next.store(n, std::memory_order::release);
+    }
+
+    /** Append a value to the queue.
+     *
+     * This function may be called from any thread.
+     *
+     * @param value The value to append.
+     */
+    void push(T value)
+    {
+        emplace(std::move(value));
+    }
+
+    /** Take the value from the front of the queue.
+     *
+     * This function may only be called from the consumer thread.
+     *
+     * @return The value, or std::nullopt if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> pop()
+    {
+        auto const next = _tail->next.load(std::memory_order::acquire);
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+
+        // `next` becomes the new stub.
+        assert(next->value.has_value());
+        auto r = std::move(next->value);
+        next->value.reset();
+
+        delete _tail;
+        _tail = next;
+        return r;
+    }
+
+    /** Check if the queue is empty.
+     *
+     * This function may only be called from the consumer thread.
+     */
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _tail->next.load(std::memory_order::acquire) == nullptr;
+    }
+
+private:
+    struct node_type {
+        std::atomic<node_type *> next = nullptr;
+        std::optional<T> value = std::nullopt;
+    };
+
+    /** The last node appended by a producer.
+     */
+    std::atomic<node_type *> _head;
+
+    /** The stub node, owned by the consumer.
+     */
+    node_type *_tail;
+};
+
+} // namespace hk
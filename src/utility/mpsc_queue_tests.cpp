@@ -0,0 +1,69 @@
+
+#include "mpsc_queue.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_SUITE(mpsc_queue_suite)
+{
+
+TEST_CASE(fifo_order)
+{
+    auto q = hk::mpsc_queue<std::string>{};
+    REQUIRE(q.empty());
+    REQUIRE(not q.pop().has_value());
+
+    q.push("one");
+    q.emplace(3uz, 'x');
+    REQUIRE(not q.empty());
+
+    REQUIRE(q.pop() == std::string{"one"});
+    REQUIRE(q.pop() == std::string{"xxx"});
+    REQUIRE(not q.pop().has_value());
+    REQUIRE(q.empty());
+}
+
+TEST_CASE(destroy_non_empty)
+{
+    auto q = hk::mpsc_queue<std::unique_ptr<int>>{};
+    q.push(std::make_unique<int>(1));
+    q.push(std::make_unique<int>(2));
+}
+
+TEST_CASE(multiple_producers)
+{
+    constexpr auto num_threads = 4;
+    constexpr auto num_values = 10'000;
+
+    auto q = hk::mpsc_queue<int>{};
+
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t != num_threads; ++t) {
+        threads.emplace_back([&q, t] {
+            for (auto i = 0; i != num_values; ++i) {
+                q.push(t * num_values + i);
+            }
+        });
+    }
+
+    // Values of each producer must arrive in the order they were pushed.
+    auto last = std::vector<int>(num_threads, -1);
+    auto count = 0;
+    while (count != num_threads * num_values) {
+        if (auto v = q.pop()) {
+            auto const t = *v / num_values;
+            auto const i = *v % num_values;
+            REQUIRE(i > last[t]);
+            last[t] = i;
+            ++count;
+        }
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(q.empty());
+}
+
+};
@@ -25,4 +25,33 @@ namespace hk {
     return r;
 }
 
+[[nodiscard]] std::string json_escape(std::string_view str)
+{
+    constexpr auto hex_digits = "0123456789abcdef";
+
+    auto r = std::string{};
+    r.reserve(str.size());
+
+    for (auto c : str) {
+        switch (c) {
+        case '"': r += "\\\""; break;
+        case '\\': r += "\\\\"; break;
+        case '\b': r += "\\b"; break;
+        case '\f': r += "\\f"; break;
+        case '\n': r += "\\n"; break;
+        case '\r': r += "\\r"; break;
+        case '\t': r += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                r += "\\u00";
+                r += hex_digits[c >> 4];
+                r += hex_digits[c & 0xf];
+            } else {
+                r += c;
+            }
+        }
+    }
+    return r;
+}
+
 }
@@ -18,6 +18,15 @@ namespace hk {
  */
 [[nodiscard]] std::vector<std::string> split(std::string_view str, char delimiter);
 
+/** Escape a string for use inside a JSON string literal.
+ *
+ * The quotes around the string literal are not added.
+ *
+ * @param str The UTF-8 string to escape.
+ * @return The escaped string.
+ */
+[[nodiscard]] std::string json_escape(std::string_view str);
+
 /** Count the length of the prefix of specific characters.
  * 
  * This uses an fast algorithm 
@@ -28,4 +28,12 @@ TEST_SUITE(strings_suite)
         REQUIRE(result[0] == "");
         REQUIRE(result[1] == "");
     }
+
+    TEST_CASE(json_escape_test) {
+        REQUIRE(hk::json_escape("foo") == "foo");
+        REQUIRE(hk::json_escape("a\"b\\c") == "a\\\"b\\\\c");
+        REQUIRE(hk::json_escape("a\nb\tc") == "a\\nb\\tc");
+        REQUIRE(hk::json_escape(std::string_view{"\x01\x1f", 2}) == "\\u0001\\u001f");
+        REQUIRE(hk::json_escape("caf\xc3\xa9") == "caf\xc3\xa9");
+    }
 };
@@ -1,5 +1,6 @@
 
 #include "thread_pool.hpp"
+#include "trace.hpp"
 
 namespace hk {
 
@@ -52,7 +53,10 @@ void thread_pool::runner(std::stop_token token, thread_pool::thread_item* item,
         auto work_ptr = item->work.get();
         if (work_ptr) {
             lock.unlock();
-            work_ptr->call();
+            {
+                auto const trace = trace_scope{"thread_pool::call"};
+                work_ptr->call();
+            }
             lock.lock();
 
             item->work = nullptr;
@@ -0,0 +1,174 @@
+
+#include "trace.hpp"
+#include "strings.hpp"
+#include "write_all.hpp"
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hk {
+
+namespace {
+
+struct trace_event {
+    char const* name = nullptr;
+    std::chrono::steady_clock::time_point start = {};
+    std::chrono::steady_clock::time_point end = {};
+};
+
+/** The ring buffer of events recorded by a single thread.
+ */
+class trace_buffer {
+public:
+    /** The maximum number of events kept for each thread.
+     */
+    constexpr static auto capacity = 0x10000uz;
+
+    explicit trace_buffer(std::size_t thread_id) : _thread_id(thread_id), _events(capacity) {}
+
+    [[nodiscard]] std::size_t thread_id() const noexcept
+    {
+        return _thread_id;
+    }
+
+    /** Add an event, overwriting the oldest event when the buffer is full.
+     *
+     * @note Only called by the thread that owns the buffer.
+     */
+    void push(trace_event const& event) noexcept
+    {
+        auto const i = _num_events.load(std::memory_order::relaxed);
+        _events[i % capacity] = event;
+        _num_events.store(i + 1, std::memory_order::release);
+    }
+
+    void clear() noexcept
+    {
+        _num_events.store(0, std::memory_order::relaxed);
+    }
+
+    /** The events that are still in the buffer, oldest first.
+     */
+    [[nodiscard]] std::vector<trace_event> events() const
+    {
+        auto const last = _num_events.load(std::memory_order::acquire);
+        auto const first = last > capacity ? last - capacity : 0uz;
+
+        auto r = std::vector<trace_event>{};
+        r.reserve(last - first);
+        for (auto i = first; i != last; ++i) {
+            r.push_back(_events[i % capacity]);
+        }
+        return r;
+    }
+
+private:
+    std::size_t _thread_id;
+    std::atomic<std::size_t> _num_events = 0;
+    std::vector<trace_event> _events;
+};
+
+std::mutex trace_mutex;
+
+/** The buffers of every thread that recorded an event.
+ *
+ * The buffers are shared with the threads, so that the events of threads
+ * that have exited are kept.
+ */
+std::vector<std::shared_ptr<trace_buffer>> trace_buffers;
+
+/** The time of `start_trace()`, the zero timestamp of the trace.
+ */
+std::chrono::steady_clock::time_point trace_epoch = {};
+
+[[nodiscard]] trace_buffer& local_trace_buffer()
+{
+    thread_local auto const buffer = [] {
+        auto const lock = std::scoped_lock{trace_mutex};
+        auto r = std::make_shared<trace_buffer>(trace_buffers.size() + 1);
+        trace_buffers.push_back(r);
+        return r;
+    }();
+    return *buffer;
+}
+
+/** Format a time relative to the start of the trace, in microseconds.
+ */
+[[nodiscard]] std::string to_microseconds(std::chrono::steady_clock::duration d)
+{
+    auto const ns = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(), int64_t{0});
+    return std::format("{}.{:03}", ns / 1000, ns % 1000);
+}
+
+} // namespace
+
+void start_trace()
+{
+    auto const lock = std::scoped_lock{trace_mutex};
+    for (auto& buffer : trace_buffers) {
+        buffer->clear();
+    }
+    trace_epoch = std::chrono::steady_clock::now();
+    global_trace_enabled.store(true, std::memory_order::relaxed);
+}
+
+void stop_trace() noexcept
+{
+    global_trace_enabled.store(false, std::memory_order::relaxed);
+}
+
+void record_trace_event(
+    char const* name,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) noexcept
+{
+    local_trace_buffer().push(trace_event{name, start, end});
+}
+
+[[nodiscard]] std::string trace_to_json()
+{
+    auto r = std::string{"{\"displayTimeUnit\":\"ms\",\"traceEvents\":["};
+
+    auto const lock = std::scoped_lock{trace_mutex};
+    auto separator = "\n";
+    for (auto const& buffer : trace_buffers) {
+        auto events = buffer->events();
+        if (events.empty()) {
+            continue;
+        }
+
+        // A scope is recorded when it ends, after the scopes nested inside
+        // it. Order the events by start time, the outer scope first.
+        std::ranges::sort(events, [](auto const& a, auto const& b) {
+            return a.start != b.start ? a.start < b.start : a.end > b.end;
+        });
+
+        r += std::format(
+            "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"thread {}\"}}}}",
+            separator,
+            buffer->thread_id(),
+            buffer->thread_id());
+        separator = ",\n";
+
+        for (auto const& event : events) {
+            r += std::format(
+                ",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{}}}",
+                json_escape(event.name),
+                buffer->thread_id(),
+                to_microseconds(event.start - trace_epoch),
+                to_microseconds(event.end - event.start));
+        }
+    }
+
+    r += "\n]}\n";
+    return r;
+}
+
+bool write_trace(int fd)
+{
+    return write_all(fd, trace_to_json());
+}
+
+} // namespace hk
@@ -0,0 +1,106 @@
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace hk {
+
+/** Tracing is enabled, changed by `start_trace()` and `stop_trace()`.
+ *
+ * @note Use `trace_enabled()` instead.
+ */
+inline std::atomic<bool> global_trace_enabled = false;
+
+/** Check if tracing is enabled.
+ *
+ * This is a single relaxed load, so that a disabled `trace_scope` costs one
+ * predictable branch.
+ */
+[[nodiscard]] inline bool trace_enabled() noexcept
+{
+    return global_trace_enabled.load(std::memory_order::relaxed);
+}
+
+/** Start recording trace events.
+ *
+ * The events recorded earlier are discarded.
+ */
+void start_trace();
+
+/** Stop recording trace events.
+ */
+void stop_trace() noexcept;
+
+/** Record a completed trace event for the current thread.
+ *
+ * Each thread records into its own ring buffer; when the buffer is full the
+ * oldest events are overwritten.
+ *
+ * @param name The name of the event, a string with static storage duration.
+ * @param start The time when the event started.
+ * @param end The time when the event ended.
+ */
+void record_trace_event(
+    char const* name,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) noexcept;
+
+/** Format the recorded events as a Chrome trace.
+ *
+ * The JSON can be opened in Perfetto or in `chrome://tracing`. Nested scopes
+ * are shown as a hierarchy on the track of the thread that recorded them.
+ *
+ * @pre No events are being recorded, for example after `stop_trace()`.
+ * @return The trace as JSON.
+ */
+[[nodiscard]] std::string trace_to_json();
+
+/** Write the recorded events as a Chrome trace.
+ *
+ * @pre No events are being recorded, for example after `stop_trace()`.
+ * @param fd The file descriptor to write to.
+ * @return True if the complete trace was written.
+ */
+bool write_trace(int fd);
+
+/** Record the duration of a scope as a trace event.
+ *
+ * ```cpp
+ * auto const trace = trace_scope{"repository::gather_modules"};
+ * ```
+ */
+class trace_scope {
+public:
+    /** Start the trace event.
+     *
+     * @param name The name of the event, a string with static storage duration.
+     */
+    explicit trace_scope(char const* name) noexcept
+    {
+        if (trace_enabled()) [[unlikely]] {
+            _name = name;
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~trace_scope()
+    {
+        if (_name != nullptr) [[unlikely]] {
+            record_trace_event(_name, _start, std::chrono::steady_clock::now());
+        }
+    }
+
+    trace_scope(trace_scope const&) = delete;
+    trace_scope(trace_scope&&) = delete;
+    trace_scope& operator=(trace_scope const&) = delete;
+    trace_scope& operator=(trace_scope&&) = delete;
+
+private:
+    char const* _name = nullptr;
+    std::chrono::steady_clock::time_point _start = {};
+};
+
+} // namespace hk
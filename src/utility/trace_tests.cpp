@@ -0,0 +1,65 @@
+
+#include "trace.hpp"
+#include <hikotest/hikotest.hpp>
+#include <thread>
+
+TEST_SUITE(trace_suite) {
+TEST_CASE(disabled)
+{
+    hk::start_trace();
+    hk::stop_trace();
+
+    {
+        auto const trace = hk::trace_scope{"trace_tests::disabled"};
+    }
+
+    REQUIRE(not hk::trace_enabled());
+    REQUIRE(not hk::trace_to_json().contains("trace_tests::disabled"));
+}
+
+TEST_CASE(nested)
+{
+    hk::start_trace();
+    {
+        auto const outer = hk::trace_scope{"trace_tests::outer"};
+        auto const inner = hk::trace_scope{"trace_tests::inner"};
+    }
+    hk::stop_trace();
+
+    auto const json = hk::trace_to_json();
+    auto const outer_pos = json.find("\"name\":\"trace_tests::outer\",\"ph\":\"X\"");
+    auto const inner_pos = json.find("\"name\":\"trace_tests::inner\",\"ph\":\"X\"");
+    REQUIRE(outer_pos != std::string::npos);
+    REQUIRE(inner_pos != std::string::npos);
+
+    // The outer scope is recorded last, but is written first.
+    REQUIRE(outer_pos < inner_pos);
+}
+
+TEST_CASE(threads)
+{
+    hk::start_trace();
+    auto thread = std::thread{[] {
+        auto const trace = hk::trace_scope{"trace_tests::thread"};
+    }};
+    thread.join();
+    hk::stop_trace();
+
+    // The events of a thread are kept after it exits.
+    auto const json = hk::trace_to_json();
+    REQUIRE(json.contains("trace_tests::thread"));
+    REQUIRE(json.contains("\"thread_name\""));
+}
+
+TEST_CASE(restart)
+{
+    hk::start_trace();
+    {
+        auto const trace = hk::trace_scope{"trace_tests::first"};
+    }
+    hk::start_trace();
+    hk::stop_trace();
+
+    REQUIRE(not hk::trace_to_json().contains("trace_tests::first"));
+}
+}; // TEST_SUITE(trace_suite)
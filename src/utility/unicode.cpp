@@ -133,20 +133,37 @@ namespace hk {
     return r;
 }
 
+/** Get the NFC normalizer.
+ *
+ * @return The NFC normalizer, or nullptr if it could not be instantiated.
+ */
+[[nodiscard]] static icu::Normalizer2 const* nfc_instance() noexcept
+{
+    static auto const* const instance = [] {
+        UErrorCode error_code = U_ZERO_ERROR;
+        auto* const nfc = icu::Normalizer2::getNFCInstance(error_code);
+        return U_FAILURE(error_code) ? nullptr : nfc;
+    }();
+
+    return instance;
+}
+
 [[nodiscard]] std::expected<std::string, utf8_normalization_error> normalize_utf8_string(std::string s)
 {
     auto r = std::move(s);
+    if (is_ascii(r)) {
+        // ASCII is always in NFC.
+        return r;
+    }
+
     auto r_source = icu::StringPiece{r};
 
-    UErrorCode error_code = U_ZERO_ERROR;
-    auto* const nfc = icu::Normalizer2::getNFCInstance(error_code);
-    if (U_FAILURE(error_code)) {
+    auto* const nfc = nfc_instance();
+    if (nfc == nullptr) {
         return std::unexpected{utf8_normalization_error::nfc_instance_missing};
     }
-    assert(nfc != nullptr);
 
-
-    error_code = U_ZERO_ERROR;
+    UErrorCode error_code = U_ZERO_ERROR;
     auto const check_value = nfc->isNormalizedUTF8(r_source, error_code);
     if (U_FAILURE(error_code)) {
         return std::unexpected{utf8_normalization_error::normalization_failed};
@@ -205,8 +222,9 @@ static auto spoof_checker = spoof_checker_type{};
 {
     assert(spoof_checker.checker != nullptr);
 
-    if (s.empty()) {
-        // Empty string is always valid.
+    if (s.empty() or is_ascii(s)) {
+        // Empty and ASCII strings are always valid: ASCII is a single
+        // script, without invisible or combining characters.
         return {};
     }
 
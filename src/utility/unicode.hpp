@@ -9,6 +9,8 @@
 #include <array>
 #include <bit>
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <format>
 
 namespace hk {
@@ -157,6 +159,34 @@ enum class unicode_name_error {
     could_not_find_name,
 };
 
+/** Check if a string only contains ASCII characters.
+ *
+ * The string is checked 8 code-units at a time.
+ *
+ * @param str The UTF-8 string to check.
+ * @retval true if all code-units are below 0x80.
+ */
+[[nodiscard]] inline bool is_ascii(std::string_view str) noexcept
+{
+    auto const fast_size = (str.size() / sizeof(uint64_t)) * sizeof(uint64_t);
+    auto i = 0uz;
+    for (; i != fast_size; i += sizeof(uint64_t)) {
+        auto value = uint64_t{};
+        std::memcpy(&value, str.data() + i, sizeof(value));
+        if ((value & 0x8080'8080'8080'8080) != 0) {
+            return false;
+        }
+    }
+
+    for (; i != str.size(); ++i) {
+        if (static_cast<uint8_t>(str[i]) >= 0x80) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /** Decode a single Unicode code-point from a UTF-8 stream.
  *
  * @param [in,out] first The iterator to the current position in the UTF-8 stream.
@@ -186,6 +216,9 @@ enum class unicode_name_error {
 /** Normalize a UTF-8 string to NFC (Normalization Form C).
  * 
  * This function will normalize the string to NFC, which is a canonical composition of characters.
+ *
+ * ASCII strings and strings that are already in NFC are returned as-is
+ * without allocating.
  * 
  * @param s The UTF-8 string to normalize.
  * @return A normalized UTF-8 string.
@@ -202,6 +235,8 @@ enum class unicode_name_error {
  * - Invisible characters
  * - Mixed numbers
  * - Hidden overlays
+ *
+ * ASCII strings always pass these checks and are not passed to ICU.
  * 
  * @param s The UTF-8 string to check.
  * @return An expected value indicating success or an error.
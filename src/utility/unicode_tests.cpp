@@ -22,4 +22,33 @@ TEST_CASE(unicode_decode_valid)
     REQUIRE(utf32_str == U"Hello, 世界!");
 }
 
+TEST_CASE(is_ascii)
+{
+    REQUIRE(hk::is_ascii(""));
+    REQUIRE(hk::is_ascii("hello_world_1234"));
+    REQUIRE(not hk::is_ascii("hello_world_123\xc3\xa9"));
+    REQUIRE(not hk::is_ascii("\xc3\xa9"));
+}
+
+TEST_CASE(normalize_ascii)
+{
+    auto const r = hk::normalize_utf8_string("hello_world");
+    REQUIRE(r.has_value());
+    REQUIRE(*r == "hello_world");
+}
+
+TEST_CASE(normalize_decomposed)
+{
+    // "e" followed by U+0301 COMBINING ACUTE ACCENT becomes U+00E9.
+    auto const r = hk::normalize_utf8_string("caf\x65\xcc\x81");
+    REQUIRE(r.has_value());
+    REQUIRE(*r == "caf\xc3\xa9");
+}
+
+TEST_CASE(security_check_ascii)
+{
+    REQUIRE(hk::security_check_utf8_string("hello_world").has_value());
+    REQUIRE(hk::security_check_utf8_string("+=").has_value());
+}
+
 };
@@ -0,0 +1,31 @@
+
+#include "write_all.hpp"
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstddef>
+
+namespace hk {
+
+bool write_all(int fd, std::string_view text) noexcept
+{
+    while (not text.empty()) {
+#if defined(_WIN32)
+        auto const n = ::_write(fd, text.data(), static_cast<unsigned int>(text.size()));
+#else
+        auto const n = ::write(fd, text.data(), text.size());
+#endif
+        if (n < 0 and errno == EINTR) {
+            continue;
+        } else if (n <= 0) {
+            return false;
+        }
+        text.remove_prefix(static_cast<std::size_t>(n));
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,19 @@
+
+#pragma once
+
+#include <string_view>
+
+namespace hk {
+
+/** Write a complete text to a file descriptor.
+ *
+ * The text is written with as few `write()` calls as the operating system
+ * allows; partial writes and interrupted calls are retried.
+ *
+ * @param fd The file descriptor to write to.
+ * @param text The text to write.
+ * @return True if the complete text was written.
+ */
+bool write_all(int fd, std::string_view text) noexcept;
+
+}
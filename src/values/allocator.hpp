@@ -1,66 +1,137 @@
 
 #pragma once
 
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <new>
 #include <utility>
-#include <cstdlib>
-#include <memory>
 
 namespace hk::builtin {
 
+/** The number of allocations made through an allocator.
+ */
+struct allocation_statistics {
+    std::size_t num_allocations = 0;
+    std::size_t num_deallocations = 0;
+
+    /** The number of bytes that are allocated and not yet deallocated.
+     */
+    std::size_t num_bytes = 0;
+
+    /** The largest value of `num_bytes`.
+     */
+    std::size_t max_num_bytes = 0;
+};
+
 class allocator_intf {
 public:
     virtual ~allocator_intf() = default;
-    
+
     /** Allocate memory.
-     * 
+     *
      * @param size The minimum size of memory to allocate.
      * @param alignment The alignment of the memory to allocate.
      * @return The pointer to the allocated memory, the actual size of the allocated memory.
+     * @throws std::bad_alloc When the memory could not be allocated.
      */
     [[nodiscard]] virtual std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment) = 0;
 
     /** Deallocate memory.
-     * 
+     *
      * @param ptr The location of allocated memory.
      * @param size The actual size of the allocated memory.
      */
     virtual void deallocate(void *ptr, std::size_t size) = 0;
+
+    /** Start or stop counting allocations.
+     *
+     * Counting is disabled by default, so that allocators that are used by
+     * many threads do not share the counters.
+     */
+    void enable_statistics(bool enable) noexcept
+    {
+        _statistics_enabled.store(enable, std::memory_order::relaxed);
+    }
+
+    [[nodiscard]] allocation_statistics statistics() const noexcept
+    {
+        return {
+            _num_allocations.load(std::memory_order::relaxed),
+            _num_deallocations.load(std::memory_order::relaxed),
+            _num_bytes.load(std::memory_order::relaxed),
+            _max_num_bytes.load(std::memory_order::relaxed)};
+    }
+
+protected:
+    /** Count an allocation, called by `allocate()`.
+     */
+    void count_allocation(std::size_t size) noexcept
+    {
+        if (_statistics_enabled.load(std::memory_order::relaxed)) [[unlikely]] {
+            _num_allocations.fetch_add(1, std::memory_order::relaxed);
+            auto const num_bytes = _num_bytes.fetch_add(size, std::memory_order::relaxed) + size;
+            auto max_num_bytes = _max_num_bytes.load(std::memory_order::relaxed);
+            while (num_bytes > max_num_bytes and
+                   not _max_num_bytes.compare_exchange_weak(max_num_bytes, num_bytes, std::memory_order::relaxed)) {}
+        }
+    }
+
+    /** Count a deallocation, called by `deallocate()`.
+     */
+    void count_deallocation(std::size_t size) noexcept
+    {
+        if (_statistics_enabled.load(std::memory_order::relaxed)) [[unlikely]] {
+            _num_deallocations.fetch_add(1, std::memory_order::relaxed);
+            _num_bytes.fetch_sub(size, std::memory_order::relaxed);
+        }
+    }
+
+private:
+    std::atomic<bool> _statistics_enabled = false;
+    std::atomic<std::size_t> _num_allocations = 0;
+    std::atomic<std::size_t> _num_deallocations = 0;
+    std::atomic<std::size_t> _num_bytes = 0;
+    std::atomic<std::size_t> _max_num_bytes = 0;
 };
 
+/** Allocate memory with the global `operator new`.
+ */
 class default_allocator : public allocator_intf {
 public:
     virtual ~default_allocator() = default;
 
-    default_allocator()
-    {
-        _allocator = std::default_allocator{};
-    }
+    default_allocator() noexcept = default;
 
+    /** Allocate memory.
+     *
+     * @pre `alignment` is at most the alignment of the global `operator new`.
+     */
     [[nodiscard]] std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment) override
     {
-        auto [ptr, actual_size] _allocator.allocate_at_least(size);
-        return {static_cast<void *>(ptr), actual_size};
+        assert(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        auto *ptr = ::operator new(size);
+        count_allocation(size);
+        return {ptr, size};
     }
 
     void deallocate(void *ptr, std::size_t size) override
     {
-        _allocator.deallocate(ptr, size);
+        count_deallocation(size);
+        ::operator delete(ptr, size);
     }
-
-private:
-    std::default_allocator<char> _allocator;
-}
+};
 
 inline default_allocator _default_allocator = default_allocator{};
 
-[[nodiscard]] std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment)
+[[nodiscard]] inline std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment)
 {
-    return _default_allocator(size, alignment);
+    return _default_allocator.allocate(size, alignment);
 }
 
-void deallocate(void *ptr, std::size_t size)
+inline void deallocate(void *ptr, std::size_t size)
 {
-    return _default_allocator(ptr, size);
+    return _default_allocator.deallocate(ptr, size);
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,58 @@
+
+#include "arena_allocator.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace hk::builtin {
+
+arena_allocator::~arena_allocator()
+{
+    for (auto const& block : _blocks) {
+        _upstream->deallocate(block.ptr, block.size);
+    }
+}
+
+arena_allocator::arena_allocator(std::size_t block_size, allocator_intf& upstream) noexcept :
+    _block_size(block_size), _upstream(&upstream)
+{
+    assert(block_size != 0);
+}
+
+arena_allocator& arena_allocator::local() noexcept
+{
+    thread_local auto r = arena_allocator{};
+    return r;
+}
+
+void arena_allocator::reset(mark_type mark) noexcept
+{
+    if (_blocks.empty()) {
+        return;
+    }
+
+    assert(mark.block <= _block);
+    for (auto i = mark.block + 1; i != _blocks.size(); ++i) {
+        _upstream->deallocate(_blocks[i].ptr, _blocks[i].size);
+    }
+    _blocks.resize(mark.block + 1);
+
+    auto const& block = _blocks[mark.block];
+    _block = mark.block;
+    _top = mark.top != nullptr ? mark.top : block.ptr;
+    _end = block.ptr + block.size;
+}
+
+char *arena_allocator::allocate_block(std::size_t size, std::size_t alignment)
+{
+    _blocks.reserve(_blocks.size() + 1);
+    auto const [ptr, block_size] = _upstream->allocate(std::max(_block_size, size + alignment), alignof(std::max_align_t));
+    _blocks.emplace_back(static_cast<char *>(ptr), block_size);
+
+    _block = _blocks.size() - 1;
+    _top = static_cast<char *>(ptr);
+    _end = _top + block_size;
+    return align(_top, alignment);
+}
+
+}
@@ -0,0 +1,151 @@
+
+#pragma once
+
+#include "allocator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hk::builtin {
+
+/** A bump allocator for short lived objects.
+ *
+ * Memory is handed out sequentially from large blocks, which are allocated
+ * from an upstream allocator. Deallocating the most recent allocation
+ * returns its memory to the arena, other deallocations do nothing; the
+ * memory is reclaimed all at once with `reset()`, usually through an
+ * `arena_scope`.
+ *
+ * An arena is not thread-safe; each thread uses its own `local()` arena.
+ * The statistics only count calls to `allocate()` and `deallocate()`, not
+ * the memory reclaimed by `reset()`.
+ */
+class arena_allocator : public allocator_intf {
+public:
+    /** The position in the arena, to reset to.
+     */
+    struct mark_type {
+        std::size_t block = 0;
+        char *top = nullptr;
+    };
+
+    constexpr static auto default_block_size = 0x10'0000uz;
+
+    virtual ~arena_allocator();
+
+    arena_allocator(arena_allocator const&) = delete;
+    arena_allocator(arena_allocator&&) = delete;
+    arena_allocator& operator=(arena_allocator const&) = delete;
+    arena_allocator& operator=(arena_allocator&&) = delete;
+
+    /** Create an arena.
+     *
+     * @param block_size The size of the blocks; larger allocations get their own block.
+     * @param upstream The allocator for the blocks.
+     */
+    explicit arena_allocator(std::size_t block_size = default_block_size, allocator_intf& upstream = _default_allocator) noexcept;
+
+    /** The arena of the current thread.
+     */
+    [[nodiscard]] static arena_allocator& local() noexcept;
+
+    [[nodiscard]] std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment) override
+    {
+        auto *ptr = align(_top, alignment);
+        if (ptr == nullptr or static_cast<std::size_t>(_end - ptr) < size) [[unlikely]] {
+            ptr = allocate_block(size, alignment);
+        }
+        _top = ptr + size;
+        count_allocation(size);
+        return {ptr, size};
+    }
+
+    void deallocate(void *ptr, std::size_t size) override
+    {
+        if (static_cast<char *>(ptr) + size == _top) {
+            _top = static_cast<char *>(ptr);
+        }
+        count_deallocation(size);
+    }
+
+    /** The current position in the arena.
+     */
+    [[nodiscard]] mark_type mark() const noexcept
+    {
+        return {_block, _top};
+    }
+
+    /** Deallocate everything that was allocated after @a mark.
+     *
+     * The blocks after the block of @a mark are returned upstream, the
+     * block of @a mark is kept to be reused.
+     */
+    void reset(mark_type mark) noexcept;
+
+    /** Deallocate everything, keeping the first block.
+     */
+    void reset() noexcept
+    {
+        reset(mark_type{});
+    }
+
+private:
+    struct block_type {
+        char *ptr;
+        std::size_t size;
+    };
+
+    std::size_t _block_size;
+    allocator_intf *_upstream;
+
+    std::vector<block_type> _blocks = {};
+
+    /** The index of the current block.
+     */
+    std::size_t _block = 0;
+    char *_top = nullptr;
+    char *_end = nullptr;
+
+    [[nodiscard]] static char *align(char *ptr, std::size_t alignment) noexcept
+    {
+        auto const address = (reinterpret_cast<std::uintptr_t>(ptr) + alignment - 1) & ~(alignment - 1);
+        return reinterpret_cast<char *>(address);
+    }
+
+    /** Continue in a new block, with room for @a size bytes.
+     *
+     * @return The aligned pointer to the allocation.
+     */
+    [[nodiscard]] char *allocate_block(std::size_t size, std::size_t alignment);
+};
+
+/** Reset an arena to its current position at the end of the scope.
+ *
+ * Objects allocated from the arena inside the scope must not outlive it.
+ */
+class arena_scope {
+public:
+    ~arena_scope()
+    {
+        _arena.reset(_mark);
+    }
+
+    arena_scope(arena_scope const&) = delete;
+    arena_scope(arena_scope&&) = delete;
+    arena_scope& operator=(arena_scope const&) = delete;
+    arena_scope& operator=(arena_scope&&) = delete;
+
+    explicit arena_scope(arena_allocator& arena = arena_allocator::local()) noexcept : _arena(arena), _mark(arena.mark()) {}
+
+    [[nodiscard]] arena_allocator& arena() const noexcept
+    {
+        return _arena;
+    }
+
+private:
+    arena_allocator& _arena;
+    arena_allocator::mark_type _mark;
+};
+
+}
@@ -0,0 +1,89 @@
+
+#include "arena_allocator.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+
+namespace {
+
+using hk::builtin::arena_allocator;
+using hk::builtin::arena_scope;
+
+[[nodiscard]] bool is_aligned(void *ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+TEST_SUITE(arena_allocator_suite)
+{
+
+TEST_CASE(bump)
+{
+    auto arena = arena_allocator{4096};
+
+    auto const [a, a_size] = arena.allocate(3, 1);
+    auto const [b, b_size] = arena.allocate(8, 8);
+    auto const [c, c_size] = arena.allocate(16, 16);
+    REQUIRE(a_size == 3);
+    REQUIRE(is_aligned(b, 8));
+    REQUIRE(is_aligned(c, 16));
+    REQUIRE(static_cast<char *>(b) >= static_cast<char *>(a) + 3);
+    REQUIRE(static_cast<char *>(c) >= static_cast<char *>(b) + 8);
+
+    // Deallocating the last allocation returns its memory.
+    arena.deallocate(c, c_size);
+    auto const [d, d_size] = arena.allocate(16, 16);
+    REQUIRE(d == c);
+
+    // Larger allocations than a block get their own block.
+    auto const [e, e_size] = arena.allocate(10000, 8);
+    REQUIRE(e_size == 10000);
+    REQUIRE(is_aligned(e, 8));
+}
+
+TEST_CASE(scope)
+{
+    auto arena = arena_allocator{256};
+
+    auto const [a, a_size] = arena.allocate(16, 8);
+    void *first = nullptr;
+    {
+        auto const scope = arena_scope{arena};
+        first = arena.allocate(16, 8).first;
+        for (auto i = 0; i != 100; ++i) {
+            static_cast<void>(arena.allocate(64, 8));
+        }
+    }
+
+    // After the scope the arena continues where it was at the start of the scope.
+    REQUIRE(arena.allocate(16, 8).first == first);
+
+    arena.reset();
+    REQUIRE(arena.allocate(16, 8).first == a);
+}
+
+TEST_CASE(statistics)
+{
+    auto arena = arena_allocator{};
+    arena.enable_statistics(true);
+
+    auto const [a, a_size] = arena.allocate(100, 8);
+    auto const [b, b_size] = arena.allocate(50, 8);
+    arena.deallocate(b, b_size);
+
+    auto const statistics = arena.statistics();
+    REQUIRE(statistics.num_allocations == 2);
+    REQUIRE(statistics.num_deallocations == 1);
+    REQUIRE(statistics.num_bytes == 100);
+    REQUIRE(statistics.max_num_bytes == 150);
+}
+
+TEST_CASE(local)
+{
+    auto& arena = arena_allocator::local();
+    auto const scope = arena_scope{};
+    REQUIRE(&scope.arena() == &arena);
+}
+
+}; // TEST_SUITE(arena_allocator_suite)
@@ -0,0 +1,264 @@
+
+#include "bitmap_allocator.hpp"
+#include "mmap_allocator.hpp"
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <new>
+#include <thread>
+
+namespace hk::builtin {
+
+namespace {
+
+constexpr auto full = ~std::uint64_t{0};
+
+/** A directory entry for the chunks of the directory itself.
+ */
+constexpr auto directory_entry = std::uint8_t{0x0f};
+
+/** A directory entry: the size class plus one, and the chunk's index in its page.
+ */
+[[nodiscard]] constexpr std::uint8_t make_directory_entry(std::size_t size_class, std::size_t index) noexcept
+{
+    return static_cast<std::uint8_t>((size_class + 1) | (index << 4));
+}
+
+[[nodiscard]] constexpr std::size_t object_size_of(std::size_t size_class) noexcept
+{
+    return (size_class + 1) * bitmap_allocator::min_object_size;
+}
+
+[[nodiscard]] std::atomic_ref<std::uint64_t> bitmap(char *ptr) noexcept
+{
+    return std::atomic_ref<std::uint64_t>{*reinterpret_cast<std::uint64_t *>(ptr)};
+}
+
+/** The bitmap of the full strides of a page, the second object of the first stride.
+ */
+[[nodiscard]] std::atomic_ref<std::uint64_t> page_bitmap(char *page, std::size_t object_size) noexcept
+{
+    return bitmap(page + object_size);
+}
+
+/** The bits of a stride's bitmap that are not objects.
+ */
+[[nodiscard]] constexpr std::uint64_t reserved_bits(std::size_t stride_index) noexcept
+{
+    return stride_index == 0 ? 0b11 : 0b01;
+}
+
+/** The stride where the current thread starts looking for a free object.
+ *
+ * Threads start at different strides of a page, so that they do not
+ * contend on the same bitmap.
+ */
+[[nodiscard]] unsigned int start_stride() noexcept
+{
+    thread_local auto const r = static_cast<unsigned int>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % 64);
+    return r;
+}
+
+/** Mark a stride as full in the page bitmap.
+ *
+ * A thread deallocating from the stride may have cleared the page bit just
+ * before it is set here; so check again afterwards, as a page bit must not
+ * stay set for a stride with free objects.
+ */
+void mark_full(std::atomic_ref<std::uint64_t> page_map, std::atomic_ref<std::uint64_t> stride_map, std::size_t stride_index) noexcept
+{
+    auto const mask = std::uint64_t{1} << stride_index;
+    page_map.fetch_or(mask);
+    if ((stride_map.load() | reserved_bits(stride_index)) != full) {
+        page_map.fetch_and(~mask);
+    }
+}
+
+/** Allocate an object from a page.
+ *
+ * @return The object, or nullptr when the page is full.
+ */
+[[nodiscard]] void *allocate_from_page(char *page, std::size_t object_size) noexcept
+{
+    auto const stride_size = object_size * 64;
+    auto const page_map = page_bitmap(page, object_size);
+    auto const start = start_stride();
+
+    auto full_strides = page_map.load(std::memory_order::relaxed);
+    while (full_strides != full) {
+        auto const i = (start + static_cast<unsigned int>(std::countr_one(std::rotr(full_strides, static_cast<int>(start))))) % 64;
+        auto *const stride = page + i * stride_size;
+        auto const stride_map = bitmap(stride);
+        auto const reserved = reserved_bits(i);
+
+        auto bits = stride_map.load(std::memory_order::relaxed);
+        while ((bits | reserved) != full) {
+            // Another thread may claim the same bit, then try the next free bit.
+            auto const mask = std::uint64_t{1} << std::countr_one(bits | reserved);
+            bits = stride_map.fetch_or(mask, std::memory_order::acquire);
+            if ((bits & mask) == 0) {
+                if ((bits | mask | reserved) == full) {
+                    mark_full(page_map, stride_map, i);
+                }
+                return stride + static_cast<std::size_t>(std::countr_zero(mask)) * object_size;
+            }
+        }
+
+        // The stride was filled by other threads, which may not have marked it yet.
+        mark_full(page_map, stride_map, i);
+        full_strides = page_map.load(std::memory_order::relaxed);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bitmap_allocator::~bitmap_allocator()
+{
+    _mmap_allocator.deallocate(_region, _num_segments * segment_size);
+}
+
+bitmap_allocator::bitmap_allocator(std::size_t num_segments, allocator_intf& upstream) :
+    _num_segments(num_segments), _upstream(&upstream)
+{
+    assert(num_segments != 0 and num_segments <= max_num_segments);
+
+    auto const [ptr, size] = _mmap_allocator.allocate(num_segments * segment_size, segment_size);
+    assert(size == num_segments * segment_size);
+    _region = static_cast<char *>(ptr);
+
+    static_assert(directory_size % chunk_size == 0);
+    for (auto i = 0uz; i != directory_size / chunk_size; ++i) {
+        directory()[i] = directory_entry;
+    }
+}
+
+std::pair<void *, std::size_t> bitmap_allocator::allocate(std::size_t size, std::size_t alignment)
+{
+    assert(std::has_single_bit(alignment));
+
+    auto const size_class = size == 0 ? 0uz : (size - 1) / min_object_size;
+    auto const object_size = object_size_of(size_class);
+
+    // An object is aligned to the largest power of two that divides its size.
+    if (size_class >= num_size_classes) {
+        return _upstream->allocate(size, alignment);
+    } else if (alignment > (object_size & (0 - object_size))) {
+        return _upstream->allocate(max_object_size + 1, alignment);
+    }
+
+    auto *ptr = static_cast<void *>(nullptr);
+    if (auto *page = _pages[size_class].load(std::memory_order::acquire)) [[likely]] {
+        ptr = allocate_from_page(page, object_size);
+    }
+    if (ptr == nullptr) [[unlikely]] {
+        ptr = allocate_slow(size_class);
+    }
+
+    count_allocation(object_size);
+    return {ptr, object_size};
+}
+
+void bitmap_allocator::deallocate(void *ptr, std::size_t size)
+{
+    if (size > max_object_size) {
+        return _upstream->deallocate(ptr, size);
+    }
+
+    assert(contains(ptr));
+    assert(size % min_object_size == 0);
+    count_deallocation(size);
+
+    auto const chunk = static_cast<std::size_t>(static_cast<char *>(ptr) - _region) / chunk_size;
+    auto const entry = directory()[chunk];
+    assert(entry != 0 and entry != directory_entry);
+    assert(object_size_of((entry & 0x0f) - 1uz) == size);
+
+    auto *const page = _region + (chunk - (entry >> 4)) * chunk_size;
+    auto const offset = static_cast<std::size_t>(static_cast<char *>(ptr) - page);
+    auto const stride_index = offset / (size * 64);
+    auto *const stride = page + stride_index * size * 64;
+    auto const mask = std::uint64_t{1} << ((offset % (size * 64)) / size);
+    assert((mask & reserved_bits(stride_index)) == 0);
+
+    auto const bits = bitmap(stride).fetch_and(~mask);
+    assert((bits & mask) != 0);
+    if ((bits | reserved_bits(stride_index)) == full) {
+        page_bitmap(page, size).fetch_and(~(std::uint64_t{1} << stride_index));
+    }
+}
+
+std::size_t bitmap_allocator::num_pages(std::size_t size) const noexcept
+{
+    assert(size != 0 and size <= max_object_size);
+
+    auto const size_class = (size - 1) / min_object_size;
+    auto r = 0uz;
+    for (auto i = 0uz; i != _num_segments * num_chunks_per_segment; ++i) {
+        r += directory()[i] == make_directory_entry(size_class, 0);
+    }
+    return r;
+}
+
+void *bitmap_allocator::allocate_slow(std::size_t size_class)
+{
+    auto const object_size = object_size_of(size_class);
+    auto const lock = std::scoped_lock(_mutex);
+
+    // Another thread may have replaced the page while waiting for the lock.
+    auto *current = _pages[size_class].load(std::memory_order::relaxed);
+    if (current != nullptr) {
+        if (auto *ptr = allocate_from_page(current, object_size)) {
+            return ptr;
+        }
+    }
+
+    // Continue with a page that has objects that were deallocated.
+    auto const entry = make_directory_entry(size_class, 0);
+    for (auto i = 0uz; i != _num_used_segments * num_chunks_per_segment; ++i) {
+        auto *const page = _region + i * chunk_size;
+        if (directory()[i] != entry or page == current) {
+            continue;
+        }
+        if (auto *ptr = allocate_from_page(page, object_size)) {
+            _pages[size_class].store(page, std::memory_order::release);
+            return ptr;
+        }
+    }
+
+    // Allocate an object from a new page before publishing it, so that
+    // this thread is guaranteed to make progress.
+    auto *const page = carve_page(size_class);
+    auto *const ptr = allocate_from_page(page, object_size);
+    assert(ptr != nullptr);
+    _pages[size_class].store(page, std::memory_order::release);
+    return ptr;
+}
+
+char *bitmap_allocator::carve_page(std::size_t size_class)
+{
+    auto const num_chunks = size_class + 1;
+
+    for (auto segment = 0uz; segment != _num_segments; ++segment) {
+        if (segment == _num_used_segments) {
+            ++_num_used_segments;
+        }
+
+        // Find the first run of free chunks in the segment.
+        auto *const entries = directory() + segment * num_chunks_per_segment;
+        auto run = 0uz;
+        for (auto i = 0uz; i != num_chunks_per_segment; ++i) {
+            run = entries[i] == 0 ? run + 1 : 0;
+            if (run == num_chunks) {
+                auto const first = i + 1 - num_chunks;
+                for (auto j = 0uz; j != num_chunks; ++j) {
+                    entries[first + j] = make_directory_entry(size_class, j);
+                }
+                return _region + (segment * num_chunks_per_segment + first) * chunk_size;
+            }
+        }
+    }
+    throw std::bad_alloc{};
+}
+
+}
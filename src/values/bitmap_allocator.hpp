@@ -0,0 +1,134 @@
+
+#pragma once
+
+#include "allocator.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <utility>
+
+namespace hk::builtin {
+
+/** A lock-free allocator for small objects of 8 to 64 bytes.
+ *
+ * This is the host implementation of `std.bitmap_allocator`, with the same
+ * memory layout, so that objects allocated during compile-time evaluation
+ * can be relocated into the executable.
+ *
+ * All memory comes from a single region of 256 KiB segments, mapped by the
+ * `mmap_allocator`. Segments are carved into pages, one size class per
+ * page, in chunks of 32 KiB:
+ *
+ *  | object size | page size | stride size | # strides | # objects per stride |
+ *  | -----------:| ---------:| -----------:| ---------:| --------------------:|
+ *  |           8 |    32 KiB |         512 |        64 |                   63 |
+ *  |          16 |    64 KiB |        1024 |        64 |                   63 |
+ *  |         ... |       ... |         ... |       ... |                  ... |
+ *  |          64 |   256 KiB |        4096 |        64 |                   63 |
+ *
+ * The first object of each stride is the 64-bit bitmap of the objects in use
+ * in that stride. The second object of the first stride is the bitmap of the
+ * full strides of the page. The first 64 KiB of the region is the directory,
+ * one byte per chunk with the size class of the page it belongs to.
+ *
+ * Objects are allocated by setting a bit with an atomic fetch-or and
+ * deallocated by clearing it with an atomic fetch-and. Only carving a new
+ * page takes a lock. Larger and over-aligned objects are allocated from the
+ * upstream allocator.
+ */
+class bitmap_allocator : public allocator_intf {
+public:
+    constexpr static auto min_object_size = 8uz;
+    constexpr static auto max_object_size = 64uz;
+    constexpr static auto num_size_classes = max_object_size / min_object_size;
+    constexpr static auto segment_size = 0x4'0000uz;
+    constexpr static auto chunk_size = 0x8000uz;
+    constexpr static auto num_chunks_per_segment = segment_size / chunk_size;
+
+    /** The number of segments that the directory can describe, 2 GiB.
+     */
+    constexpr static auto max_num_segments = 0x2000uz;
+    constexpr static auto directory_size = max_num_segments * num_chunks_per_segment;
+
+    virtual ~bitmap_allocator();
+
+    bitmap_allocator(bitmap_allocator const&) = delete;
+    bitmap_allocator(bitmap_allocator&&) = delete;
+    bitmap_allocator& operator=(bitmap_allocator const&) = delete;
+    bitmap_allocator& operator=(bitmap_allocator&&) = delete;
+
+    /** Create an allocator.
+     *
+     * The region is reserved up front, its pages are only committed when
+     * they are first used.
+     *
+     * @param num_segments The number of segments in the region.
+     * @param upstream The allocator for objects larger than `max_object_size`.
+     */
+    explicit bitmap_allocator(std::size_t num_segments = max_num_segments, allocator_intf& upstream = _default_allocator);
+
+    /** Allocate memory.
+     *
+     * @return The pointer and the size rounded up to a multiple of 8 bytes.
+     *         The size of an over-aligned small object, which is allocated
+     *         upstream, is rounded up beyond `max_object_size`.
+     * @throws std::bad_alloc When the region is full.
+     */
+    [[nodiscard]] std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment) override;
+
+    void deallocate(void *ptr, std::size_t size) override;
+
+    /** The region from which the small objects are allocated.
+     *
+     * Pointers into the region are relocated by their offset.
+     */
+    [[nodiscard]] std::span<std::byte const> region() const noexcept
+    {
+        return {reinterpret_cast<std::byte const *>(_region), _num_segments * segment_size};
+    }
+
+    [[nodiscard]] bool contains(void const *ptr) const noexcept
+    {
+        auto const offset = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(_region);
+        return offset < _num_segments * segment_size;
+    }
+
+    /** The number of pages carved for objects of @a size bytes.
+     */
+    [[nodiscard]] std::size_t num_pages(std::size_t size) const noexcept;
+
+private:
+    char *_region;
+    std::size_t _num_segments;
+    allocator_intf *_upstream;
+
+    /** The page of each size class that is used for allocation.
+     */
+    std::array<std::atomic<char *>, num_size_classes> _pages = {};
+
+    /** The lock for carving pages.
+     */
+    std::mutex _mutex;
+
+    /** The number of segments that have been carved into, guarded by `_mutex`.
+     */
+    std::size_t _num_used_segments = 1;
+
+    [[nodiscard]] std::uint8_t *directory() const noexcept
+    {
+        return reinterpret_cast<std::uint8_t *>(_region);
+    }
+
+    [[nodiscard]] void *allocate_slow(std::size_t size_class);
+
+    /** Carve a page from the first segment with enough free chunks.
+     *
+     * @pre `_mutex` is locked.
+     */
+    [[nodiscard]] char *carve_page(std::size_t size_class);
+};
+
+}
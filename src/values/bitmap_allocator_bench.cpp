@@ -0,0 +1,83 @@
+
+#include "bitmap_allocator.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using hk::builtin::bitmap_allocator;
+
+/** 1024 random object sizes of 1 to 64 bytes.
+ */
+[[nodiscard]] std::vector<std::size_t> make_sizes(int seed)
+{
+    auto engine = std::mt19937{static_cast<unsigned int>(seed)};
+
+    auto r = std::vector<std::size_t>{};
+    r.reserve(1024);
+    for (auto i = 0uz; i != 1024; ++i) {
+        r.push_back(engine() % 64 + 1);
+    }
+    return r;
+}
+
+/** The allocator shared by the threads of a benchmark.
+ */
+[[nodiscard]] bitmap_allocator& shared_allocator()
+{
+    static auto r = bitmap_allocator{};
+    return r;
+}
+
+/** Allocate and deallocate 1024 small objects per thread.
+ *
+ * The objects are touched, so that the cost of sharing cache lines between
+ * threads is included.
+ */
+void bm_bitmap_allocator(benchmark::State& state)
+{
+    auto& allocator = shared_allocator();
+    auto const sizes = make_sizes(state.thread_index());
+    auto objects = std::vector<std::pair<void *, std::size_t>>(sizes.size());
+
+    for (auto _ : state) {
+        for (auto i = 0uz; i != sizes.size(); ++i) {
+            objects[i] = allocator.allocate(sizes[i], 8);
+            *static_cast<char *>(objects[i].first) = 1;
+        }
+        for (auto const [ptr, size] : objects) {
+            allocator.deallocate(ptr, size);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sizes.size()));
+}
+
+/** The same as `bm_bitmap_allocator()` with `std::malloc()` as a baseline.
+ */
+void bm_malloc(benchmark::State& state)
+{
+    auto const sizes = make_sizes(state.thread_index());
+    auto objects = std::vector<void *>(sizes.size());
+
+    for (auto _ : state) {
+        for (auto i = 0uz; i != sizes.size(); ++i) {
+            objects[i] = std::malloc(sizes[i]);
+            *static_cast<char *>(objects[i]) = 1;
+        }
+        for (auto const ptr : objects) {
+            std::free(ptr);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sizes.size()));
+}
+
+} // namespace
+
+BENCHMARK(bm_bitmap_allocator)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_malloc)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,221 @@
+
+#include "bitmap_allocator.hpp"
+#include <hikotest/hikotest.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using hk::builtin::bitmap_allocator;
+
+} // namespace
+
+TEST_SUITE(bitmap_allocator_suite)
+{
+
+TEST_CASE(size_classes)
+{
+    auto allocator = bitmap_allocator{8};
+
+    for (auto size = 1uz; size <= bitmap_allocator::max_object_size; ++size) {
+        auto const [ptr, actual_size] = allocator.allocate(size, 8);
+        REQUIRE(actual_size == (size + 7) / 8 * 8);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % 8 == 0);
+        REQUIRE(allocator.contains(ptr));
+        std::memset(ptr, 0xff, actual_size);
+        allocator.deallocate(ptr, actual_size);
+    }
+
+    // Larger and over-aligned objects are allocated upstream.
+    auto const [large, large_size] = allocator.allocate(100, 8);
+    REQUIRE(large_size == 100);
+    REQUIRE(not allocator.contains(large));
+    allocator.deallocate(large, large_size);
+
+    auto const [aligned, aligned_size] = allocator.allocate(24, 16);
+    REQUIRE(aligned_size > bitmap_allocator::max_object_size);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 16 == 0);
+    allocator.deallocate(aligned, aligned_size);
+}
+
+TEST_CASE(layout)
+{
+    auto allocator = bitmap_allocator{8};
+    auto const* const region = allocator.region().data();
+
+    // The first segment holds the directory and the pages of 8, 16 and 24 byte objects.
+    auto const [a, a_size] = allocator.allocate(8, 8);
+    auto const [b, b_size] = allocator.allocate(16, 8);
+    auto const [c, c_size] = allocator.allocate(24, 8);
+    auto const [d, d_size] = allocator.allocate(64, 8);
+    auto const offset = [&](void *ptr) {
+        return static_cast<std::size_t>(static_cast<std::byte *>(ptr) - region);
+    };
+
+    // The index of an object in its stride, the first stride also skips the page bitmap.
+    auto const object_index = [&](void *ptr, std::size_t page, std::size_t object_size) {
+        auto const page_offset = offset(ptr) - page;
+        auto const index = page_offset % (object_size * 64) / object_size;
+        return page_offset < object_size * 64 ? index - 1 : index;
+    };
+
+    // A page of N * 8 byte objects is N chunks of 32 KiB.
+    auto const in_page = [&](void *ptr, std::size_t page, std::size_t object_size) {
+        return offset(ptr) >= page and offset(ptr) < page + object_size * 4096;
+    };
+
+    REQUIRE(in_page(a, 0x1'0000, 8));
+    REQUIRE(object_index(a, 0x1'0000, 8) == 1);
+    REQUIRE(in_page(b, 0x1'8000, 16));
+    REQUIRE(object_index(b, 0x1'8000, 16) == 1);
+    REQUIRE(in_page(c, 0x2'8000, 24));
+    REQUIRE(object_index(c, 0x2'8000, 24) == 1);
+    REQUIRE(in_page(d, 0x4'0000, 64));
+    REQUIRE(object_index(d, 0x4'0000, 64) == 1);
+}
+
+TEST_CASE(reuse)
+{
+    auto allocator = bitmap_allocator{8};
+
+    // A page of 64 byte objects holds 64 strides of 63 objects, minus the page bitmap.
+    auto objects = std::vector<void *>{};
+    for (auto i = 0uz; i != 64 * 63 + 100; ++i) {
+        auto const [ptr, size] = allocator.allocate(64, 8);
+        *static_cast<std::size_t *>(ptr) = i;
+        objects.push_back(ptr);
+    }
+    REQUIRE(allocator.num_pages(64) == 2);
+
+    std::ranges::sort(objects);
+    REQUIRE(std::ranges::adjacent_find(objects) == objects.end());
+
+    // Freed objects are reused before carving another page.
+    for (auto const ptr : objects) {
+        allocator.deallocate(ptr, 64);
+    }
+    for (auto i = 0uz; i != 64 * 63 + 100; ++i) {
+        static_cast<void>(allocator.allocate(64, 8));
+    }
+    REQUIRE(allocator.num_pages(64) == 2);
+}
+
+TEST_CASE(out_of_memory)
+{
+    auto allocator = bitmap_allocator{1};
+
+    // A page of 64 byte objects is a whole segment, which does not fit next to the directory.
+    auto thrown = false;
+    try {
+        static_cast<void>(allocator.allocate(64, 8));
+    } catch (std::bad_alloc const&) {
+        thrown = true;
+    }
+    REQUIRE(thrown);
+}
+
+TEST_CASE(statistics)
+{
+    auto allocator = bitmap_allocator{8};
+    allocator.enable_statistics(true);
+
+    auto const [a, a_size] = allocator.allocate(5, 8);
+    auto const [b, b_size] = allocator.allocate(20, 8);
+    allocator.deallocate(a, a_size);
+
+    auto const statistics = allocator.statistics();
+    REQUIRE(statistics.num_allocations == 2);
+    REQUIRE(statistics.num_deallocations == 1);
+    REQUIRE(statistics.num_bytes == 24);
+    REQUIRE(statistics.max_num_bytes == 32);
+}
+
+TEST_CASE(stress)
+{
+    constexpr auto num_threads = 8;
+    constexpr auto num_rounds = 20;
+    constexpr auto num_objects = 2000;
+
+    using object_type = std::pair<void *, std::size_t>;
+
+    auto allocator = bitmap_allocator{64};
+    auto corrupted = std::atomic<bool>{false};
+
+    // Each thread fills its objects with a pattern, and checks it before
+    // deallocating. Half of the objects of each round are handed to the next
+    // thread, so that objects are also deallocated by another thread.
+    auto mailboxes = std::vector<std::vector<object_type>>(num_threads);
+    auto mailbox_full = std::vector<std::atomic<bool>>(num_threads);
+
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t != num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto const previous = (t + num_threads - 1) % num_threads;
+            auto const next = (t + 1) % num_threads;
+            auto engine = std::mt19937{static_cast<unsigned int>(t)};
+            auto objects = std::vector<object_type>{};
+            auto num_received = 0;
+
+            auto const check_and_deallocate = [&](object_type const& object, int pattern) {
+                auto const *const bytes = static_cast<unsigned char const *>(object.first);
+                if (std::any_of(bytes, bytes + object.second, [&](auto c) {
+                        return c != pattern;
+                    })) {
+                    corrupted = true;
+                }
+                allocator.deallocate(object.first, object.second);
+            };
+
+            auto const receive = [&] {
+                if (mailbox_full[t].load(std::memory_order::acquire)) {
+                    for (auto const& object : mailboxes[t]) {
+                        check_and_deallocate(object, previous);
+                    }
+                    mailboxes[t].clear();
+                    mailbox_full[t].store(false, std::memory_order::release);
+                    ++num_received;
+                }
+            };
+
+            for (auto round = 0; round != num_rounds; ++round) {
+                for (auto i = 0; i != num_objects; ++i) {
+                    auto const [ptr, size] = allocator.allocate(engine() % 64 + 1, 8);
+                    std::memset(ptr, t, size);
+                    objects.emplace_back(ptr, size);
+                }
+
+                while (mailbox_full[next].load(std::memory_order::acquire)) {
+                    receive();
+                    std::this_thread::yield();
+                }
+                mailboxes[next].assign(objects.begin(), objects.begin() + num_objects / 2);
+                mailbox_full[next].store(true, std::memory_order::release);
+
+                for (auto i = num_objects / 2; i != num_objects; ++i) {
+                    check_and_deallocate(objects[i], t);
+                }
+                objects.clear();
+                receive();
+            }
+
+            while (num_received != num_rounds) {
+                receive();
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(not corrupted);
+}
+
+}; // TEST_SUITE(bitmap_allocator_suite)
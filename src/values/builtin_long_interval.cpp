@@ -0,0 +1,187 @@
+
+#include "builtin_long_interval.hpp"
+#include <initializer_list>
+#include <optional>
+
+namespace hk::builtin {
+
+namespace {
+
+/** The interval of the products or quotients of the corners of two intervals.
+ */
+template<typename Op>
+[[nodiscard]] long_interval corners(long_int const& a, long_int const& b, long_int const& c, long_int const& d, Op op)
+{
+    auto const ac = op(a, c);
+    auto const ad = op(a, d);
+    auto const bc = op(b, c);
+    auto const bd = op(b, d);
+    return {std::min({ac, ad, bc, bd}), std::max({ac, ad, bc, bd})};
+}
+
+/** The interval `[-2^n, 2^n - 1]` of integers with `n` bits and a sign bit.
+ */
+[[nodiscard]] long_interval signed_bits(std::size_t n)
+{
+    auto const p = long_int{1} << n;
+    return {-p, p - long_int{1}};
+}
+
+/** The number of bits, excluding the sign bit, of every value in both intervals.
+ */
+[[nodiscard]] std::size_t max_bit_width(long_interval const& lhs, long_interval const& rhs) noexcept
+{
+    return std::max({lhs.lo().bit_width(), lhs.hi().bit_width(), rhs.lo().bit_width(), rhs.hi().bit_width()});
+}
+
+/** Restrict a range to a bound that is known to hold.
+ */
+[[nodiscard]] long_interval clamp(long_interval const& range, long_int lo, long_int hi)
+{
+    return {std::max(range.lo(), lo), std::min(range.hi(), hi)};
+}
+
+} // namespace
+
+long_interval long_interval::mul_slow(long_interval const& lhs, long_interval const& rhs)
+{
+    return corners(lhs._lo, lhs._hi, rhs._lo, rhs._hi, [](auto const& x, auto const& y) {
+        return x * y;
+    });
+}
+
+long_interval operator/(long_interval const& lhs, long_interval const& rhs)
+{
+    auto const zero = long_int{0};
+    auto const one = long_int{1};
+    assert(rhs.lo() != zero or rhs.hi() != zero);
+
+    auto const div = [](auto const& x, auto const& y) {
+        return x / y;
+    };
+
+    // The quotient is monotonic in both operands for divisors of the same
+    // sign, so split the divisor at zero.
+    auto r = std::optional<long_interval>{};
+    if (rhs.lo() < zero) {
+        r = corners(lhs.lo(), lhs.hi(), rhs.lo(), std::min(rhs.hi(), -one), div);
+    }
+    if (rhs.hi() > zero) {
+        auto const positive = corners(lhs.lo(), lhs.hi(), std::max(rhs.lo(), one), rhs.hi(), div);
+        r = r ? hull(*r, positive) : positive;
+    }
+    return *r;
+}
+
+long_interval operator%(long_interval const& lhs, long_interval const& rhs)
+{
+    auto const zero = long_int{0};
+    auto const one = long_int{1};
+    assert(rhs.lo() != zero or rhs.hi() != zero);
+
+    // The magnitude of the remainder is less than the magnitude of the divisor.
+    auto const max_divisor = std::max(-rhs.lo(), rhs.hi());
+    auto min_divisor = one;
+    if (rhs.lo() > zero) {
+        min_divisor = rhs.lo();
+    } else if (rhs.hi() < zero) {
+        min_divisor = -rhs.hi();
+    }
+
+    // A dividend that is smaller in magnitude than every divisor is the remainder.
+    if (-min_divisor < lhs.lo() and lhs.hi() < min_divisor) {
+        return lhs;
+    }
+
+    auto const max_remainder = max_divisor - one;
+    return {
+        lhs.lo() < zero ? std::max(lhs.lo(), -max_remainder) : zero,
+        lhs.hi() > zero ? std::min(lhs.hi(), max_remainder) : zero};
+}
+
+long_interval operator<<(long_interval const& lhs, long_interval const& rhs)
+{
+    assert(not rhs.lo().is_negative());
+    auto const min_shift = rhs.lo().to<std::size_t>().value();
+    auto const max_shift = rhs.hi().to<std::size_t>().value();
+
+    // Shifting left moves a value away from zero.
+    return {
+        lhs.lo() << (lhs.lo().is_negative() ? max_shift : min_shift),
+        lhs.hi() << (lhs.hi().is_negative() ? min_shift : max_shift)};
+}
+
+long_interval operator>>(long_interval const& lhs, long_interval const& rhs)
+{
+    assert(not rhs.lo().is_negative());
+
+    // A shift beyond the bit width of the bounds results in 0 or -1.
+    auto const max_useful_shift = std::max(lhs.lo().bit_width(), lhs.hi().bit_width()) + 1;
+    auto const clamp_shift = [&](long_int const& shift) {
+        return shift.to<std::size_t>().value_or(max_useful_shift);
+    };
+    auto const min_shift = std::min(clamp_shift(rhs.lo()), max_useful_shift);
+    auto const max_shift = std::min(clamp_shift(rhs.hi()), max_useful_shift);
+
+    // Shifting right moves a value toward zero or -1.
+    return {
+        lhs.lo() >> (lhs.lo().is_negative() ? min_shift : max_shift),
+        lhs.hi() >> (lhs.hi().is_negative() ? max_shift : min_shift)};
+}
+
+long_interval operator&(long_interval const& lhs, long_interval const& rhs)
+{
+    auto const zero = long_int{0};
+    auto r = signed_bits(max_bit_width(lhs, rhs));
+
+    // Clearing bits makes a value smaller, and a non-negative operand clears the sign bit.
+    if (not lhs.lo().is_negative()) {
+        r = clamp(r, zero, lhs.hi());
+    }
+    if (not rhs.lo().is_negative()) {
+        r = clamp(r, zero, rhs.hi());
+    }
+    if (lhs.hi().is_negative() and rhs.hi().is_negative()) {
+        r = clamp(r, r.lo(), std::min(lhs.hi(), rhs.hi()));
+    }
+    return r;
+}
+
+long_interval operator|(long_interval const& lhs, long_interval const& rhs)
+{
+    auto const minus_one = long_int{-1};
+    auto r = signed_bits(max_bit_width(lhs, rhs));
+
+    // Setting bits makes a value larger, and a negative operand sets the sign bit.
+    if (lhs.hi().is_negative()) {
+        r = clamp(r, lhs.lo(), minus_one);
+    }
+    if (rhs.hi().is_negative()) {
+        r = clamp(r, rhs.lo(), minus_one);
+    }
+    if (not lhs.lo().is_negative() and not rhs.lo().is_negative()) {
+        r = clamp(r, std::max(lhs.lo(), rhs.lo()), r.hi());
+    }
+    return r;
+}
+
+long_interval operator^(long_interval const& lhs, long_interval const& rhs)
+{
+    auto const zero = long_int{0};
+    auto const minus_one = long_int{-1};
+    auto r = signed_bits(max_bit_width(lhs, rhs));
+
+    // The sign bit of the result is the exclusive-or of the sign bits.
+    auto const lhs_sign = lhs.lo().is_negative() == lhs.hi().is_negative() ? std::optional{lhs.lo().is_negative()} : std::nullopt;
+    auto const rhs_sign = rhs.lo().is_negative() == rhs.hi().is_negative() ? std::optional{rhs.lo().is_negative()} : std::nullopt;
+    if (lhs_sign and rhs_sign) {
+        if (*lhs_sign == *rhs_sign) {
+            r = clamp(r, zero, r.hi());
+        } else {
+            r = clamp(r, r.lo(), minus_one);
+        }
+    }
+    return r;
+}
+
+}
@@ -1,14 +1,244 @@
 
 #pragma once
 
-#include "long.hpp"
+#include "long_int.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <utility>
 
 namespace hk::builtin {
 
-struct long_interval : public symbol_type {
-    builtin_long lo;
-    builtin_long hi;
+/** The smallest machine integer that holds every value of an interval.
+ */
+struct machine_integer {
+    /** The number of bits: 8, 16, 32, 64, 128, ...
+     */
+    std::size_t num_bits = 8;
+
+    bool is_signed = false;
+
+    [[nodiscard]] constexpr friend bool operator==(machine_integer const&, machine_integer const&) noexcept = default;
+};
+
+/** A closed interval of integers, the range of an `int[lo..=hi]` type.
+ *
+ * The operators calculate the range of the result of an operation on two
+ * integers, each in its own range. For example `int[10..=20] * int[2..=4]`
+ * results in `int[20..=80]`.
+ *
+ * When the bounds of both operands fit in 64 bits, the results of addition,
+ * subtraction and multiplication are calculated inline with 128-bit integers.
+ */
+class long_interval {
+public:
+    /** The interval `[0, 0]`.
+     */
+    constexpr long_interval() noexcept = default;
+
+    /** The interval with a single value.
+     */
+    explicit long_interval(long_int value) : _lo(value), _hi(std::move(value)) {}
+
+    /** The interval `[lo, hi]`.
+     *
+     * @pre @a lo is less than or equal to @a hi.
+     */
+    long_interval(long_int lo, long_int hi) : _lo(std::move(lo)), _hi(std::move(hi))
+    {
+        assert(_lo <= _hi);
+    }
+
+    [[nodiscard]] long_int const& lo() const noexcept
+    {
+        return _lo;
+    }
+
+    [[nodiscard]] long_int const& hi() const noexcept
+    {
+        return _hi;
+    }
+
+    /** Both bounds fit in 64 bits.
+     */
+    [[nodiscard]] bool is_inline() const noexcept
+    {
+        return _lo.is_inline() and _hi.is_inline();
+    }
+
+    [[nodiscard]] bool contains(long_int const& value) const noexcept
+    {
+        return _lo <= value and value <= _hi;
+    }
+
+    /** Every value of @a other is in this interval.
+     *
+     * A conversion from @a other to this interval is widening.
+     */
+    [[nodiscard]] bool contains(long_interval const& other) const noexcept
+    {
+        return _lo <= other._lo and other._hi <= _hi;
+    }
+
+    /** Some values of @a other are in this interval.
+     *
+     * A conversion from @a other to this interval is narrowing when it
+     * overlaps but is not contained.
+     */
+    [[nodiscard]] bool overlaps(long_interval const& other) const noexcept
+    {
+        return _lo <= other._hi and other._lo <= _hi;
+    }
+
+    /** The number of bits to represent every value of the interval.
+     *
+     * @return The number of bits, including the sign bit when the interval
+     *         contains negative values; and if the integer is signed.
+     */
+    [[nodiscard]] machine_integer num_bits() const noexcept
+    {
+        if (_lo.is_negative()) {
+            return {std::max(_lo.bit_width(), _hi.bit_width()) + 1, true};
+        } else {
+            return {_hi.bit_width(), false};
+        }
+    }
+
+    /** The smallest machine integer of at least 8 bits that holds every value of the interval.
+     *
+     * An interval without negative values uses an unsigned integer.
+     */
+    [[nodiscard]] machine_integer to_machine_integer() const noexcept
+    {
+        auto r = num_bits();
+        r.num_bits = std::bit_ceil(std::max(r.num_bits, 8uz));
+        return r;
+    }
+
+    /** The smallest interval that contains both intervals.
+     */
+    [[nodiscard]] friend long_interval hull(long_interval const& lhs, long_interval const& rhs)
+    {
+        return {std::min(lhs._lo, rhs._lo), std::max(lhs._hi, rhs._hi)};
+    }
+
+    [[nodiscard]] friend bool operator==(long_interval const&, long_interval const&) noexcept = default;
+
+    [[nodiscard]] friend long_interval operator-(long_interval const& rhs)
+    {
+        return {-rhs._hi, -rhs._lo};
+    }
+
+    /** The range of `~x`, which is `-x - 1`.
+     */
+    [[nodiscard]] friend long_interval operator~(long_interval const& rhs)
+    {
+        return {-rhs._hi - long_int{1}, -rhs._lo - long_int{1}};
+    }
+
+    [[nodiscard]] friend long_interval operator+(long_interval const& lhs, long_interval const& rhs)
+    {
+#if defined(__SIZEOF_INT128__)
+        if (lhs.is_inline() and rhs.is_inline()) [[likely]] {
+            return {
+                long_int{static_cast<__int128>(lhs._lo.inline_value()) + rhs._lo.inline_value()},
+                long_int{static_cast<__int128>(lhs._hi.inline_value()) + rhs._hi.inline_value()}};
+        }
+#endif
+        return {lhs._lo + rhs._lo, lhs._hi + rhs._hi};
+    }
+
+    [[nodiscard]] friend long_interval operator-(long_interval const& lhs, long_interval const& rhs)
+    {
+#if defined(__SIZEOF_INT128__)
+        if (lhs.is_inline() and rhs.is_inline()) [[likely]] {
+            return {
+                long_int{static_cast<__int128>(lhs._lo.inline_value()) - rhs._hi.inline_value()},
+                long_int{static_cast<__int128>(lhs._hi.inline_value()) - rhs._lo.inline_value()}};
+        }
+#endif
+        return {lhs._lo - rhs._hi, lhs._hi - rhs._lo};
+    }
+
+    [[nodiscard]] friend long_interval operator*(long_interval const& lhs, long_interval const& rhs)
+    {
+#if defined(__SIZEOF_INT128__)
+        if (lhs.is_inline() and rhs.is_inline()) [[likely]] {
+            auto const a = static_cast<__int128>(lhs._lo.inline_value());
+            auto const b = static_cast<__int128>(lhs._hi.inline_value());
+            auto const c = rhs._lo.inline_value();
+            auto const d = rhs._hi.inline_value();
+
+            auto const ac = a * c;
+            auto const ad = a * d;
+            auto const bc = b * c;
+            auto const bd = b * d;
+            return {long_int{std::min({ac, ad, bc, bd})}, long_int{std::max({ac, ad, bc, bd})}};
+        }
+#endif
+        return mul_slow(lhs, rhs);
+    }
+
+    /** The range of the quotient, rounding toward zero.
+     *
+     * The divisor zero is excluded; a division by zero is a domain error.
+     *
+     * @pre @a rhs is not `[0, 0]`.
+     */
+    [[nodiscard]] friend long_interval operator/(long_interval const& lhs, long_interval const& rhs);
+
+    /** The range of the remainder, which has the sign of the dividend.
+     *
+     * @pre @a rhs is not `[0, 0]`.
+     */
+    [[nodiscard]] friend long_interval operator%(long_interval const& lhs, long_interval const& rhs);
+
+    /** The range of `x << y`.
+     *
+     * @pre @a rhs is not negative and its upper bound fits in a `std::size_t`.
+     */
+    [[nodiscard]] friend long_interval operator<<(long_interval const& lhs, long_interval const& rhs);
+
+    /** The range of `x >> y`, rounding toward negative infinity.
+     *
+     * @pre @a rhs is not negative.
+     */
+    [[nodiscard]] friend long_interval operator>>(long_interval const& lhs, long_interval const& rhs);
+
+    /** A range that contains every `x & y`.
+     *
+     * The bitwise operators treat integers as two's complement with an
+     * infinite number of sign bits. Their range is derived from the signs and
+     * the bit widths of the bounds, which may be wider than the exact range.
+     */
+    [[nodiscard]] friend long_interval operator&(long_interval const& lhs, long_interval const& rhs);
+
+    /** A range that contains every `x | y`.
+     */
+    [[nodiscard]] friend long_interval operator|(long_interval const& lhs, long_interval const& rhs);
+
+    /** A range that contains every `x ^ y`.
+     */
+    [[nodiscard]] friend long_interval operator^(long_interval const& lhs, long_interval const& rhs);
+
+private:
+    long_int _lo = {};
+    long_int _hi = {};
+
+    [[nodiscard]] static long_interval mul_slow(long_interval const& lhs, long_interval const& rhs);
 };
 
+}
 
-}
\ No newline at end of file
+template<typename CharT>
+struct std::formatter<hk::builtin::long_interval, CharT> : std::formatter<std::basic_string<CharT>, CharT> {
+    template<typename FormatContext>
+    auto format(hk::builtin::long_interval const& v, FormatContext& ctx) const
+    {
+        return std::format_to(ctx.out(), "{}..={}", v.lo(), v.hi());
+    }
+};
@@ -0,0 +1,93 @@
+
+#include "builtin_long_interval.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using hk::builtin::long_int;
+using hk::builtin::long_interval;
+
+/** 1024 random intervals with bounds of at most @a num_bits bits.
+ *
+ * The divisors of `/` and `%` may contain zero but are never `[0, 0]`.
+ */
+[[nodiscard]] std::vector<long_interval> make_intervals(std::size_t num_bits)
+{
+    auto engine = std::mt19937_64{1};
+    auto const random_bound = [&] {
+        auto r = long_int{};
+        for (auto i = 0uz; i < num_bits; i += 16) {
+            r = (r << 16) + long_int{engine() % 0x10000};
+        }
+        return engine() % 2 == 0 ? r : -r;
+    };
+
+    auto r = std::vector<long_interval>{};
+    r.reserve(1024);
+    for (auto i = 0uz; i != 1024; ++i) {
+        auto lo = random_bound();
+        auto hi = random_bound();
+        if (hi < lo) {
+            std::swap(lo, hi);
+        }
+        if (lo == long_int{0} and hi == long_int{0}) {
+            hi = long_int{1};
+        }
+        r.emplace_back(std::move(lo), std::move(hi));
+    }
+    return r;
+}
+
+enum class operation { add, mul, div, bit_and, shift_right };
+
+/** Calculate the range of an operation on 1024 pairs of intervals.
+ *
+ * The argument is the number of bits of the bounds. Bounds of 16 and 48 bits
+ * use the inline fast path, although the products of 48-bit bounds need to
+ * be allocated.
+ */
+void bm_long_interval(benchmark::State& state, operation op)
+{
+    auto const num_bits = static_cast<std::size_t>(state.range(0));
+    auto const lhs = make_intervals(num_bits);
+    auto const rhs = op == operation::shift_right ? std::vector<long_interval>(1024, long_interval{long_int{0}, long_int{8}})
+                                                  : make_intervals(num_bits);
+
+    for (auto _ : state) {
+        for (auto i = 0uz; i != lhs.size(); ++i) {
+            auto const& a = lhs[i];
+            auto const& b = rhs[rhs.size() - i - 1];
+            switch (op) {
+            case operation::add:
+                benchmark::DoNotOptimize(a + b);
+                break;
+            case operation::mul:
+                benchmark::DoNotOptimize(a * b);
+                break;
+            case operation::div:
+                benchmark::DoNotOptimize(a / b);
+                break;
+            case operation::bit_and:
+                benchmark::DoNotOptimize(a & b);
+                break;
+            case operation::shift_right:
+                benchmark::DoNotOptimize(a >> b);
+                break;
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lhs.size()));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(bm_long_interval, add, operation::add)->Arg(16)->Arg(48)->Arg(128);
+BENCHMARK_CAPTURE(bm_long_interval, mul, operation::mul)->Arg(16)->Arg(48)->Arg(128);
+BENCHMARK_CAPTURE(bm_long_interval, div, operation::div)->Arg(16)->Arg(48)->Arg(128);
+BENCHMARK_CAPTURE(bm_long_interval, bit_and, operation::bit_and)->Arg(16)->Arg(48)->Arg(128);
+BENCHMARK_CAPTURE(bm_long_interval, shift_right, operation::shift_right)->Arg(16)->Arg(48)->Arg(128);
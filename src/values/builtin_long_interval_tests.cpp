@@ -0,0 +1,181 @@
+
+#include "builtin_long_interval.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using hk::builtin::long_int;
+using hk::builtin::long_interval;
+using hk::builtin::machine_integer;
+
+[[nodiscard]] long_interval interval(std::int64_t lo, std::int64_t hi)
+{
+    return {long_int{lo}, long_int{hi}};
+}
+
+/** Small intervals, including negative, mixed and single value intervals.
+ */
+[[nodiscard]] std::vector<long_interval> small_intervals()
+{
+    auto r = std::vector<long_interval>{};
+    for (auto lo = -9; lo <= 9; lo += 3) {
+        for (auto hi = lo; hi <= 9; hi += 2) {
+            r.push_back(interval(lo, hi));
+        }
+    }
+    return r;
+}
+
+/** Check that every result of an operation on the values of two intervals is in the calculated range.
+ *
+ * @param exact The bounds of the calculated range must be results of the operation.
+ */
+[[nodiscard]] bool check(
+    std::function<long_interval(long_interval const&, long_interval const&)> interval_op,
+    std::function<std::int64_t(std::int64_t, std::int64_t)> op,
+    bool exact,
+    bool skip_zero_rhs = false,
+    bool non_negative_rhs = false)
+{
+    for (auto const& a : small_intervals()) {
+        for (auto const& b : small_intervals()) {
+            if (non_negative_rhs and b.lo() < long_int{0}) {
+                continue;
+            }
+            if (skip_zero_rhs and b == interval(0, 0)) {
+                continue;
+            }
+
+            auto const r = interval_op(a, b);
+            auto min = std::numeric_limits<std::int64_t>::max();
+            auto max = std::numeric_limits<std::int64_t>::min();
+            for (auto x = a.lo().inline_value(); x <= a.hi().inline_value(); ++x) {
+                for (auto y = b.lo().inline_value(); y <= b.hi().inline_value(); ++y) {
+                    if (skip_zero_rhs and y == 0) {
+                        continue;
+                    }
+                    auto const z = op(x, y);
+                    if (not r.contains(long_int{z})) {
+                        return false;
+                    }
+                    min = std::min(min, z);
+                    max = std::max(max, z);
+                }
+            }
+            if (exact and r != interval(min, max)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_SUITE(builtin_long_interval_suite)
+{
+
+TEST_CASE(readme_example)
+{
+    REQUIRE(interval(10, 20) * interval(2, 4) == interval(20, 80));
+    REQUIRE(interval(2, 2) + interval(3, 3) == interval(5, 5));
+    REQUIRE(interval(2, 4) * interval(3, 10) == interval(6, 40));
+}
+
+TEST_CASE(arithmetic)
+{
+    REQUIRE(check(std::plus<long_interval>{}, std::plus<std::int64_t>{}, true));
+    REQUIRE(check(std::minus<long_interval>{}, std::minus<std::int64_t>{}, true));
+    REQUIRE(check(std::multiplies<long_interval>{}, std::multiplies<std::int64_t>{}, true));
+    REQUIRE(check(std::divides<long_interval>{}, std::divides<std::int64_t>{}, true, true));
+    REQUIRE(check(std::modulus<long_interval>{}, std::modulus<std::int64_t>{}, false, true));
+    REQUIRE(-interval(-3, 5) == interval(-5, 3));
+    REQUIRE(~interval(-3, 5) == interval(-6, 2));
+}
+
+TEST_CASE(modulus)
+{
+    REQUIRE(interval(0, 5) % interval(10, 20) == interval(0, 5));
+    REQUIRE(interval(-5, 5) % interval(-20, -10) == interval(-5, 5));
+    REQUIRE(interval(0, 100) % interval(1, 10) == interval(0, 9));
+    REQUIRE(interval(-100, 100) % interval(-10, 10) == interval(-9, 9));
+    REQUIRE(interval(-100, -50) % interval(1, 10) == interval(-9, 0));
+}
+
+TEST_CASE(shift)
+{
+    auto const shl = [](auto x, auto y) {
+        return x << y;
+    };
+    auto const shr = [](auto x, auto y) {
+        return x >> y;
+    };
+    REQUIRE(check(shl, shl, true, false, true));
+    REQUIRE(check(shr, shr, true, false, true));
+
+    REQUIRE(interval(1, 1) << interval(100, 100) == long_interval(long_int{1} << 100));
+    REQUIRE(long_interval(-(long_int{1} << 100), long_int{1} << 100) >> interval(0, 1000) == long_interval(-(long_int{1} << 100), long_int{1} << 100));
+    REQUIRE(interval(-5, 5) >> long_interval(long_int{1000}, long_int{1} << 100) == interval(-1, 0));
+}
+
+TEST_CASE(bitwise)
+{
+    REQUIRE(check(std::bit_and<long_interval>{}, std::bit_and<std::int64_t>{}, false));
+    REQUIRE(check(std::bit_or<long_interval>{}, std::bit_or<std::int64_t>{}, false));
+    REQUIRE(check(std::bit_xor<long_interval>{}, std::bit_xor<std::int64_t>{}, false));
+
+    REQUIRE((interval(0, 255) & interval(0, 15)) == interval(0, 15));
+    REQUIRE((interval(0, 255) & interval(-5, -1)) == interval(0, 255));
+    REQUIRE((interval(1, 4) | interval(2, 3)) == interval(2, 7));
+    REQUIRE((interval(-4, -1) | interval(0, 100)) == interval(-4, -1));
+    REQUIRE((interval(-4, -1) ^ interval(0, 7)) == interval(-8, -1));
+}
+
+TEST_CASE(large_bounds)
+{
+    auto const max = long_int{std::numeric_limits<std::int64_t>::max()};
+    auto const min = long_int{std::numeric_limits<std::int64_t>::min()};
+    auto const full = long_interval{min, max};
+
+    REQUIRE(full + full == long_interval(min + min, max + max));
+    REQUIRE(full - full == long_interval(min - max, max - min));
+    REQUIRE(full * full == long_interval(min * max, min * min));
+
+    auto const big = long_interval{-(long_int{1} << 100), long_int{1} << 100};
+    REQUIRE(big * big == long_interval(-(long_int{1} << 200), long_int{1} << 200));
+    REQUIRE(big + interval(1, 1) == long_interval(-(long_int{1} << 100) + long_int{1}, (long_int{1} << 100) + long_int{1}));
+    REQUIRE(big / interval(-4, 4) == big);
+    REQUIRE((full * full).lo().to_string() == "-85070591730234615856620279821087277056");
+}
+
+TEST_CASE(relations)
+{
+    REQUIRE(interval(0, 10).contains(interval(2, 2)));
+    REQUIRE(not interval(0, 10).contains(interval(2, 12)));
+    REQUIRE(interval(0, 10).overlaps(interval(2, 12)));
+    REQUIRE(not interval(0, 0).overlaps(interval(2, 2)));
+    REQUIRE(hull(interval(0, 1), interval(5, 6)) == interval(0, 6));
+    REQUIRE(std::format("{}", interval(-3, 5)) == "-3..=5");
+}
+
+TEST_CASE(to_machine_integer)
+{
+    REQUIRE(interval(0, 0).num_bits() == machine_integer(0, false));
+    REQUIRE(interval(0, 255).num_bits() == machine_integer(8, false));
+    REQUIRE(interval(-128, 127).num_bits() == machine_integer(8, true));
+    REQUIRE(interval(-129, 0).num_bits() == machine_integer(9, true));
+
+    REQUIRE(interval(0, 1).to_machine_integer() == machine_integer(8, false));
+    REQUIRE(interval(0, 256).to_machine_integer() == machine_integer(16, false));
+    REQUIRE(interval(-1, 127).to_machine_integer() == machine_integer(8, true));
+    REQUIRE(interval(-1, 128).to_machine_integer() == machine_integer(16, true));
+    REQUIRE(interval(std::numeric_limits<std::int64_t>::min(), 0).to_machine_integer() == machine_integer(64, true));
+    REQUIRE(long_interval(long_int{0}, long_int{std::numeric_limits<std::uint64_t>::max()}).to_machine_integer() == machine_integer(64, false));
+    REQUIRE(long_interval(long_int{-1}, long_int{std::numeric_limits<std::uint64_t>::max()}).to_machine_integer() == machine_integer(128, true));
+}
+
+}; // TEST_SUITE(builtin_long_interval_suite)
@@ -0,0 +1,41 @@
+
+#include "heap_snapshot.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace hk::builtin {
+
+std::pair<std::size_t, bool> heap_snapshot::add_object(void const *ptr, std::size_t size, std::size_t alignment)
+{
+    assert(std::has_single_bit(alignment));
+
+    auto const [it, added] = _offsets.try_emplace(ptr, 0);
+    if (not added) {
+        return {it->second, false};
+    }
+
+    auto const offset = (_data.size() + alignment - 1) & ~(alignment - 1);
+    _data.resize(offset + size);
+    std::memcpy(_data.data() + offset, ptr, size);
+    _alignment = std::max(_alignment, alignment);
+    it->second = offset;
+    return {offset, true};
+}
+
+void heap_snapshot::add_patch(std::size_t offset, std::size_t target, std::uint64_t mask, int shift)
+{
+    assert(offset % 8 == 0);
+    assert(target <= _data.size());
+
+    auto const& entry = _patches.emplace_back(offset, target, mask, shift);
+    write_reloc_addend(_data, entry);
+}
+
+std::vector<reloc_patch_entry> heap_snapshot::patches() const
+{
+    auto r = _patches;
+    std::ranges::sort(r, {}, &reloc_patch_entry::offset);
+    return r;
+}
+
+}
@@ -0,0 +1,131 @@
+
+#pragma once
+
+#include "reloc_patch_table.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hk::builtin {
+
+class heap_snapshot;
+
+/** A type that adds the objects it points to to a heap snapshot.
+ *
+ * The implementation of `__reloc_get__()` for compile-time values:
+ * `value.reloc_get(snapshot, offset)` is called after @a value is copied
+ * to @a offset in the snapshot; it adds the objects it points to and the
+ * patches for its pointers.
+ */
+template<typename T>
+concept relocatable = requires(T const& value, heap_snapshot& snapshot, std::size_t offset) {
+    { value.reloc_get(snapshot, offset) };
+};
+
+/** A snapshot of the objects reachable from static variables.
+ *
+ * The objects are copied into a contiguous `.data` segment, which is
+ * relocated at start-up by the patch table. An object is added only once,
+ * even if it is reachable through several pointers.
+ *
+ * The objects are laid out depth-first: the objects that are pointed to
+ * follow the object that points to them, in the order of the pointers. So
+ * that walking a data structure at run-time reads consecutive memory.
+ */
+class heap_snapshot {
+public:
+    /** Add a static variable or an object reachable from it.
+     *
+     * @return The offset of the object in the `.data` segment.
+     */
+    template<typename T>
+    std::size_t add(T const& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T> or relocatable<T>, "A non-trivially copyable type must implement reloc_get().");
+
+        auto const [offset, added] = add_object(std::addressof(value), sizeof(T), alignof(T));
+        if constexpr (relocatable<T>) {
+            if (added) {
+                value.reloc_get(*this, offset);
+            }
+        }
+        return offset;
+    }
+
+    /** Add the bytes of an object.
+     *
+     * @param ptr The object.
+     * @param size The size of the object in bytes.
+     * @param alignment The alignment of the object.
+     * @return The offset of the object in the `.data` segment, and true
+     *         when the object was not added before.
+     */
+    std::pair<std::size_t, bool> add_object(void const *ptr, std::size_t size, std::size_t alignment);
+
+    /** Patch a pointer in the `.data` segment.
+     *
+     * @param offset The offset of the pointer in the `.data` segment.
+     * @param target The offset of the object that is pointed to.
+     * @param mask The bits of the pointer to patch.
+     * @param shift The number of bits to shift the target left, negative to shift right.
+     */
+    void add_patch(std::size_t offset, std::size_t target, std::uint64_t mask = ~std::uint64_t{0}, int shift = 0);
+
+    /** Overwrite a value in the `.data` segment.
+     *
+     * Used to clear fields that have no meaning at run-time, for example
+     * the allocator of a compile-time object.
+     */
+    template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+    void write(std::size_t offset, T const& value) noexcept
+    {
+        assert(offset + sizeof(T) <= _data.size());
+        std::memcpy(_data.data() + offset, std::addressof(value), sizeof(T));
+    }
+
+    /** The contents of the `.data` segment.
+     *
+     * The patched pointers contain the offset of their target, see
+     * `write_reloc_addend()`.
+     */
+    [[nodiscard]] std::span<std::byte const> data() const noexcept
+    {
+        return _data;
+    }
+
+    /** The alignment of the `.data` segment.
+     */
+    [[nodiscard]] std::size_t alignment() const noexcept
+    {
+        return _alignment;
+    }
+
+    /** The patches, sorted by offset.
+     */
+    [[nodiscard]] std::vector<reloc_patch_entry> patches() const;
+
+    /** The compressed `__reloc_patch_table__`.
+     */
+    [[nodiscard]] std::vector<std::uint64_t> patch_table() const
+    {
+        return make_reloc_patch_table(_patches);
+    }
+
+private:
+    std::vector<std::byte> _data = {};
+    std::size_t _alignment = 8;
+    std::vector<reloc_patch_entry> _patches = {};
+
+    /** The offset of each object that was added, by its address.
+     */
+    std::unordered_map<void const *, std::size_t> _offsets = {};
+};
+
+}
@@ -0,0 +1,119 @@
+
+#include "heap_snapshot.hpp"
+#include "arena_allocator.hpp"
+#include "long_int.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+using hk::builtin::heap_snapshot;
+using hk::builtin::long_int;
+
+struct node {
+    node const *left = nullptr;
+    node const *right = nullptr;
+    std::int64_t value = 0;
+
+    void reloc_get(heap_snapshot& snapshot, std::size_t offset) const
+    {
+        if (left != nullptr) {
+            snapshot.add_patch(offset + offsetof(node, left), snapshot.add(*left));
+        }
+        if (right != nullptr) {
+            snapshot.add_patch(offset + offsetof(node, right), snapshot.add(*right));
+        }
+    }
+};
+
+/** Copy the `.data` segment to an aligned buffer and relocate it.
+ */
+[[nodiscard]] std::vector<std::uint64_t> relocate(heap_snapshot const& snapshot)
+{
+    auto r = std::vector<std::uint64_t>((snapshot.data().size() + 7) / 8);
+    std::memcpy(r.data(), snapshot.data().data(), snapshot.data().size());
+    hk::builtin::apply_reloc_patch_table(std::as_writable_bytes(std::span{r}), snapshot.patch_table());
+    return r;
+}
+
+template<typename T>
+[[nodiscard]] T const& object_at(std::vector<std::uint64_t> const& data, std::size_t offset)
+{
+    return *reinterpret_cast<T const *>(reinterpret_cast<std::byte const *>(data.data()) + offset);
+}
+
+} // namespace
+
+TEST_SUITE(heap_snapshot_suite)
+{
+
+TEST_CASE(depth_first)
+{
+    auto const d = node{nullptr, nullptr, 4};
+    auto const c = node{nullptr, nullptr, 3};
+    auto const b = node{&d, nullptr, 2};
+    auto const a = node{&b, &c, 1};
+
+    auto snapshot = heap_snapshot{};
+    REQUIRE(snapshot.add(a) == 0);
+
+    // The children follow their parent.
+    auto const data = relocate(snapshot);
+    auto const& a2 = object_at<node>(data, 0);
+    REQUIRE(a2.value == 1);
+    REQUIRE(a2.left == &object_at<node>(data, sizeof(node)));
+    REQUIRE(a2.left->value == 2);
+    REQUIRE(a2.left->left == &object_at<node>(data, 2 * sizeof(node)));
+    REQUIRE(a2.left->left->value == 4);
+    REQUIRE(a2.right == &object_at<node>(data, 3 * sizeof(node)));
+    REQUIRE(a2.right->value == 3);
+    REQUIRE(a2.right->left == nullptr);
+}
+
+TEST_CASE(shared_objects)
+{
+    auto const shared = node{nullptr, nullptr, 42};
+    auto const a = node{&shared, &shared, 1};
+    auto const b = node{&shared, nullptr, 2};
+
+    auto snapshot = heap_snapshot{};
+    auto const a_offset = snapshot.add(a);
+    auto const b_offset = snapshot.add(b);
+    REQUIRE(snapshot.add(a) == a_offset);
+    REQUIRE(snapshot.data().size() == 3 * sizeof(node));
+    REQUIRE(snapshot.patches().size() == 3);
+
+    auto const data = relocate(snapshot);
+    auto const& a2 = object_at<node>(data, a_offset);
+    auto const& b2 = object_at<node>(data, b_offset);
+    REQUIRE(a2.left == a2.right);
+    REQUIRE(a2.left == b2.left);
+    REQUIRE(b2.left->value == 42);
+}
+
+TEST_CASE(long_int_value)
+{
+    auto arena = hk::builtin::arena_allocator{};
+    auto const small = long_int{-5};
+    auto const large = (long_int{1, arena} << 200) - long_int{1};
+
+    auto snapshot = heap_snapshot{};
+    auto const small_offset = snapshot.add(small);
+    auto const large_offset = snapshot.add(large);
+    REQUIRE(snapshot.patches().size() == 1);
+
+    // The relocated integers are not destroyed, as their limbs are in the `.data` segment.
+    auto const data = relocate(snapshot);
+    auto const& small2 = object_at<long_int>(data, small_offset);
+    auto const& large2 = object_at<long_int>(data, large_offset);
+    REQUIRE(small2 == small);
+    REQUIRE(large2 == large);
+    REQUIRE(large2.to_string(16) == std::string(50, 'f'));
+    REQUIRE(&large2.get_allocator() == &hk::builtin::_default_allocator);
+}
+
+}; // TEST_SUITE(heap_snapshot_suite)
@@ -0,0 +1,90 @@
+
+#include "integer_metatype.hpp"
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace hk::builtin {
+
+struct integer_metatype_registry {
+    struct shape_type {
+        machine_integer storage;
+        long_interval range;
+
+        [[nodiscard]] friend bool operator==(shape_type const&, shape_type const&) noexcept = default;
+    };
+
+    struct shape_hash {
+        [[nodiscard]] std::size_t operator()(shape_type const& x) const noexcept
+        {
+            auto h = static_cast<std::uint64_t>(x.storage.num_bits * 2 + x.storage.is_signed);
+            h = (h ^ x.range.lo().hash()) * 0x9e37'79b9'7f4a'7c15;
+            h = (h ^ x.range.hi().hash()) * 0x9e37'79b9'7f4a'7c15;
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+
+    std::shared_mutex mutex;
+    std::unordered_map<shape_type, std::unique_ptr<integer_metatype const>, shape_hash> types;
+
+    [[nodiscard]] static integer_metatype_registry& global()
+    {
+        static auto r = integer_metatype_registry{};
+        return r;
+    }
+
+    [[nodiscard]] integer_metatype const& get(shape_type shape)
+    {
+        {
+            auto const lock = std::shared_lock(mutex);
+            if (auto const it = types.find(shape); it != types.end()) {
+                return *it->second;
+            }
+        }
+
+        // Another thread may have added the same shape while waiting for the lock.
+        auto const lock = std::scoped_lock(mutex);
+        auto [it, inserted] = types.try_emplace(shape, nullptr);
+        if (inserted) {
+            it->second.reset(new integer_metatype(shape.storage, shape.range));
+        }
+        return *it->second;
+    }
+};
+
+[[nodiscard]] integer_metatype const& integer_metatype::get(std::size_t num_bits, bool is_signed)
+{
+    assert(num_bits >= 8 and std::has_single_bit(num_bits));
+
+    auto const one = long_int{1};
+    auto range = is_signed ? long_interval{-(one << (num_bits - 1)), (one << (num_bits - 1)) - one} :
+                             long_interval{long_int{0}, (one << num_bits) - one};
+    return get(machine_integer{num_bits, is_signed}, range);
+}
+
+[[nodiscard]] integer_metatype const& integer_metatype::get(long_interval const& range)
+{
+    return get(range.to_machine_integer(), range);
+}
+
+[[nodiscard]] integer_metatype const& integer_metatype::get(machine_integer storage, long_interval const& range)
+{
+    assert(storage.num_bits >= 8 and std::has_single_bit(storage.num_bits));
+    assert(storage.is_signed or not range.lo().is_negative());
+    assert(range.num_bits().num_bits <= storage.num_bits);
+
+    return integer_metatype_registry::global().get({storage, range});
+}
+
+[[nodiscard]] std::size_t integer_metatype::registry_size()
+{
+    auto& registry = integer_metatype_registry::global();
+    auto const lock = std::shared_lock(registry.mutex);
+    return registry.types.size();
+}
+
+}
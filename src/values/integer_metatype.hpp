@@ -1,29 +1,73 @@
 
 #pragma once
 
+#include "builtin_long_interval.hpp"
 #include "metatype.hpp"
 #include <cstddef>
 #include <cstdint>
 
 namespace hk::builtin {
 
-class integer_metatype : public metatype {
+/** The metatype of a builtin integer.
+ *
+ * An integer type has a shape: the number of bits and the signedness of
+ * its storage, and the range of values it may hold, as in `int[lo..=hi]`.
+ * Each distinct shape is described by one canonical integer_metatype from
+ * a global registry; two integer types are the same type when they are the
+ * same object. The registry is thread-safe.
+ */
+class integer_metatype final : public metatype {
 public:
-    virtual ~integer_metatype() = default;
+    /** The integer type with the full range of a machine integer.
+     *
+     * @param num_bits The number of bits: 8, 16, 32, 64, 128, ...
+     * @param is_signed The integer is signed.
+     */
+    [[nodiscard]] static integer_metatype const& get(std::size_t num_bits, bool is_signed);
 
-    [[nodiscard]] std::size_t size() override
+    /** The integer type of `int[lo..=hi]`.
+     *
+     * The storage is the smallest machine integer that holds the range.
+     */
+    [[nodiscard]] static integer_metatype const& get(long_interval const& range);
+
+    /** The integer type with a range stored in a machine integer.
+     *
+     * @pre The machine integer holds every value of @a range.
+     */
+    [[nodiscard]] static integer_metatype const& get(machine_integer storage, long_interval const& range);
+
+    /** The number of distinct integer types in the registry.
+     */
+    [[nodiscard]] static std::size_t registry_size();
+
+    [[nodiscard]] constexpr std::size_t num_bits() const noexcept
+    {
+        return _storage.num_bits;
+    }
+
+    [[nodiscard]] constexpr bool is_signed() const noexcept
     {
-        return (_num_bits + 7) / 8;
+        return _storage.is_signed;
     }
 
-    [[nodiscard]] std::size_t alignment() override
+    /** The values that an instance may hold.
+     */
+    [[nodiscard]] long_interval const& range() const noexcept
     {
-        return size();
+        return _range;
     }
 
 private:
-    std::uint8_t _num_bits = 0;
-    bool _signed = false;
+    machine_integer _storage;
+    long_interval _range;
+
+    integer_metatype(machine_integer storage, long_interval range) noexcept :
+        metatype(storage.num_bits / 8, storage.num_bits / 8), _storage(storage), _range(std::move(range))
+    {
+    }
+
+    friend struct integer_metatype_registry;
 };
 
-}
\ No newline at end of file
+}
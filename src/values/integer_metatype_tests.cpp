@@ -0,0 +1,86 @@
+
+#include "integer_metatype.hpp"
+#include <hikotest/hikotest.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using hk::builtin::integer_metatype;
+using hk::builtin::long_int;
+using hk::builtin::long_interval;
+
+} // namespace
+
+TEST_SUITE(integer_metatype_suite)
+{
+
+TEST_CASE(machine_integers)
+{
+    auto const& i32 = integer_metatype::get(32, true);
+    REQUIRE(i32.num_bits() == 32);
+    REQUIRE(i32.is_signed());
+    REQUIRE(i32.size() == 4);
+    REQUIRE(i32.alignment() == 4);
+    REQUIRE(i32.range().lo() == long_int{-2147483648LL});
+    REQUIRE(i32.range().hi() == long_int{2147483647LL});
+
+    auto const& u128 = integer_metatype::get(128, false);
+    REQUIRE(u128.size() == 16);
+    REQUIRE(u128.range().lo() == long_int{0});
+    REQUIRE(u128.range().hi() == long_int::from_string("340282366920938463463374607431768211455"));
+
+    // The same shape is the same object.
+    REQUIRE(&integer_metatype::get(32, true) == &i32);
+    REQUIRE(&integer_metatype::get(32, false) != &i32);
+}
+
+TEST_CASE(ranged_integers)
+{
+    // int[0..=255] is stored in an unsigned byte, but it is not the same type as u8.
+    auto const& byte = integer_metatype::get(long_interval{long_int{0}, long_int{255}});
+    REQUIRE(byte.num_bits() == 8);
+    REQUIRE(not byte.is_signed());
+    REQUIRE(byte.size() == 1);
+    REQUIRE(&byte == &integer_metatype::get(8, false));
+
+    auto const& small = integer_metatype::get(long_interval{long_int{0}, long_int{100}});
+    REQUIRE(small.num_bits() == 8);
+    REQUIRE(&small != &byte);
+    REQUIRE(&small == &integer_metatype::get(long_interval{long_int{0}, long_int{100}}));
+
+    auto const& negative = integer_metatype::get(long_interval{long_int{-1}, long_int{1000}});
+    REQUIRE(negative.num_bits() == 16);
+    REQUIRE(negative.is_signed());
+    REQUIRE(negative.alignment() == 2);
+
+    // The same range in wider storage is a different type.
+    auto const& wide = integer_metatype::get({64, true}, long_interval{long_int{-1}, long_int{1000}});
+    REQUIRE(wide.size() == 8);
+    REQUIRE(&wide != &negative);
+}
+
+TEST_CASE(concurrent_get)
+{
+    constexpr auto num_threads = 4;
+
+    auto results = std::vector<std::vector<integer_metatype const *>>(num_threads);
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t != num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto i = 0; i != 1000; ++i) {
+                results[t].push_back(&integer_metatype::get(long_interval{long_int{-i}, long_int{1'000'000 + i}}));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto t = 1; t != num_threads; ++t) {
+        REQUIRE(results[t] == results[0]);
+    }
+    REQUIRE(integer_metatype::registry_size() >= 1000);
+}
+
+}; // TEST_SUITE(integer_metatype_suite)
@@ -0,0 +1,855 @@
+
+#include "long_int.hpp"
+#include "heap_snapshot.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <vector>
+
+#if defined(__x86_64__) and not defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+
+namespace hk::builtin {
+
+namespace {
+
+using limb_type = long_int::limb_type;
+
+/** Add two limbs with carry.
+ *
+ * @return The carry out, 0 or 1.
+ */
+[[nodiscard]] unsigned char add_carry(unsigned char carry, limb_type a, limb_type b, limb_type& r) noexcept
+{
+#if defined(__x86_64__) or defined(_M_X64)
+    auto tmp = 0ull;
+    carry = _addcarry_u64(carry, a, b, &tmp);
+    r = tmp;
+    return carry;
+#else
+    auto const s = a + b;
+    auto const c = s < a;
+    r = s + carry;
+    return static_cast<unsigned char>(c | (r < s));
+#endif
+}
+
+/** Subtract two limbs with borrow.
+ *
+ * @return The borrow out, 0 or 1.
+ */
+[[nodiscard]] unsigned char sub_borrow(unsigned char borrow, limb_type a, limb_type b, limb_type& r) noexcept
+{
+#if defined(__x86_64__) or defined(_M_X64)
+    auto tmp = 0ull;
+    borrow = _subborrow_u64(borrow, a, b, &tmp);
+    r = tmp;
+    return borrow;
+#else
+    auto const d = a - b;
+    auto const c = a < b;
+    r = d - borrow;
+    return static_cast<unsigned char>(c | (d < borrow));
+#endif
+}
+
+/** Multiply two limbs into a double limb.
+ *
+ * @return high, low
+ */
+[[nodiscard]] std::pair<limb_type, limb_type> mul_2x1(limb_type a, limb_type b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    auto const r = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<limb_type>(r >> 64), static_cast<limb_type>(r)};
+#elif defined(_M_X64)
+    auto hi = limb_type{};
+    auto const lo = _umul128(a, b, &hi);
+    return {hi, lo};
+#else
+    auto const a_lo = a & 0xffff'ffff;
+    auto const a_hi = a >> 32;
+    auto const b_lo = b & 0xffff'ffff;
+    auto const b_hi = b >> 32;
+
+    auto const lo_lo = a_lo * b_lo;
+    auto const hi_lo = a_hi * b_lo;
+    auto const lo_hi = a_lo * b_hi;
+    auto const hi_hi = a_hi * b_hi;
+
+    auto const cross = (lo_lo >> 32) + (hi_lo & 0xffff'ffff) + lo_hi;
+    return {(hi_lo >> 32) + (cross >> 32) + hi_hi, (cross << 32) | (lo_lo & 0xffff'ffff)};
+#endif
+}
+
+/** Divide a double limb by a limb.
+ *
+ * @pre @a hi is less than @a d.
+ * @return quotient, remainder
+ */
+[[nodiscard]] std::pair<limb_type, limb_type> div_2x1(limb_type hi, limb_type lo, limb_type d) noexcept
+{
+    assert(hi < d);
+#if defined(__SIZEOF_INT128__)
+    auto const n = (static_cast<unsigned __int128>(hi) << 64) | lo;
+    return {static_cast<limb_type>(n / d), static_cast<limb_type>(n % d)};
+#elif defined(_M_X64)
+    auto r = limb_type{};
+    auto const q = _udiv128(hi, lo, d, &r);
+    return {q, r};
+#else
+    auto q = limb_type{0};
+    for (auto i = 0; i != 64; ++i) {
+        auto const carry = hi >> 63;
+        hi = (hi << 1) | (lo >> 63);
+        lo <<= 1;
+        q <<= 1;
+        if (carry or hi >= d) {
+            hi -= d;
+            q |= 1;
+        }
+    }
+    return {q, hi};
+#endif
+}
+
+/** The number of limbs without the leading zero limbs.
+ */
+[[nodiscard]] std::size_t normalized_size(limb_type const* a, std::size_t n) noexcept
+{
+    while (n != 0 and a[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+/** Compare two magnitudes of the same size.
+ */
+[[nodiscard]] std::strong_ordering compare(limb_type const* a, limb_type const* b, std::size_t n) noexcept
+{
+    for (auto i = n; i != 0; --i) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] <=> b[i - 1];
+        }
+    }
+    return std::strong_ordering::equal;
+}
+
+/** r = a + b
+ *
+ * @a r may be the same as @a a.
+ *
+ * @pre @a an is at least @a bn.
+ * @return The carry out.
+ */
+limb_type add(limb_type* r, limb_type const* a, std::size_t an, limb_type const* b, std::size_t bn) noexcept
+{
+    assert(an >= bn);
+    auto carry = static_cast<unsigned char>(0);
+    auto i = 0uz;
+    for (; i != bn; ++i) {
+        carry = add_carry(carry, a[i], b[i], r[i]);
+    }
+    for (; i != an; ++i) {
+        carry = add_carry(carry, a[i], 0, r[i]);
+    }
+    return carry;
+}
+
+/** r = a - b
+ *
+ * @a r may be the same as @a a.
+ *
+ * @pre @a an is at least @a bn.
+ * @return The borrow out.
+ */
+limb_type sub(limb_type* r, limb_type const* a, std::size_t an, limb_type const* b, std::size_t bn) noexcept
+{
+    assert(an >= bn);
+    auto borrow = static_cast<unsigned char>(0);
+    auto i = 0uz;
+    for (; i != bn; ++i) {
+        borrow = sub_borrow(borrow, a[i], b[i], r[i]);
+    }
+    for (; i != an; ++i) {
+        borrow = sub_borrow(borrow, a[i], 0, r[i]);
+    }
+    return borrow;
+}
+
+/** r = a * m
+ *
+ * @return The high limb of the product.
+ */
+limb_type mul_1(limb_type* r, limb_type const* a, std::size_t n, limb_type m) noexcept
+{
+    auto carry = limb_type{0};
+    for (auto i = 0uz; i != n; ++i) {
+        auto [hi, lo] = mul_2x1(a[i], m);
+        lo += carry;
+        carry = hi + (lo < carry);
+        r[i] = lo;
+    }
+    return carry;
+}
+
+/** r += a * m
+ *
+ * @return The limb carried out of r[n - 1].
+ */
+limb_type addmul_1(limb_type* r, limb_type const* a, std::size_t n, limb_type m) noexcept
+{
+    auto carry = limb_type{0};
+    for (auto i = 0uz; i != n; ++i) {
+        auto [hi, lo] = mul_2x1(a[i], m);
+        lo += carry;
+        hi += lo < carry;
+        r[i] += lo;
+        carry = hi + (r[i] < lo);
+    }
+    return carry;
+}
+
+/** r -= a * m
+ *
+ * @return The limb borrowed from r[n].
+ */
+limb_type submul_1(limb_type* r, limb_type const* a, std::size_t n, limb_type m) noexcept
+{
+    auto carry = limb_type{0};
+    for (auto i = 0uz; i != n; ++i) {
+        auto [hi, lo] = mul_2x1(a[i], m);
+        lo += carry;
+        hi += lo < carry;
+        auto const borrow = r[i] < lo;
+        r[i] -= lo;
+        carry = hi + borrow;
+    }
+    return carry;
+}
+
+/** r = a << s
+ *
+ * @a r may be the same as @a a.
+ *
+ * @pre @a s is less than 64.
+ * @return The bits shifted out of the top limb.
+ */
+limb_type shift_left(limb_type* r, limb_type const* a, std::size_t n, unsigned int s) noexcept
+{
+    if (s == 0) {
+        std::copy_backward(a, a + n, r + n);
+        return 0;
+    }
+
+    auto carry = limb_type{0};
+    for (auto i = 0uz; i != n; ++i) {
+        auto const x = a[i];
+        r[i] = (x << s) | carry;
+        carry = x >> (64 - s);
+    }
+    return carry;
+}
+
+/** r = a >> s
+ *
+ * @a r may be the same as @a a.
+ *
+ * @pre @a s is less than 64.
+ */
+void shift_right(limb_type* r, limb_type const* a, std::size_t n, unsigned int s) noexcept
+{
+    if (s == 0) {
+        std::copy_n(a, n, r);
+        return;
+    }
+
+    for (auto i = 0uz; i != n; ++i) {
+        auto const next = i + 1 != n ? a[i + 1] << (64 - s) : 0;
+        r[i] = (a[i] >> s) | next;
+    }
+}
+
+/** r = a * b with schoolbook multiplication.
+ *
+ * @pre @a an and @a bn are not zero, @a r does not overlap @a a or @a b.
+ */
+void mul_basecase(limb_type* r, limb_type const* a, std::size_t an, limb_type const* b, std::size_t bn) noexcept
+{
+    r[an] = mul_1(r, a, an, b[0]);
+    for (auto j = 1uz; j != bn; ++j) {
+        r[an + j] = addmul_1(r + j, a, an, b[j]);
+    }
+}
+
+/** r = |a - b|, where @a b is extended with zeros to the size of @a a.
+ *
+ * @pre @a an is at least @a bn.
+ * @return True if @a a is less than @a b.
+ */
+bool abs_diff(limb_type* r, limb_type const* a, std::size_t an, limb_type const* b, std::size_t bn) noexcept
+{
+    if (normalized_size(a + bn, an - bn) == 0 and compare(a, b, bn) < 0) {
+        sub(r, b, bn, a, bn);
+        std::fill(r + bn, r + an, 0);
+        return true;
+    }
+    sub(r, a, an, b, bn);
+    return false;
+}
+
+/** The number of scratch limbs needed by `karatsuba()`.
+ */
+[[nodiscard]] std::size_t karatsuba_scratch_size(std::size_t n) noexcept
+{
+    auto r = 0uz;
+    while (n >= long_int::karatsuba_threshold) {
+        auto const m = n - n / 2;
+        r += 6 * m + 2;
+        n = m;
+    }
+    return r;
+}
+
+/** r = a * b with Karatsuba multiplication.
+ *
+ * Each operand is split in a low and a high half, the three products
+ * a0 * b0, a1 * b1 and |a1 - a0| * |b1 - b0| are calculated recursively.
+ *
+ * @param r The product of `2 * n` limbs.
+ * @param a The first operand of @a n limbs.
+ * @param b The second operand of @a n limbs.
+ * @param n The number of limbs of each operand.
+ * @param scratch Temporary limbs, see `karatsuba_scratch_size()`.
+ */
+void karatsuba(limb_type* r, limb_type const* a, limb_type const* b, std::size_t n, limb_type* scratch) noexcept
+{
+    if (n < long_int::karatsuba_threshold) {
+        return mul_basecase(r, a, n, b, n);
+    }
+
+    auto const h = n / 2;
+    auto const m = n - h;
+
+    auto* da = scratch;
+    auto* db = da + m;
+    auto* z1 = db + m;
+    auto* t = z1 + 2 * m;
+    auto* next = t + 2 * m + 2;
+
+    karatsuba(r, a, b, h, next);
+    karatsuba(r + 2 * h, a + h, b + h, m, next);
+
+    auto const a_negative = abs_diff(da, a + h, m, a, h);
+    auto const b_negative = abs_diff(db, b + h, m, b, h);
+    karatsuba(z1, da, db, m, next);
+
+    // a0 * b1 + a1 * b0 = a0 * b0 + a1 * b1 - (a1 - a0) * (b1 - b0)
+    std::copy_n(r + 2 * h, 2 * m, t);
+    t[2 * m] = add(t, t, 2 * m, r, 2 * h);
+    if (a_negative == b_negative) {
+        sub(t, t, 2 * m + 1, z1, 2 * m);
+    } else {
+        add(t, t, 2 * m + 1, z1, 2 * m);
+    }
+
+    [[maybe_unused]] auto const carry = add(r + h, r + h, 2 * n - h, t, 2 * m + 1);
+    assert(carry == 0);
+}
+
+/** r = a * b
+ *
+ * @pre @a an and @a bn are not zero, @a r does not overlap @a a or @a b.
+ */
+void mul(limb_type* r, limb_type const* a, std::size_t an, limb_type const* b, std::size_t bn)
+{
+    if (an < bn) {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+
+    if (bn < long_int::karatsuba_threshold) {
+        return mul_basecase(r, a, an, b, bn);
+    }
+
+    auto scratch = std::vector<limb_type>(karatsuba_scratch_size(bn));
+    if (an == bn) {
+        return karatsuba(r, a, b, bn, scratch.data());
+    }
+
+    // Multiply each slice of bn limbs of a with b.
+    std::fill(r, r + an + bn, 0);
+    auto tmp = std::vector<limb_type>(2 * bn);
+    for (auto i = 0uz; i < an; i += bn) {
+        auto const len = std::min(bn, an - i);
+        if (len == bn) {
+            karatsuba(tmp.data(), a + i, b, bn, scratch.data());
+        } else {
+            mul(tmp.data(), b, bn, a + i, len);
+        }
+        add(r + i, r + i, an + bn - i, tmp.data(), len + bn);
+    }
+}
+
+/** q = a / d
+ *
+ * @a q may be the same as @a a.
+ *
+ * @return The remainder.
+ */
+limb_type divmod_1(limb_type* q, limb_type const* a, std::size_t n, limb_type d) noexcept
+{
+    auto rem = limb_type{0};
+    for (auto i = n; i != 0; --i) {
+        std::tie(q[i - 1], rem) = div_2x1(rem, a[i - 1], d);
+    }
+    return rem;
+}
+
+/** q = u / v, r = u % v with Knuth's algorithm D.
+ *
+ * @param q The quotient of `un - vn + 1` limbs.
+ * @param r The remainder of @a vn limbs.
+ * @pre @a vn is at least 2, @a un is at least @a vn, the top limb of @a v is not zero.
+ */
+void divmod_n(limb_type* q, limb_type* r, limb_type const* u, std::size_t un, limb_type const* v, std::size_t vn)
+{
+    assert(vn >= 2 and un >= vn and v[vn - 1] != 0);
+
+    // Normalize, so that the top bit of the divisor is set.
+    auto const s = static_cast<unsigned int>(std::countl_zero(v[vn - 1]));
+    auto vs = std::vector<limb_type>(vn);
+    auto us = std::vector<limb_type>(un + 1);
+    shift_left(vs.data(), v, vn, s);
+    us[un] = shift_left(us.data(), u, un, s);
+
+    auto const v1 = vs[vn - 1];
+    auto const v2 = vs[vn - 2];
+    for (auto j = un - vn + 1; j != 0; --j) {
+        auto* uj = us.data() + j - 1;
+
+        // Estimate the quotient limb from the top two limbs, it is at most two too large.
+        auto qhat = limb_type{};
+        auto rhat = limb_type{};
+        auto rhat_overflow = false;
+        if (uj[vn] >= v1) {
+            qhat = ~limb_type{0};
+            rhat = uj[vn - 1] + v1;
+            rhat_overflow = rhat < v1;
+        } else {
+            std::tie(qhat, rhat) = div_2x1(uj[vn], uj[vn - 1], v1);
+        }
+        while (not rhat_overflow) {
+            auto const [hi, lo] = mul_2x1(qhat, v2);
+            if (hi < rhat or (hi == rhat and lo <= uj[vn - 2])) {
+                break;
+            }
+            --qhat;
+            rhat += v1;
+            rhat_overflow = rhat < v1;
+        }
+
+        auto const borrow = submul_1(uj, vs.data(), vn, qhat);
+        if (sub_borrow(0, uj[vn], borrow, uj[vn])) {
+            // The estimate was one too large, add the divisor back.
+            --qhat;
+            uj[vn] += add(uj, uj, vn, vs.data(), vn);
+        }
+        q[j - 1] = qhat;
+    }
+
+    shift_right(r, us.data(), vn, s);
+}
+
+[[nodiscard]] constexpr int digit_value(char c) noexcept
+{
+    if (c >= '0' and c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' and c <= 'z') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' and c <= 'Z') {
+        return c - 'A' + 10;
+    } else {
+        return 36;
+    }
+}
+
+/** The largest power of a base that fits in a limb.
+ *
+ * @return The power, the number of digits.
+ */
+[[nodiscard]] constexpr std::pair<limb_type, std::size_t> limb_power(unsigned int base) noexcept
+{
+    auto power = limb_type{base};
+    auto num_digits = 1uz;
+    while (power <= std::numeric_limits<limb_type>::max() / base) {
+        power *= base;
+        ++num_digits;
+    }
+    return {power, num_digits};
+}
+
+} // namespace
+
+limb_type* long_int::allocate_limbs(std::size_t n)
+{
+    assert(is_inline());
+    assert(n != 0 and n <= std::numeric_limits<std::int32_t>::max());
+
+    auto const [ptr, size] = get_allocator().allocate(n * sizeof(limb_type), alignof(limb_type));
+    _limbs = static_cast<limb_type*>(ptr);
+    _capacity = static_cast<std::uint32_t>(std::min(size / sizeof(limb_type), std::size_t{std::numeric_limits<std::int32_t>::max()}));
+    _size = 0;
+    return _limbs;
+}
+
+void long_int::deallocate_limbs() noexcept
+{
+    assert(not is_inline());
+    get_allocator().deallocate(_limbs, _capacity * sizeof(limb_type));
+}
+
+void long_int::normalize(std::size_t n, bool negative) noexcept
+{
+    assert(not is_inline());
+
+    n = normalized_size(_limbs, n);
+    if (n <= 1) {
+        auto const m = n == 0 ? limb_type{0} : _limbs[0];
+        auto const max = static_cast<limb_type>(std::numeric_limits<std::int64_t>::max()) + negative;
+        if (m <= max) {
+            deallocate_limbs();
+            _value = static_cast<std::int64_t>(negative ? 0 - m : m);
+            _size = 0;
+            _capacity = 0;
+            return;
+        }
+    }
+    _size = static_cast<std::int32_t>(negative ? -static_cast<std::ptrdiff_t>(n) : static_cast<std::ptrdiff_t>(n));
+}
+
+void long_int::assign_magnitude(limb_type lo, limb_type hi, bool negative)
+{
+    assert(is_inline());
+
+    auto const max = static_cast<limb_type>(std::numeric_limits<std::int64_t>::max()) + negative;
+    if (hi == 0 and lo <= max) {
+        _value = static_cast<std::int64_t>(negative ? 0 - lo : lo);
+        return;
+    }
+
+    auto* p = allocate_limbs(2);
+    p[0] = lo;
+    p[1] = hi;
+    normalize(2, negative);
+}
+
+std::optional<long_int> long_int::from_string(std::string_view str, unsigned int base, allocator_intf& allocator)
+{
+    assert(base >= 2 and base <= 36);
+
+    auto const negative = str.starts_with('-');
+    if (negative) {
+        str.remove_prefix(1);
+    }
+    if (str.empty()) {
+        return std::nullopt;
+    }
+
+    // Accumulate the digits in chunks that fit in a single limb.
+    auto const [power, chunk_size] = limb_power(base);
+    auto limbs = std::vector<limb_type>{};
+    limbs.reserve(str.size() / chunk_size + 1);
+    for (auto i = 0uz; i < str.size(); i += chunk_size) {
+        auto const chunk = str.substr(i, chunk_size);
+
+        auto chunk_value = limb_type{0};
+        auto chunk_power = limb_type{1};
+        for (auto const c : chunk) {
+            auto const digit = digit_value(c);
+            if (digit >= static_cast<int>(base)) {
+                return std::nullopt;
+            }
+            chunk_value = chunk_value * base + static_cast<limb_type>(digit);
+            chunk_power *= base;
+        }
+
+        // limbs = limbs * base^chunk.size() + chunk_value
+        auto const m = chunk.size() == chunk_size ? power : chunk_power;
+        auto carry = mul_1(limbs.data(), limbs.data(), limbs.size(), m);
+        for (auto j = 0uz; j != limbs.size() and chunk_value != 0; ++j) {
+            chunk_value = add_carry(0, limbs[j], chunk_value, limbs[j]);
+        }
+        carry += chunk_value;
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+    }
+
+    auto r = long_int{allocator};
+    if (limbs.empty()) {
+        return r;
+    }
+
+    std::copy_n(limbs.data(), limbs.size(), r.allocate_limbs(limbs.size()));
+    r.normalize(limbs.size(), negative);
+    return r;
+}
+
+void long_int::reloc_get(heap_snapshot& snapshot, std::size_t offset) const
+{
+    auto const member_offset = [this](auto const& member) {
+        return static_cast<std::size_t>(reinterpret_cast<char const*>(&member) - reinterpret_cast<char const*>(this));
+    };
+
+    snapshot.write(offset + member_offset(_allocator), static_cast<allocator_intf*>(nullptr));
+    if (is_inline()) {
+        return;
+    }
+
+    // Only the used limbs are copied.
+    auto const n = num_limbs();
+    auto const [target, added] = snapshot.add_object(_limbs, n * sizeof(limb_type), alignof(limb_type));
+    snapshot.write(offset + member_offset(_capacity), static_cast<std::uint32_t>(n));
+    snapshot.add_patch(offset + member_offset(_limbs), target);
+}
+
+std::string long_int::to_string(unsigned int base) const
+{
+    assert(base >= 2 and base <= 36);
+
+    if (is_inline()) {
+        auto buffer = std::array<char, 66>{};
+        auto const [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), _value, static_cast<int>(base));
+        assert(ec == std::errc{});
+        return std::string{buffer.data(), end};
+    }
+
+    // Divide by the largest power of the base that fits in a limb, each
+    // remainder is a chunk of digits.
+    auto const [power, chunk_size] = limb_power(base);
+    auto limbs = std::vector<limb_type>{_limbs, _limbs + num_limbs()};
+
+    auto r = std::string{};
+    while (not limbs.empty()) {
+        auto chunk = divmod_1(limbs.data(), limbs.data(), limbs.size(), power);
+        limbs.resize(normalized_size(limbs.data(), limbs.size()));
+
+        for (auto i = 0uz; i != chunk_size and (chunk != 0 or not limbs.empty()); ++i) {
+            r += "0123456789abcdefghijklmnopqrstuvwxyz"[chunk % base];
+            chunk /= base;
+        }
+    }
+
+    if (_size < 0) {
+        r += '-';
+    }
+    std::ranges::reverse(r);
+    return r;
+}
+
+std::size_t long_int::bit_width_slow() const noexcept
+{
+    assert(not is_inline());
+
+    auto const n = num_limbs();
+    auto const top = _limbs[n - 1];
+    auto r = (n - 1) * 64 + static_cast<std::size_t>(std::bit_width(top));
+
+    // The bit width of -value - 1 is one less when the magnitude is a power of two.
+    if (_size < 0 and std::has_single_bit(top) and normalized_size(_limbs, n - 1) == 0) {
+        --r;
+    }
+    return r;
+}
+
+std::size_t long_int::hash_slow() const noexcept
+{
+    auto r = static_cast<std::uint64_t>(static_cast<std::int64_t>(_size));
+    for (auto i = 0uz; i != num_limbs(); ++i) {
+        r = (r ^ _limbs[i]) * 0x9e37'79b9'7f4a'7c15;
+    }
+    return static_cast<std::size_t>(r ^ (r >> 32));
+}
+
+bool long_int::equal_slow(long_int const& lhs, long_int const& rhs) noexcept
+{
+    if (lhs.is_inline() or rhs.is_inline()) {
+        return false;
+    }
+    return lhs._size == rhs._size and std::equal(lhs._limbs, lhs._limbs + lhs.num_limbs(), rhs._limbs);
+}
+
+std::strong_ordering long_int::compare_slow(long_int const& lhs, long_int const& rhs) noexcept
+{
+    // A value on the heap is larger in magnitude than any inline value.
+    if (lhs.is_inline()) {
+        return rhs._size < 0 ? std::strong_ordering::greater : std::strong_ordering::less;
+    } else if (rhs.is_inline()) {
+        return lhs._size < 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+    } else if (lhs._size != rhs._size) {
+        return lhs._size <=> rhs._size;
+    }
+
+    auto const r = compare(lhs._limbs, rhs._limbs, lhs.num_limbs());
+    return lhs._size < 0 ? 0 <=> r : r;
+}
+
+long_int long_int::negate_slow(long_int const& rhs)
+{
+    auto buffer = limb_type{};
+    auto const [a, an, a_negative] = rhs.magnitude(buffer);
+
+    auto r = long_int{0, rhs._allocator};
+    std::copy_n(a, an, r.allocate_limbs(an));
+    r.normalize(an, not a_negative);
+    return r;
+}
+
+long_int long_int::add_slow(long_int const& lhs, long_int const& rhs, bool negate_rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    if (lhs.is_inline() and rhs.is_inline()) {
+        auto const b = static_cast<__int128>(rhs._value);
+        auto r = long_int{0, lhs._allocator};
+        r.assign_int128(lhs._value + (negate_rhs ? -b : b));
+        return r;
+    }
+#endif
+
+    auto a_buffer = limb_type{};
+    auto b_buffer = limb_type{};
+    auto [a, an, a_negative] = lhs.magnitude(a_buffer);
+    auto [b, bn, b_negative] = rhs.magnitude(b_buffer);
+    b_negative ^= negate_rhs;
+
+    if (an < bn or (an == bn and compare(a, b, an) < 0)) {
+        std::swap(a, b);
+        std::swap(an, bn);
+        std::swap(a_negative, b_negative);
+    }
+
+    auto r = long_int{0, lhs._allocator};
+    if (a_negative == b_negative) {
+        auto* p = r.allocate_limbs(an + 1);
+        p[an] = add(p, a, an, b, bn);
+        r.normalize(an + 1, a_negative);
+
+    } else if (an != 0) {
+        // |a| >= |b|, so the result has the sign of a.
+        auto* p = r.allocate_limbs(an);
+        sub(p, a, an, b, bn);
+        r.normalize(an, a_negative);
+    }
+    return r;
+}
+
+long_int long_int::mul_slow(long_int const& lhs, long_int const& rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    if (lhs.is_inline() and rhs.is_inline()) {
+        auto r = long_int{0, lhs._allocator};
+        r.assign_int128(static_cast<__int128>(lhs._value) * rhs._value);
+        return r;
+    }
+#endif
+
+    auto a_buffer = limb_type{};
+    auto b_buffer = limb_type{};
+    auto const [a, an, a_negative] = lhs.magnitude(a_buffer);
+    auto const [b, bn, b_negative] = rhs.magnitude(b_buffer);
+    if (an == 0 or bn == 0) {
+        return long_int{0, lhs._allocator};
+    }
+
+    auto r = long_int{0, lhs._allocator};
+    auto* p = r.allocate_limbs(an + bn);
+    mul(p, a, an, b, bn);
+    r.normalize(an + bn, a_negative != b_negative);
+    return r;
+}
+
+std::pair<long_int, long_int> long_int::divmod_slow(long_int const& lhs, long_int const& rhs)
+{
+    auto a_buffer = limb_type{};
+    auto b_buffer = limb_type{};
+    auto const [a, an, a_negative] = lhs.magnitude(a_buffer);
+    auto const [b, bn, b_negative] = rhs.magnitude(b_buffer);
+    assert(bn != 0);
+
+    if (an < bn or (an == bn and compare(a, b, an) < 0)) {
+        return {long_int{0, lhs._allocator}, lhs};
+    }
+
+    auto q = long_int{0, lhs._allocator};
+    auto r = long_int{0, lhs._allocator};
+    auto* q_limbs = q.allocate_limbs(an - bn + 1);
+    if (bn == 1) {
+        auto* r_limbs = r.allocate_limbs(1);
+        r_limbs[0] = divmod_1(q_limbs, a, an, b[0]);
+        r.normalize(1, a_negative);
+    } else {
+        auto* r_limbs = r.allocate_limbs(bn);
+        divmod_n(q_limbs, r_limbs, a, an, b, bn);
+        r.normalize(bn, a_negative);
+    }
+    q.normalize(an - bn + 1, a_negative != b_negative);
+    return {std::move(q), std::move(r)};
+}
+
+long_int long_int::shift_left_slow(long_int const& lhs, std::size_t rhs)
+{
+    auto buffer = limb_type{};
+    auto const [a, an, a_negative] = lhs.magnitude(buffer);
+    if (an == 0) {
+        return long_int{0, lhs._allocator};
+    }
+
+    auto const limb_shift = rhs / 64;
+    auto const n = an + limb_shift + 1;
+
+    auto r = long_int{0, lhs._allocator};
+    auto* p = r.allocate_limbs(n);
+    std::fill_n(p, limb_shift, 0);
+    p[n - 1] = shift_left(p + limb_shift, a, an, static_cast<unsigned int>(rhs % 64));
+    r.normalize(n, a_negative);
+    return r;
+}
+
+long_int long_int::shift_right_slow(long_int const& lhs, std::size_t rhs)
+{
+    assert(not lhs.is_inline());
+
+    auto const an = lhs.num_limbs();
+    auto const a_negative = lhs._size < 0;
+    auto const limb_shift = rhs / 64;
+    auto const bit_shift = static_cast<unsigned int>(rhs % 64);
+    if (limb_shift >= an) {
+        return long_int{a_negative ? -1 : 0, lhs._allocator};
+    }
+
+    auto const n = an - limb_shift;
+    auto r = long_int{0, lhs._allocator};
+    auto* p = r.allocate_limbs(n + 1);
+    shift_right(p, lhs._limbs + limb_shift, n, bit_shift);
+    p[n] = 0;
+
+    // Round toward negative infinity, when a negative value loses bits.
+    if (a_negative) {
+        auto lost = normalized_size(lhs._limbs, limb_shift) != 0;
+        if (bit_shift != 0) {
+            lost |= (lhs._limbs[limb_shift] << (64 - bit_shift)) != 0;
+        }
+        if (lost) {
+            auto const one = limb_type{1};
+            add(p, p, n + 1, &one, 1);
+        }
+    }
+
+    r.normalize(n + 1, a_negative);
+    return r;
+}
+
+}
@@ -1,44 +1,546 @@
 
 #pragma once
 
-#include <cstdint>
 #include "allocator.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace hk::builtin {
 
-using int_reg_t = std::int64_t;
-using uint_reg_t = std::uint64_t;
+class heap_snapshot;
 
-struct long_int {
-    union {
-        uint_reg_t *pointer;
-        std::int64_t value = 0;
-    };
-    uint32_t size = 0;
-    uint32_t capacity = 0;
+/** A signed integer of arbitrary size.
+ *
+ * Values that fit in 64 bits are stored inline, without allocation. Larger
+ * values are stored on the heap as a sign and a magnitude of 64-bit limbs,
+ * the least significant limb first.
+ *
+ * The representation is canonical: a value is only stored on the heap when it
+ * does not fit in 64 bits. Therefore the operators first check if both
+ * operands are inline and then use the 64-bit instructions with overflow
+ * detection, only calling the out-of-line slow path on overflow.
+ *
+ * The limbs are allocated from the allocator that is passed to the
+ * constructor, by default the global `operator new`. The allocator follows
+ * the value: copies use the same allocator, and the result of an operation
+ * uses the allocator of the left operand.
+ */
+class long_int {
+public:
+    using limb_type = std::uint64_t;
 
-    ~long_int() {
-        if (size != 0) {
-            deallocate(pointer, capacity);
+    /** The number of limbs from which multiplication uses the Karatsuba algorithm.
+     */
+    constexpr static auto karatsuba_threshold = 32uz;
+
+    ~long_int()
+    {
+        if (not is_inline()) {
+            deallocate_limbs();
         }
     }
 
     constexpr long_int() noexcept = default;
 
-    constexpr long_int(long_int const& rhs) {
-        if (rhs.capacity == 0) {
-            value = rhs.value;
-            size = 0;
-            capacity = 0;
+    long_int(long_int const& other) : _allocator(other._allocator)
+    {
+        if (other.is_inline()) {
+            _value = other._value;
+        } else {
+            auto const n = other.num_limbs();
+            auto* p = allocate_limbs(n);
+            std::copy_n(other._limbs, n, p);
+            _size = other._size;
+        }
+    }
+
+    long_int(long_int&& other) noexcept
+    {
+        take(other);
+    }
+
+    long_int& operator=(long_int const& other)
+    {
+        if (this != &other) {
+            *this = long_int{other};
+        }
+        return *this;
+    }
+
+    long_int& operator=(long_int&& other) noexcept
+    {
+        if (this != &other) {
+            if (not is_inline()) {
+                deallocate_limbs();
+            }
+            take(other);
+        }
+        return *this;
+    }
+
+    /** The value zero, with an allocator for when the value grows.
+     */
+    explicit long_int(allocator_intf& allocator) noexcept : _allocator(&allocator) {}
+
+    template<std::signed_integral T>
+        requires(sizeof(T) <= sizeof(std::int64_t))
+    constexpr long_int(T value) noexcept : _value(value)
+    {
+    }
+
+    template<std::signed_integral T>
+        requires(sizeof(T) <= sizeof(std::int64_t))
+    long_int(T value, allocator_intf& allocator) noexcept : _value(value), _allocator(&allocator)
+    {
+    }
+
+    template<std::unsigned_integral T>
+        requires(sizeof(T) <= sizeof(limb_type) and not std::same_as<T, bool>)
+    long_int(T value)
+    {
+        assign_magnitude(value, 0, false);
+    }
+
+    template<std::unsigned_integral T>
+        requires(sizeof(T) <= sizeof(limb_type) and not std::same_as<T, bool>)
+    long_int(T value, allocator_intf& allocator) : _allocator(&allocator)
+    {
+        assign_magnitude(value, 0, false);
+    }
+
+#if defined(__SIZEOF_INT128__)
+    explicit long_int(__int128 value)
+    {
+        assign_int128(value);
+    }
+
+    long_int(__int128 value, allocator_intf& allocator) : _allocator(&allocator)
+    {
+        assign_int128(value);
+    }
+#endif
+
+    /** Parse an integer.
+     *
+     * @param str The digits, optionally preceded by a '-'. Digits above 9
+     *            are the letters 'a' to 'z', in either case.
+     * @param base The base of the digits, between 2 and 36.
+     * @param allocator The allocator of the integer.
+     * @return The integer, or empty if @a str is not a valid integer.
+     */
+    [[nodiscard]] static std::optional<long_int>
+    from_string(std::string_view str, unsigned int base = 10, allocator_intf& allocator = _default_allocator);
+
+    /** Format the integer.
+     *
+     * @param base The base of the digits, between 2 and 36.
+     * @return The digits in lower case, preceded by a '-' when negative.
+     */
+    [[nodiscard]] std::string to_string(unsigned int base = 10) const;
+
+    /** Convert to a machine integer.
+     *
+     * @return The value, or empty if it does not fit in @a T.
+     */
+    template<std::integral T>
+    [[nodiscard]] std::optional<T> to() const noexcept
+    {
+        if (is_inline()) {
+            if (std::in_range<T>(_value)) {
+                return static_cast<T>(_value);
+            }
+        } else if constexpr (std::unsigned_integral<T>) {
+            if (_size == 1 and _limbs[0] <= std::numeric_limits<T>::max()) {
+                return static_cast<T>(_limbs[0]);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /** The allocator of the limbs.
+     */
+    [[nodiscard]] allocator_intf& get_allocator() const noexcept
+    {
+        return _allocator != nullptr ? *_allocator : _default_allocator;
+    }
+
+    /** Add the limbs to a heap snapshot, after this integer was copied to @a offset.
+     *
+     * In the snapshot the integer uses the default allocator.
+     */
+    void reloc_get(heap_snapshot& snapshot, std::size_t offset) const;
+
+    /** The value fits in 64 bits and is stored inline.
+     */
+    [[nodiscard]] constexpr bool is_inline() const noexcept
+    {
+        return _capacity == 0;
+    }
+
+    /** The value, when stored inline.
+     *
+     * @pre `is_inline()`
+     */
+    [[nodiscard]] constexpr std::int64_t inline_value() const noexcept
+    {
+        assert(is_inline());
+        return _value;
+    }
+
+    [[nodiscard]] constexpr bool is_negative() const noexcept
+    {
+        return is_inline() ? _value < 0 : _size < 0;
+    }
+
+    /** The sign of the value: -1, 0 or 1.
+     */
+    [[nodiscard]] constexpr int sign() const noexcept
+    {
+        if (is_inline()) {
+            return (_value > 0) - (_value < 0);
+        }
+        return _size < 0 ? -1 : 1;
+    }
+
+    /** The number of bits to represent the value in two's complement, excluding the sign bit.
+     *
+     * For non-negative values this is the same as `std::bit_width()`, for
+     * negative values it is the bit width of `-value - 1`.
+     */
+    [[nodiscard]] std::size_t bit_width() const noexcept
+    {
+        if (is_inline()) [[likely]] {
+            return static_cast<std::size_t>(std::bit_width(static_cast<limb_type>(_value < 0 ? ~_value : _value)));
+        }
+        return bit_width_slow();
+    }
+
+    /** A hash of the value; equal values have the same hash.
+     */
+    [[nodiscard]] std::size_t hash() const noexcept
+    {
+        if (is_inline()) [[likely]] {
+            return std::hash<std::int64_t>{}(_value);
+        }
+        return hash_slow();
+    }
+
+    [[nodiscard]] friend bool operator==(long_int const& lhs, long_int const& rhs) noexcept
+    {
+        if ((lhs._capacity | rhs._capacity) == 0) [[likely]] {
+            return lhs._value == rhs._value;
+        }
+        return equal_slow(lhs, rhs);
+    }
+
+    [[nodiscard]] friend std::strong_ordering operator<=>(long_int const& lhs, long_int const& rhs) noexcept
+    {
+        if ((lhs._capacity | rhs._capacity) == 0) [[likely]] {
+            return lhs._value <=> rhs._value;
+        }
+        return compare_slow(lhs, rhs);
+    }
+
+    [[nodiscard]] friend long_int operator-(long_int const& rhs)
+    {
+        if (rhs.is_inline() and rhs._value != std::numeric_limits<std::int64_t>::min()) [[likely]] {
+            return long_int{-rhs._value, rhs._allocator};
+        }
+        return negate_slow(rhs);
+    }
+
+    [[nodiscard]] friend long_int operator+(long_int const& lhs, long_int const& rhs)
+    {
+        if ((lhs._capacity | rhs._capacity) == 0) [[likely]] {
+            auto r = std::int64_t{};
+            if (not add_overflow(lhs._value, rhs._value, r)) [[likely]] {
+                return long_int{r, lhs._allocator};
+            }
+        }
+        return add_slow(lhs, rhs, false);
+    }
+
+    [[nodiscard]] friend long_int operator-(long_int const& lhs, long_int const& rhs)
+    {
+        if ((lhs._capacity | rhs._capacity) == 0) [[likely]] {
+            auto r = std::int64_t{};
+            if (not sub_overflow(lhs._value, rhs._value, r)) [[likely]] {
+                return long_int{r, lhs._allocator};
+            }
+        }
+        return add_slow(lhs, rhs, true);
+    }
+
+    [[nodiscard]] friend long_int operator*(long_int const& lhs, long_int const& rhs)
+    {
+        if ((lhs._capacity | rhs._capacity) == 0) [[likely]] {
+            auto r = std::int64_t{};
+            if (not mul_overflow(lhs._value, rhs._value, r)) [[likely]] {
+                return long_int{r, lhs._allocator};
+            }
+        }
+        return mul_slow(lhs, rhs);
+    }
+
+    /** Divide, rounding toward zero.
+     *
+     * @pre @a rhs is not zero.
+     * @return The quotient and the remainder, the remainder has the sign of @a lhs.
+     */
+    [[nodiscard]] friend std::pair<long_int, long_int> divmod(long_int const& lhs, long_int const& rhs)
+    {
+        if ((lhs._capacity | rhs._capacity) == 0 and rhs._value != -1) [[likely]] {
+            assert(rhs._value != 0);
+            return {long_int{lhs._value / rhs._value, lhs._allocator}, long_int{lhs._value % rhs._value, lhs._allocator}};
+        }
+        return divmod_slow(lhs, rhs);
+    }
+
+    [[nodiscard]] friend long_int operator/(long_int const& lhs, long_int const& rhs)
+    {
+        return divmod(lhs, rhs).first;
+    }
+
+    [[nodiscard]] friend long_int operator%(long_int const& lhs, long_int const& rhs)
+    {
+        return divmod(lhs, rhs).second;
+    }
+
+    [[nodiscard]] friend long_int operator<<(long_int const& lhs, std::size_t rhs)
+    {
+        if (lhs.is_inline() and rhs < 64) [[likely]] {
+            auto const r = lhs._value << rhs;
+            if ((r >> rhs) == lhs._value) [[likely]] {
+                return long_int{r, lhs._allocator};
+            }
+        }
+        return shift_left_slow(lhs, rhs);
+    }
+
+    /** Shift right, rounding toward negative infinity.
+     */
+    [[nodiscard]] friend long_int operator>>(long_int const& lhs, std::size_t rhs)
+    {
+        if (lhs.is_inline()) [[likely]] {
+            return long_int{lhs._value >> std::min(rhs, 63uz), lhs._allocator};
+        }
+        return shift_right_slow(lhs, rhs);
+    }
+
+    long_int& operator+=(long_int const& rhs)
+    {
+        return *this = *this + rhs;
+    }
+
+    long_int& operator-=(long_int const& rhs)
+    {
+        return *this = *this - rhs;
+    }
+
+    long_int& operator*=(long_int const& rhs)
+    {
+        return *this = *this * rhs;
+    }
+
+    long_int& operator/=(long_int const& rhs)
+    {
+        return *this = *this / rhs;
+    }
+
+    long_int& operator%=(long_int const& rhs)
+    {
+        return *this = *this % rhs;
+    }
+
+    long_int& operator<<=(std::size_t rhs)
+    {
+        return *this = *this << rhs;
+    }
+
+    long_int& operator>>=(std::size_t rhs)
+    {
+        return *this = *this >> rhs;
+    }
+
+private:
+    /** The sign and magnitude of a value, see `magnitude()`.
+     */
+    struct magnitude_type {
+        limb_type const* limbs;
+        std::size_t size;
+        bool negative;
+    };
+
+    union {
+        limb_type* _limbs;
+        std::int64_t _value = 0;
+    };
+
+    /** The number of limbs on the heap, negative when the value is negative.
+     */
+    std::int32_t _size = 0;
+
+    /** The number of limbs allocated on the heap, or zero when the value is inline.
+     */
+    std::uint32_t _capacity = 0;
+
+    /** The allocator, or nullptr for the default allocator.
+     */
+    allocator_intf* _allocator = nullptr;
+
+    constexpr long_int(std::int64_t value, allocator_intf* allocator) noexcept : _value(value), _allocator(allocator) {}
+
+    [[nodiscard]] constexpr std::size_t num_limbs() const noexcept
+    {
+        return static_cast<std::size_t>(_size < 0 ? -_size : _size);
+    }
+
+    /** Get the sign and magnitude of the value.
+     *
+     * @param buffer Storage for the magnitude of an inline value.
+     * @return The limbs of the magnitude without leading zeros, the number of
+     *         limbs, and if the value is negative.
+     */
+    [[nodiscard]] magnitude_type magnitude(limb_type& buffer) const noexcept
+    {
+        if (is_inline()) {
+            buffer = _value < 0 ? 0 - static_cast<limb_type>(_value) : static_cast<limb_type>(_value);
+            return {&buffer, _value != 0 ? 1uz : 0uz, _value < 0};
+        }
+        return {_limbs, num_limbs(), _size < 0};
+    }
+
+    /** Move the value and allocator of @a other into this, which must be empty.
+     */
+    void take(long_int& other) noexcept
+    {
+        _allocator = other._allocator;
+        if (other.is_inline()) {
+            _value = other._value;
         } else {
-            auto [tmp_ptr, tmp_capacity] = allocate(rhs.size, sizeof(uint_reg_t));
-            pointer = static_cast<uint_reg_t *>(tmp_ptr);
-            size = rhs.size;
-            capacity = tmp_capacity;
-            memcpy
+            _limbs = other._limbs;
         }
+        _size = std::exchange(other._size, 0);
+        _capacity = std::exchange(other._capacity, 0);
+        other._value = 0;
     }
 
+    /** Allocate the limbs of an inline value.
+     *
+     * @pre `is_inline()`
+     * @param n The number of limbs.
+     * @return The uninitialized limbs, finish with `normalize()`.
+     */
+    [[nodiscard]] limb_type* allocate_limbs(std::size_t n);
+
+    void deallocate_limbs() noexcept;
+
+    /** Set the value after writing the limbs.
+     *
+     * Leading zero limbs are removed, and the limbs are deallocated when the
+     * value fits inline.
+     *
+     * @param n The number of limbs written.
+     * @param negative The value is negative.
+     */
+    void normalize(std::size_t n, bool negative) noexcept;
+
+    /** Set an inline value to a magnitude of at most two limbs.
+     */
+    void assign_magnitude(limb_type lo, limb_type hi, bool negative);
+
+#if defined(__SIZEOF_INT128__)
+    /** Set an inline value.
+     */
+    void assign_int128(__int128 value)
+    {
+        assert(is_inline());
+
+        if (value >= std::numeric_limits<std::int64_t>::min() and value <= std::numeric_limits<std::int64_t>::max()) [[likely]] {
+            _value = static_cast<std::int64_t>(value);
+            return;
+        }
+
+        auto const negative = value < 0;
+        auto const m = negative ? 0 - static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value);
+        assign_magnitude(static_cast<limb_type>(m), static_cast<limb_type>(m >> 64), negative);
+    }
+#endif
+
+    [[nodiscard]] std::size_t bit_width_slow() const noexcept;
+    [[nodiscard]] std::size_t hash_slow() const noexcept;
+    [[nodiscard]] static bool equal_slow(long_int const& lhs, long_int const& rhs) noexcept;
+    [[nodiscard]] static std::strong_ordering compare_slow(long_int const& lhs, long_int const& rhs) noexcept;
+    [[nodiscard]] static long_int negate_slow(long_int const& rhs);
+    [[nodiscard]] static long_int add_slow(long_int const& lhs, long_int const& rhs, bool negate_rhs);
+    [[nodiscard]] static long_int mul_slow(long_int const& lhs, long_int const& rhs);
+    [[nodiscard]] static std::pair<long_int, long_int> divmod_slow(long_int const& lhs, long_int const& rhs);
+    [[nodiscard]] static long_int shift_left_slow(long_int const& lhs, std::size_t rhs);
+    [[nodiscard]] static long_int shift_right_slow(long_int const& lhs, std::size_t rhs);
+
+    [[nodiscard]] static bool add_overflow(std::int64_t a, std::int64_t b, std::int64_t& r) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_add_overflow(a, b, &r);
+#else
+        r = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+        return ((a ^ r) & (b ^ r)) < 0;
+#endif
+    }
+
+    [[nodiscard]] static bool sub_overflow(std::int64_t a, std::int64_t b, std::int64_t& r) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_sub_overflow(a, b, &r);
+#else
+        r = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+        return ((a ^ b) & (a ^ r)) < 0;
+#endif
+    }
+
+    [[nodiscard]] static bool mul_overflow(std::int64_t a, std::int64_t b, std::int64_t& r) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_mul_overflow(a, b, &r);
+#else
+        auto hi = std::int64_t{};
+        r = _mul128(a, b, &hi);
+        return hi != (r >> 63);
+#endif
+    }
+};
+
+}
+
+template<typename CharT>
+struct std::formatter<hk::builtin::long_int, CharT> : std::formatter<std::basic_string<CharT>, CharT> {
+    template<typename FormatContext>
+    auto format(hk::builtin::long_int const& v, FormatContext& ctx) const
+    {
+        return std::formatter<std::basic_string<CharT>, CharT>::format(v.to_string(), ctx);
+    }
 };
 
-}
\ No newline at end of file
+template<>
+struct std::hash<hk::builtin::long_int> {
+    [[nodiscard]] std::size_t operator()(hk::builtin::long_int const& x) const noexcept
+    {
+        return x.hash();
+    }
+};
@@ -0,0 +1,164 @@
+
+#include "long_int.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(HK_HAVE_GMP)
+#include <gmp.h>
+#endif
+
+namespace {
+
+using hk::builtin::long_int;
+
+/** 1024 random operands of at most @a num_bits bits, as hexadecimal digits.
+ */
+[[nodiscard]] std::vector<std::string> make_operands(std::size_t num_bits)
+{
+    auto engine = std::mt19937_64{1};
+
+    auto r = std::vector<std::string>{};
+    r.reserve(1024);
+    for (auto i = 0uz; i != 1024; ++i) {
+        auto str = std::string{};
+        for (auto j = 0uz; j < num_bits; j += 4) {
+            str += "0123456789abcdef"[engine() % 16];
+        }
+        if (i % 2 == 1) {
+            str.insert(0, 1, '-');
+        }
+        r.push_back(std::move(str));
+    }
+    return r;
+}
+
+[[nodiscard]] std::vector<long_int> make_long_ints(std::size_t num_bits)
+{
+    auto r = std::vector<long_int>{};
+    for (auto const& str : make_operands(num_bits)) {
+        r.push_back(long_int::from_string(str, 16).value());
+    }
+    return r;
+}
+
+enum class operation { add, mul, divmod };
+
+/** Apply an operation on 1024 pairs of operands.
+ *
+ * The argument is the number of bits of each operand. For `divmod` the
+ * dividend has twice the number of bits of the divisor.
+ */
+void bm_long_int(benchmark::State& state, operation op)
+{
+    auto const num_bits = static_cast<std::size_t>(state.range(0));
+    auto const lhs = make_long_ints(op == operation::divmod ? num_bits * 2 : num_bits);
+    auto const rhs = make_long_ints(num_bits);
+
+    for (auto _ : state) {
+        for (auto i = 0uz; i != lhs.size(); ++i) {
+            auto const& a = lhs[i];
+            auto const& b = rhs[rhs.size() - i - 1];
+            switch (op) {
+            case operation::add:
+                benchmark::DoNotOptimize(a + b);
+                break;
+            case operation::mul:
+                benchmark::DoNotOptimize(a * b);
+                break;
+            case operation::divmod:
+                if (b != long_int{0}) {
+                    benchmark::DoNotOptimize(divmod(a, b));
+                }
+                break;
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lhs.size()));
+}
+
+void bm_long_int_to_string(benchmark::State& state)
+{
+    auto const values = make_long_ints(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        for (auto const& value : values) {
+            benchmark::DoNotOptimize(value.to_string());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+#if defined(HK_HAVE_GMP)
+/** The same operations as `bm_long_int()` using GMP, as a baseline.
+ */
+void bm_gmp(benchmark::State& state, operation op)
+{
+    auto const num_bits = static_cast<std::size_t>(state.range(0));
+    auto const make_mpzs = [](std::size_t num_bits) {
+        auto const operands = make_operands(num_bits);
+        auto r = std::vector<__mpz_struct>(operands.size());
+        for (auto i = 0uz; i != r.size(); ++i) {
+            mpz_init_set_str(&r[i], operands[i].c_str(), 16);
+        }
+        return r;
+    };
+    auto lhs = make_mpzs(op == operation::divmod ? num_bits * 2 : num_bits);
+    auto rhs = make_mpzs(num_bits);
+
+    mpz_t q;
+    mpz_t r;
+    mpz_init(q);
+    mpz_init(r);
+
+    for (auto _ : state) {
+        for (auto i = 0uz; i != lhs.size(); ++i) {
+            auto* a = &lhs[i];
+            auto* b = &rhs[rhs.size() - i - 1];
+            switch (op) {
+            case operation::add:
+                mpz_add(r, a, b);
+                break;
+            case operation::mul:
+                mpz_mul(r, a, b);
+                break;
+            case operation::divmod:
+                if (mpz_sgn(b) != 0) {
+                    mpz_tdiv_qr(q, r, a, b);
+                }
+                break;
+            }
+            benchmark::DoNotOptimize(r);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lhs.size()));
+
+    mpz_clear(q);
+    mpz_clear(r);
+    for (auto& x : lhs) {
+        mpz_clear(&x);
+    }
+    for (auto& x : rhs) {
+        mpz_clear(&x);
+    }
+}
+#endif
+
+} // namespace
+
+// From inline 32-bit values to 1024 limbs; Karatsuba is used from 2048 bits.
+BENCHMARK_CAPTURE(bm_long_int, add, operation::add)->RangeMultiplier(8)->Range(32, 1 << 16);
+BENCHMARK_CAPTURE(bm_long_int, mul, operation::mul)->RangeMultiplier(8)->Range(32, 1 << 16);
+BENCHMARK_CAPTURE(bm_long_int, divmod, operation::divmod)->RangeMultiplier(8)->Range(32, 1 << 16);
+BENCHMARK(bm_long_int_to_string)->RangeMultiplier(8)->Range(32, 1 << 12);
+
+#if defined(HK_HAVE_GMP)
+BENCHMARK_CAPTURE(bm_gmp, add, operation::add)->RangeMultiplier(8)->Range(32, 1 << 16);
+BENCHMARK_CAPTURE(bm_gmp, mul, operation::mul)->RangeMultiplier(8)->Range(32, 1 << 16);
+BENCHMARK_CAPTURE(bm_gmp, divmod, operation::divmod)->RangeMultiplier(8)->Range(32, 1 << 16);
+#endif
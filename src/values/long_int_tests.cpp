@@ -0,0 +1,263 @@
+
+#include "long_int.hpp"
+#include "arena_allocator.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace {
+
+using hk::builtin::long_int;
+
+[[nodiscard]] long_int parse(std::string_view str, unsigned int base = 10)
+{
+    return long_int::from_string(str, base).value();
+}
+
+/** A pseudo random number of @a n limbs.
+ */
+[[nodiscard]] long_int random_long_int(std::size_t n, std::uint64_t& seed)
+{
+    auto r = long_int{};
+    for (auto i = 0uz; i != n; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        r = (r << 64) + long_int{seed};
+    }
+    return r;
+}
+
+} // namespace
+
+TEST_SUITE(long_int_suite)
+{
+
+TEST_CASE(inline_arithmetic)
+{
+    REQUIRE(long_int{3} + long_int{4} == long_int{7});
+    REQUIRE(long_int{3} - long_int{4} == long_int{-1});
+    REQUIRE(long_int{-3} * long_int{4} == long_int{-12});
+    REQUIRE(long_int{13} / long_int{4} == long_int{3});
+    REQUIRE(long_int{13} % long_int{4} == long_int{1});
+    REQUIRE(-long_int{5} == long_int{-5});
+    REQUIRE((long_int{3} + long_int{4}).is_inline());
+}
+
+TEST_CASE(overflow_to_heap)
+{
+    auto const max = long_int{std::numeric_limits<std::int64_t>::max()};
+    auto const min = long_int{std::numeric_limits<std::int64_t>::min()};
+
+    auto const a = max + long_int{1};
+    REQUIRE(not a.is_inline());
+    REQUIRE(a.to_string() == "9223372036854775808");
+    REQUIRE(a - long_int{1} == max);
+    REQUIRE((a - long_int{1}).is_inline());
+
+    auto const b = min - long_int{1};
+    REQUIRE(not b.is_inline());
+    REQUIRE(b.to_string() == "-9223372036854775809");
+    REQUIRE(b + long_int{1} == min);
+
+    REQUIRE(-min == a);
+    REQUIRE(-a == min);
+    REQUIRE((-a).is_inline());
+
+    REQUIRE(max * max == parse("85070591730234615847396907784232501249"));
+    REQUIRE(min * min == parse("85070591730234615865843651857942052864"));
+    REQUIRE(min * long_int{-1} == a);
+    REQUIRE(min / long_int{-1} == a);
+    REQUIRE(min % long_int{-1} == long_int{0});
+}
+
+TEST_CASE(unsigned_conversion)
+{
+    auto const a = long_int{std::numeric_limits<std::uint64_t>::max()};
+    REQUIRE(not a.is_inline());
+    REQUIRE(a.to_string(16) == "ffffffffffffffff");
+    REQUIRE(a.to<std::uint64_t>() == std::numeric_limits<std::uint64_t>::max());
+    REQUIRE(not a.to<std::int64_t>());
+
+    REQUIRE(long_int{-1}.to<std::int8_t>() == std::int8_t{-1});
+    REQUIRE(not long_int{-1}.to<std::uint8_t>());
+    REQUIRE(not long_int{256}.to<std::uint8_t>());
+    REQUIRE(long_int{255}.to<std::uint8_t>() == std::uint8_t{255});
+}
+
+TEST_CASE(string_conversion)
+{
+    REQUIRE(parse("0") == long_int{0});
+    REQUIRE(parse("-0") == long_int{0});
+    REQUIRE(parse("-42") == long_int{-42});
+    REQUIRE(parse("ff", 16) == long_int{255});
+    REQUIRE(parse("FF", 16) == long_int{255});
+    REQUIRE(parse("-101", 2) == long_int{-5});
+    REQUIRE(not long_int::from_string(""));
+    REQUIRE(not long_int::from_string("-"));
+    REQUIRE(not long_int::from_string("12a"));
+    REQUIRE(not long_int::from_string("2", 2));
+
+    auto const digits = std::string{"123456789012345678901234567890123456789012345678901234567890"};
+    REQUIRE(parse(digits).to_string() == digits);
+    REQUIRE(parse("-" + digits).to_string() == "-" + digits);
+    REQUIRE(parse("100000000000000000000000000000000", 16).to_string(16) == "100000000000000000000000000000000");
+    REQUIRE(parse("100000000000000000000000000000000", 16) == long_int{1} << 128);
+    REQUIRE(std::format("{}", parse("-" + digits)) == "-" + digits);
+}
+
+TEST_CASE(compare)
+{
+    auto const big = long_int{1} << 100;
+    REQUIRE(long_int{1} < long_int{2});
+    REQUIRE(long_int{-2} < long_int{1});
+    REQUIRE(long_int{1} < big);
+    REQUIRE(-big < long_int{-1});
+    REQUIRE(-big < big);
+    REQUIRE(big < big + long_int{1});
+    REQUIRE(-big - long_int{1} < -big);
+    REQUIRE(big < big << 1);
+    REQUIRE(-(big << 1) < -big);
+    REQUIRE(big == long_int{1} << 100);
+    REQUIRE(big != -big);
+}
+
+TEST_CASE(shift)
+{
+    REQUIRE((long_int{1} << 100).to_string() == "1267650600228229401496703205376");
+    REQUIRE((long_int{-3} << 64).to_string() == "-55340232221128654848");
+    REQUIRE((long_int{1} << 63).to_string() == "9223372036854775808");
+    REQUIRE((long_int{-1} << 63) == long_int{std::numeric_limits<std::int64_t>::min()});
+    REQUIRE((long_int{-1} << 63).is_inline());
+    REQUIRE((long_int{1} << 100) >> 100 == long_int{1});
+    REQUIRE(((long_int{1} << 100) + long_int{5}) >> 98 == long_int{4});
+    REQUIRE(long_int{-1} >> 5 == long_int{-1});
+    REQUIRE(long_int{-5} >> 1 == long_int{-3});
+    REQUIRE(long_int{5} >> 100 == long_int{0});
+    REQUIRE(long_int{-5} >> 100 == long_int{-1});
+
+    // Shifting right rounds toward negative infinity.
+    REQUIRE(-(long_int{1} << 100) >> 100 == long_int{-1});
+    REQUIRE((-(long_int{1} << 100) - long_int{1}) >> 100 == long_int{-2});
+    REQUIRE(-(long_int{1} << 100) >> 200 == long_int{-1});
+    REQUIRE((long_int{1} << 100) >> 200 == long_int{0});
+}
+
+TEST_CASE(bit_width)
+{
+    REQUIRE(long_int{0}.bit_width() == 0);
+    REQUIRE(long_int{-1}.bit_width() == 0);
+    REQUIRE(long_int{255}.bit_width() == 8);
+    REQUIRE(long_int{-128}.bit_width() == 7);
+    REQUIRE(long_int{-129}.bit_width() == 8);
+    REQUIRE(long_int{std::numeric_limits<std::int64_t>::min()}.bit_width() == 63);
+    REQUIRE((long_int{1} << 64).bit_width() == 65);
+    REQUIRE((-(long_int{1} << 64)).bit_width() == 64);
+    REQUIRE((-(long_int{1} << 64) - long_int{1}).bit_width() == 65);
+    REQUIRE(long_int{std::numeric_limits<std::uint64_t>::max()}.bit_width() == 64);
+}
+
+TEST_CASE(divmod_signs)
+{
+    REQUIRE(divmod(long_int{7}, long_int{2}) == std::pair(long_int{3}, long_int{1}));
+    REQUIRE(divmod(long_int{-7}, long_int{2}) == std::pair(long_int{-3}, long_int{-1}));
+    REQUIRE(divmod(long_int{7}, long_int{-2}) == std::pair(long_int{-3}, long_int{1}));
+    REQUIRE(divmod(long_int{-7}, long_int{-2}) == std::pair(long_int{3}, long_int{-1}));
+
+    auto const big = (long_int{1} << 130) + long_int{7};
+    REQUIRE(divmod(-big, long_int{1} << 65) == std::pair(-(long_int{1} << 65), long_int{-7}));
+    REQUIRE(divmod(long_int{7}, big) == std::pair(long_int{0}, long_int{7}));
+}
+
+TEST_CASE(factorial)
+{
+    auto r = long_int{1};
+    for (auto i = 1; i <= 30; ++i) {
+        r *= long_int{i};
+    }
+    REQUIRE(r.to_string() == "265252859812191058636308480000000");
+
+    for (auto i = 30; i >= 1; --i) {
+        r /= long_int{i};
+    }
+    REQUIRE(r == long_int{1});
+}
+
+TEST_CASE(karatsuba)
+{
+    // (10^n - 1)^2 = 10^2n - 2 * 10^n + 1 = 99..9800..01
+    auto const n = 2000uz;
+    auto const a = parse(std::string(n, '9'));
+    REQUIRE((a * a).to_string() == std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+
+    // Unbalanced operands.
+    auto const k = n / 3;
+    auto const b = parse(std::string(k, '9'));
+    REQUIRE((a * b).to_string() == std::string(k - 1, '9') + "8" + std::string(n - k, '9') + std::string(k - 1, '0') + "1");
+}
+
+TEST_CASE(identities)
+{
+    auto seed = std::uint64_t{1};
+    for (auto const [an, bn] : {std::pair{1uz, 1uz}, {2, 1}, {3, 2}, {20, 7}, {40, 40}, {100, 33}, {150, 149}, {300, 70}}) {
+        auto const a = random_long_int(an, seed);
+        auto const b = random_long_int(bn, seed) + long_int{1};
+
+        REQUIRE((a + b) * (a + b) == a * a + long_int{2} * a * b + b * b);
+        REQUIRE((a - b) * (a + b) == a * a - b * b);
+        REQUIRE((a + b) - a == b);
+
+        for (auto const& [x, y] : {std::pair{a, b}, {-a, b}, {a, -b}, {-a, -b}}) {
+            auto const [q, r] = divmod(x, y);
+            REQUIRE(q * y + r == x);
+            REQUIRE((r < long_int{0} ? -r : r) < (y < long_int{0} ? -y : y));
+            REQUIRE(r == long_int{0} or r.is_negative() == x.is_negative());
+        }
+
+        auto const [q, r] = divmod(a * b + long_int{3}, b);
+        REQUIRE(q == a);
+        REQUIRE(r == long_int{3});
+    }
+}
+
+TEST_CASE(allocator)
+{
+    auto arena = hk::builtin::arena_allocator{};
+    arena.enable_statistics(true);
+
+    auto const a = long_int{std::numeric_limits<std::int64_t>::max(), arena};
+    REQUIRE(&a.get_allocator() == &arena);
+    REQUIRE(arena.statistics().num_allocations == 0);
+
+    // The result of an operation uses the allocator of the left operand.
+    auto const b = a + long_int{1};
+    REQUIRE(&b.get_allocator() == &arena);
+    REQUIRE(arena.statistics().num_allocations == 1);
+    REQUIRE(&(long_int{1} + a).get_allocator() == &hk::builtin::_default_allocator);
+
+    auto c = b * b;
+    REQUIRE(&c.get_allocator() == &arena);
+    REQUIRE(c.to_string() == "85070591730234615865843651857942052864");
+    c = long_int{};
+    REQUIRE(&c.get_allocator() == &hk::builtin::_default_allocator);
+
+    auto const d = long_int::from_string("123456789012345678901234567890", 10, arena).value();
+    REQUIRE(&d.get_allocator() == &arena);
+    REQUIRE(arena.statistics().num_allocations == 3);
+    REQUIRE(arena.statistics().num_deallocations == 1);
+}
+
+TEST_CASE(hash)
+{
+    // Equal values have the same hash, however they were computed.
+    auto const a = long_int::from_string("123456789012345678901234567890").value();
+    auto const b = long_int::from_string("123456789012345678901234567889").value() + long_int{1};
+    REQUIRE(a == b);
+    REQUIRE(a.hash() == b.hash());
+    REQUIRE(a.hash() != (-a).hash());
+
+    auto const c = (a - a) + long_int{42};
+    REQUIRE(c.hash() == long_int{42}.hash());
+    REQUIRE(std::hash<long_int>{}(c) == c.hash());
+}
+
+}; // TEST_SUITE(long_int_suite)
@@ -5,24 +5,43 @@
 
 namespace hk::builtin {
 
+/** The description of a type.
+ *
+ * Metatypes are canonical and immutable: each distinct type is described
+ * by a single metatype object, so that types are compared by address. The
+ * layout is stored in the base class, so that it can be read without a
+ * virtual call.
+ */
 class metatype {
 public:
     virtual ~metatype() = default;
+    metatype(metatype const&) = delete;
+    metatype(metatype&&) = delete;
+    metatype& operator=(metatype const&) = delete;
+    metatype& operator=(metatype&&) = delete;
 
     /** Number of bytes to allocate for an instance of the type it describes.
      */
-    [[nodiscard]] virtual std::size_t size()
+    [[nodiscard]] constexpr std::size_t size() const noexcept
     {
-        return 0;
+        return _size;
     }
 
     /** Alignment in memory for an instance of type it describes.
      */
-    [[nodiscard]] virtual std::size_t alignment()
+    [[nodiscard]] constexpr std::size_t alignment() const noexcept
     {
-        return 1;
+        return _alignment;
     }
+
+protected:
+    constexpr metatype() noexcept = default;
+    constexpr metatype(std::size_t size, std::size_t alignment) noexcept : _size(size), _alignment(alignment) {}
+
+private:
+    std::size_t _size = 0;
+    std::size_t _alignment = 1;
 };
 
 
-}
\ No newline at end of file
+}
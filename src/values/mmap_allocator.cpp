@@ -0,0 +1,118 @@
+
+#include "mmap_allocator.hpp"
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace hk::builtin {
+
+namespace {
+
+[[nodiscard]] std::size_t round_up(std::size_t size, std::size_t alignment) noexcept
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]] void *map_pages(std::size_t size, void *address = nullptr) noexcept
+{
+#if defined(_WIN32)
+    return ::VirtualAlloc(address, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    assert(address == nullptr);
+    auto *r = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return r == MAP_FAILED ? nullptr : r;
+#endif
+}
+
+void unmap_pages(void *ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+#if defined(_WIN32)
+    ::VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    ::munmap(ptr, size);
+#endif
+}
+
+} // namespace
+
+std::size_t mmap_allocator::page_size() noexcept
+{
+    static auto const r = [] {
+#if defined(_WIN32)
+        auto info = SYSTEM_INFO{};
+        ::GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+#else
+        return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    }();
+    return r;
+}
+
+std::pair<void *, std::size_t> mmap_allocator::allocate(std::size_t size, std::size_t alignment)
+{
+    assert(std::has_single_bit(alignment));
+
+    auto const page = page_size();
+    size = round_up(size, page);
+
+    if (alignment <= page) {
+        auto *ptr = map_pages(size);
+        if (ptr == nullptr) {
+            throw std::bad_alloc{};
+        }
+        count_allocation(size);
+        return {ptr, size};
+    }
+
+#if defined(_WIN32)
+    // A reservation can only be released as a whole; so find an aligned
+    // address in a larger reservation, release it, and map at that address.
+    // Another thread may take the address in between, in which case retry.
+    while (true) {
+        auto *ptr = map_pages(size + alignment);
+        if (ptr == nullptr) {
+            throw std::bad_alloc{};
+        }
+        auto const address = round_up(reinterpret_cast<std::uintptr_t>(ptr), alignment);
+        unmap_pages(ptr, size + alignment);
+        if (auto *r = map_pages(size, reinterpret_cast<void *>(address))) {
+            count_allocation(size);
+            return {r, size};
+        }
+    }
+#else
+    // Map more than needed, then trim the unaligned head and the tail.
+    auto *ptr = static_cast<char *>(map_pages(size + alignment));
+    if (ptr == nullptr) {
+        throw std::bad_alloc{};
+    }
+    auto *r = reinterpret_cast<char *>(round_up(reinterpret_cast<std::uintptr_t>(ptr), alignment));
+    auto const head = static_cast<std::size_t>(r - ptr);
+    if (head != 0) {
+        unmap_pages(ptr, head);
+    }
+    if (auto const tail = alignment - head; tail != 0) {
+        unmap_pages(r + size, tail);
+    }
+    count_allocation(size);
+    return {r, size};
+#endif
+}
+
+void mmap_allocator::deallocate(void *ptr, std::size_t size)
+{
+    count_deallocation(size);
+    unmap_pages(ptr, size);
+}
+
+}
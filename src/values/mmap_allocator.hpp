@@ -0,0 +1,41 @@
+
+#pragma once
+
+#include "allocator.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace hk::builtin {
+
+/** Allocate large objects directly from the operating system.
+ *
+ * Every allocation is a separate mapping of whole pages, which is returned
+ * to the operating system on deallocation. The pages are zero-initialized
+ * and are only committed when they are first touched.
+ *
+ * This allocator is thread-safe.
+ */
+class mmap_allocator : public allocator_intf {
+public:
+    virtual ~mmap_allocator() = default;
+
+    mmap_allocator() noexcept = default;
+
+    /** The size of a page of virtual memory.
+     */
+    [[nodiscard]] static std::size_t page_size() noexcept;
+
+    /** Allocate memory.
+     *
+     * @param size The size, rounded up to a multiple of the page size.
+     * @param alignment A power of two, alignments larger than a page are
+     *                  supported for carving segments out of the mapping.
+     */
+    [[nodiscard]] std::pair<void *, std::size_t> allocate(std::size_t size, std::size_t alignment) override;
+
+    void deallocate(void *ptr, std::size_t size) override;
+};
+
+inline mmap_allocator _mmap_allocator = mmap_allocator{};
+
+}
@@ -0,0 +1,40 @@
+
+#include "mmap_allocator.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+
+namespace {
+
+using hk::builtin::mmap_allocator;
+
+} // namespace
+
+TEST_SUITE(mmap_allocator_suite)
+{
+
+TEST_CASE(pages)
+{
+    auto allocator = mmap_allocator{};
+    auto const page_size = mmap_allocator::page_size();
+
+    auto const [ptr, size] = allocator.allocate(1, 1);
+    REQUIRE(size == page_size);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % page_size == 0);
+    REQUIRE(static_cast<char *>(ptr)[size - 1] == 0);
+    allocator.deallocate(ptr, size);
+}
+
+TEST_CASE(aligned)
+{
+    auto allocator = mmap_allocator{};
+
+    for (auto i = 0; i != 4; ++i) {
+        auto const [ptr, size] = allocator.allocate(0x4'0000, 0x4'0000);
+        REQUIRE(size == 0x4'0000);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % 0x4'0000 == 0);
+        static_cast<char *>(ptr)[size - 1] = 1;
+        allocator.deallocate(ptr, size);
+    }
+}
+
+}; // TEST_SUITE(mmap_allocator_suite)
@@ -0,0 +1,179 @@
+
+#include "reloc_patch_table.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <tuple>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HK_RELOC_SSE2 1
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HK_RELOC_AVX2 1
+#endif
+
+namespace hk::builtin {
+
+namespace {
+
+[[nodiscard]] std::uint64_t load_word(std::byte const *p) noexcept
+{
+    auto r = std::uint64_t{};
+    std::memcpy(&r, p, sizeof(r));
+    return r;
+}
+
+void store_word(std::byte *p, std::uint64_t value) noexcept
+{
+    std::memcpy(p, &value, sizeof(value));
+}
+
+/** Add @a addend to @a n consecutive words.
+ */
+void add_run(std::byte *p, std::size_t n, std::uint64_t addend) noexcept
+{
+#if defined(HK_RELOC_AVX2)
+    auto const addend4 = _mm256_set1_epi64x(static_cast<long long>(addend));
+    for (; n >= 4; n -= 4, p += 32) {
+        auto *const v = reinterpret_cast<__m256i *>(p);
+        _mm256_storeu_si256(v, _mm256_add_epi64(_mm256_loadu_si256(v), addend4));
+    }
+#endif
+#if defined(HK_RELOC_SSE2)
+    auto const addend2 = _mm_set1_epi64x(static_cast<long long>(addend));
+    for (; n >= 2; n -= 2, p += 16) {
+        auto *const v = reinterpret_cast<__m128i *>(p);
+        _mm_storeu_si128(v, _mm_add_epi64(_mm_loadu_si128(v), addend2));
+    }
+#endif
+    for (; n != 0; --n, p += 8) {
+        store_word(p, load_word(p) + addend);
+    }
+}
+
+/** Add @a addend to the words selected by a 63-bit bitmap.
+ */
+void add_bitmap(std::byte *p, std::uint64_t bits, std::uint64_t addend) noexcept
+{
+    while (bits != 0) {
+        auto const skip = static_cast<std::size_t>(std::countr_zero(bits));
+        p += skip * 8;
+        bits >>= skip;
+
+        // A single pointer does not need the loops of add_run().
+        if ((bits & 2) == 0) {
+            store_word(p, load_word(p) + addend);
+            p += 8;
+            bits >>= 1;
+            continue;
+        }
+
+        auto const run = static_cast<std::size_t>(std::countr_one(bits));
+        add_run(p, run, addend);
+        p += run * 8;
+        bits = run < 64 ? bits >> run : 0;
+    }
+}
+
+} // namespace
+
+void apply_reloc_patches(std::span<std::byte> data, std::span<reloc_patch_entry const> entries) noexcept
+{
+    auto const base = reinterpret_cast<std::uintptr_t>(data.data());
+    for (auto const& entry : entries) {
+        assert(entry.offset + 8 <= data.size());
+        auto *const p = data.data() + entry.offset;
+        auto const value = reloc_shift(base + entry.target, entry.mask, entry.shift);
+        store_word(p, (load_word(p) & ~entry.mask) | value);
+    }
+}
+
+std::vector<std::uint64_t> make_reloc_patch_table(std::span<reloc_patch_entry const> entries)
+{
+    auto sorted = std::vector<reloc_patch_entry>{entries.begin(), entries.end()};
+    std::ranges::sort(sorted, [](auto const& a, auto const& b) {
+        return std::tie(a.mask, a.shift, a.offset) < std::tie(b.mask, b.shift, b.offset);
+    });
+
+    auto r = std::vector<std::uint64_t>{0};
+    for (auto it = sorted.begin(); it != sorted.end();) {
+        auto const mask = it->mask;
+        auto const shift = it->shift;
+        r.push_back(mask);
+        r.push_back(static_cast<std::uint64_t>(static_cast<std::int64_t>(shift)));
+        auto const size_index = r.size();
+        r.push_back(0);
+        ++r[0];
+
+        // The index of the word after the last word that was described.
+        auto next = 0uz;
+        while (it != sorted.end() and it->mask == mask and it->shift == shift) {
+            assert(it->offset % 8 == 0);
+            auto const index = it->offset / 8;
+            assert(index >= next);
+            r.push_back((index - next) << 1);
+            next = index + 1;
+            ++it;
+
+            // Describe the following pointers with bitmaps, while they are close.
+            while (it != sorted.end() and it->mask == mask and it->shift == shift and it->offset / 8 < next + 63) {
+                auto bits = std::uint64_t{1};
+                for (; it != sorted.end() and it->mask == mask and it->shift == shift and it->offset / 8 < next + 63; ++it) {
+                    assert(it->offset % 8 == 0 and it->offset / 8 >= next);
+                    bits |= std::uint64_t{1} << (it->offset / 8 - next + 1);
+                }
+                r.push_back(bits);
+                next += 63;
+            }
+        }
+        r[size_index] = r.size() - size_index - 1;
+    }
+    return r;
+}
+
+void write_reloc_addend(std::span<std::byte> data, reloc_patch_entry const& entry) noexcept
+{
+    assert(entry.offset + 8 <= data.size());
+    assert(entry.shift >= 0 or entry.target % (std::uint64_t{1} << -entry.shift) == 0);
+
+    auto *const p = data.data() + entry.offset;
+    store_word(p, (load_word(p) & ~entry.mask) | reloc_shift(entry.target, entry.mask, entry.shift));
+}
+
+void apply_reloc_patch_table(std::span<std::byte> data, std::span<std::uint64_t const> table) noexcept
+{
+    assert(not table.empty());
+
+    auto const base = reinterpret_cast<std::uintptr_t>(data.data());
+    auto i = 1uz;
+    for (auto group = table[0]; group != 0; --group) {
+        auto const mask = table[i];
+        auto const shift = static_cast<int>(static_cast<std::int64_t>(table[i + 1]));
+        auto const num_words = table[i + 2];
+        i += 3;
+
+        // The target is already in the pointer, add the address of the segment.
+        assert(shift >= 0 or shift <= -64 or base % (std::uint64_t{1} << -shift) == 0);
+        auto const addend = reloc_shift(base, mask, shift);
+        auto offset = 0uz;
+        for (auto const end = i + num_words; i != end; ++i) {
+            auto const word = table[i];
+            if ((word & 1) == 0) {
+                offset += (word >> 1) * 8;
+                assert(offset + 8 <= data.size());
+                auto *const p = data.data() + offset;
+                store_word(p, load_word(p) + addend);
+                offset += 8;
+            } else {
+                assert(offset + static_cast<std::size_t>(63 - std::countl_zero(word)) * 8 <= data.size());
+                add_bitmap(data.data() + offset, word >> 1, addend);
+                offset += 63 * 8;
+            }
+        }
+    }
+}
+
+}
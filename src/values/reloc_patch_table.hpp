@@ -0,0 +1,93 @@
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace hk::builtin {
+
+/** A pointer to patch in the `.data` segment, see doc/language/relocation.md.
+ */
+struct reloc_patch_entry {
+    /** The offset of the pointer-to-patch in the `.data` segment.
+     */
+    std::size_t offset = 0;
+
+    /** The offset into the `.data` segment that the pointer must point to.
+     */
+    std::size_t target = 0;
+
+    /** The bits at the offset that will be patched.
+     */
+    std::uint64_t mask = ~std::uint64_t{0};
+
+    /** How many bits the target is shifted left before patching, negative to shift right.
+     */
+    int shift = 0;
+
+    [[nodiscard]] constexpr friend bool operator==(reloc_patch_entry const&, reloc_patch_entry const&) noexcept = default;
+};
+
+/** The value of the patched bits of a pointer to @a address.
+ */
+[[nodiscard]] constexpr std::uint64_t reloc_shift(std::uint64_t address, std::uint64_t mask, int shift) noexcept
+{
+    if (shift >= 64 or shift <= -64) {
+        return 0;
+    }
+    return (shift >= 0 ? address << shift : address >> -shift) & mask;
+}
+
+/** Apply patches to a `.data` segment.
+ *
+ * Every pointer is written as a whole, the bits of the target and the bits
+ * outside the mask of the pointer. This is the slow reference of
+ * `__reloc_patch_table__`, which is used to check the compressed table.
+ *
+ * @param data The `.data` segment, with its final address.
+ * @param entries The patches.
+ */
+void apply_reloc_patches(std::span<std::byte> data, std::span<reloc_patch_entry const> entries) noexcept;
+
+/** Compress a patch table.
+ *
+ * The compressed table does not contain the targets; instead the patched
+ * bits of each pointer in the `.data` segment must already contain the
+ * target as an offset, as written by `write_reloc_addend()`. Patching then
+ * adds the shifted address of the `.data` segment to each pointer.
+ *
+ * The table is a sequence of 64-bit words: the number of groups, and for
+ * each combination of mask and shift a group with the mask, the shift, the
+ * number of words and the words. The offsets of a group are sorted and
+ * delta-encoded in words of 8 bytes:
+ *  - An even word is the distance to the next pointer, after the last word
+ *    that was described, shifted left by one.
+ *  - An odd word is a bitmap of the 63 words after the last word that was
+ *    described, bit 1 for the first word.
+ *
+ * @param entries The patches, with offsets that are a multiple of 8.
+ * @return The compressed table.
+ */
+[[nodiscard]] std::vector<std::uint64_t> make_reloc_patch_table(std::span<reloc_patch_entry const> entries);
+
+/** Write the target of a patch as an offset in its pointer.
+ *
+ * @param data The `.data` segment.
+ * @param entry The patch.
+ */
+void write_reloc_addend(std::span<std::byte> data, reloc_patch_entry const& entry) noexcept;
+
+/** Apply the compressed patches to a `.data` segment.
+ *
+ * Consecutive pointers in a bitmap are patched with SIMD instructions.
+ *
+ * @param data The `.data` segment, with its final address, aligned to at
+ *             least the largest `1 << -shift`.
+ * @param table The compressed table from `make_reloc_patch_table()`.
+ */
+void apply_reloc_patch_table(std::span<std::byte> data, std::span<std::uint64_t const> table) noexcept;
+
+}
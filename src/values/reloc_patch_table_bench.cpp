@@ -0,0 +1,68 @@
+
+#include "reloc_patch_table.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+using hk::builtin::reloc_patch_entry;
+
+/** A `.data` segment of 64 Ki words, with a pointer every @a stride words.
+ */
+[[nodiscard]] std::vector<reloc_patch_entry> make_entries(std::size_t stride)
+{
+    auto r = std::vector<reloc_patch_entry>{};
+    for (auto i = 0uz; i < 65536; i += stride) {
+        r.push_back(reloc_patch_entry{i * 8, (i * 7919 % 65536) * 8});
+    }
+    return r;
+}
+
+/** Apply a patch entry per pointer.
+ */
+void bm_apply_reloc_patches(benchmark::State& state)
+{
+    auto const entries = make_entries(static_cast<std::size_t>(state.range(0)));
+    auto data = std::vector<std::uint64_t>(65536);
+    auto const bytes = std::as_writable_bytes(std::span{data});
+
+    for (auto _ : state) {
+        hk::builtin::apply_reloc_patches(bytes, entries);
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(entries.size()));
+}
+
+/** Apply the compressed patch table to the same pointers.
+ */
+void bm_apply_reloc_patch_table(benchmark::State& state)
+{
+    auto const entries = make_entries(static_cast<std::size_t>(state.range(0)));
+    auto const table = hk::builtin::make_reloc_patch_table(entries);
+    auto data = std::vector<std::uint64_t>(65536);
+    auto const bytes = std::as_writable_bytes(std::span{data});
+
+    for (auto _ : state) {
+        // The addends are written once when the .data segment is loaded.
+        state.PauseTiming();
+        for (auto const& entry : entries) {
+            hk::builtin::write_reloc_addend(bytes, entry);
+        }
+        state.ResumeTiming();
+
+        hk::builtin::apply_reloc_patch_table(bytes, table);
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.counters["table_bytes"] = static_cast<double>(table.size() * 8);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(entries.size()));
+}
+
+} // namespace
+
+BENCHMARK(bm_apply_reloc_patches)->Arg(1)->Arg(3)->Arg(100);
+BENCHMARK(bm_apply_reloc_patch_table)->Arg(1)->Arg(3)->Arg(100);
@@ -0,0 +1,108 @@
+
+#include "reloc_patch_table.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace {
+
+using hk::builtin::reloc_patch_entry;
+
+/** Random patches for pointers in a segment of @a num_words words.
+ *
+ * The pointers form a dense table, followed by pointers spread out over the
+ * rest of the segment; with plain pointers and tagged pointers.
+ */
+[[nodiscard]] std::vector<reloc_patch_entry> make_entries(std::size_t num_words, std::uint64_t seed)
+{
+    struct pointer_kind {
+        std::uint64_t mask;
+        int shift;
+    };
+    constexpr auto kinds = std::array{
+        pointer_kind{~std::uint64_t{0}, 0},
+        pointer_kind{0x0000'ffff'ffff'ffff, 0},
+        pointer_kind{~std::uint64_t{7}, 0},
+        pointer_kind{0x1fff'ffff'ffff'ffff, -3},
+        pointer_kind{~std::uint64_t{0xffff}, 16}};
+
+    auto engine = std::mt19937_64{seed};
+    auto offsets = std::set<std::size_t>{};
+    for (auto i = num_words / 8; i != num_words / 4; ++i) {
+        offsets.insert(i * 8);
+    }
+    for (auto i = 0uz; i != num_words / 8; ++i) {
+        offsets.insert(engine() % num_words * 8);
+    }
+
+    auto r = std::vector<reloc_patch_entry>{};
+    for (auto const offset : offsets) {
+        auto const& kind = kinds[engine() % kinds.size()];
+        r.emplace_back(offset, engine() % num_words * 8, kind.mask, kind.shift);
+    }
+    return r;
+}
+
+} // namespace
+
+TEST_SUITE(reloc_patch_table_suite)
+{
+
+TEST_CASE(compress)
+{
+    auto const entries = std::vector<reloc_patch_entry>{
+        reloc_patch_entry{8000, 0}, reloc_patch_entry{16, 0}, reloc_patch_entry{0, 0}, reloc_patch_entry{8, 0}};
+
+    // Pointers at words 0, 1 and 2 are described by an offset and a bitmap, word 1000 by an offset after the bitmap.
+    auto const table = hk::builtin::make_reloc_patch_table(entries);
+    REQUIRE(table == std::vector<std::uint64_t>({1, ~std::uint64_t{0}, 0, 3, 0, 0b111, (1000 - 64) << 1}));
+
+    REQUIRE(hk::builtin::make_reloc_patch_table({}) == std::vector<std::uint64_t>({0}));
+}
+
+TEST_CASE(apply)
+{
+    constexpr auto num_words = 4096uz;
+
+    for (auto seed = 0; seed != 4; ++seed) {
+        auto const entries = make_entries(num_words, seed);
+
+        // The bits outside the mask of tagged pointers are preserved.
+        auto engine = std::mt19937_64{static_cast<std::uint64_t>(seed)};
+        auto original = std::vector<std::uint64_t>(num_words);
+        for (auto& word : original) {
+            word = engine();
+        }
+
+        auto patched = original;
+        auto const patched_bytes = std::as_writable_bytes(std::span{patched});
+        for (auto const& entry : entries) {
+            hk::builtin::write_reloc_addend(patched_bytes, entry);
+        }
+        hk::builtin::apply_reloc_patch_table(patched_bytes, hk::builtin::make_reloc_patch_table(entries));
+
+        // The reference implementation writes every pointer as a whole.
+        auto expected = original;
+        auto const base = reinterpret_cast<std::uintptr_t>(patched.data());
+        for (auto const& entry : entries) {
+            auto& word = expected[entry.offset / 8];
+            word = (word & ~entry.mask) | hk::builtin::reloc_shift(base + entry.target, entry.mask, entry.shift);
+        }
+        REQUIRE(patched == expected);
+
+        // Which is the same as apply_reloc_patches() at another address.
+        auto reference = original;
+        auto const reference_bytes = std::as_writable_bytes(std::span{reference});
+        hk::builtin::apply_reloc_patches(reference_bytes, entries);
+        auto const reference_base = reinterpret_cast<std::uintptr_t>(reference.data());
+        for (auto const& entry : entries) {
+            auto const i = entry.offset / 8;
+            REQUIRE(reference[i] == ((original[i] & ~entry.mask) | hk::builtin::reloc_shift(reference_base + entry.target, entry.mask, entry.shift)));
+        }
+    }
+}
+
+}; // TEST_SUITE(reloc_patch_table_suite)
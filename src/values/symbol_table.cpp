@@ -1,50 +1,101 @@
 
 #include "symbol_table.hpp"
-#include "utility/algorithm.hpp"
-#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <memory>
 
 namespace hk {
 
-symbol_table::symbol_table(std::span<symbol_table const*> tables) : _tables()
+symbol_table::symbol_table() : _arena(0x1'0000), _index(make_index(initial_capacity)) {}
+
+symbol_table::symbol_table(std::span<symbol_table const * const> tables) : symbol_table()
 {
-    auto const size = std::accumulate(tables.begin(), tables.end(), 0uz, [](auto const& item) {
-        return item.size();
-    });
-    _tables.reserve(size)
+    _overlays.assign(tables.begin(), tables.end());
+}
+
+hk::symbol *symbol_table::add(interned_string name, hk::symbol *symbol)
+{
+    assert(symbol != nullptr);
+
+    auto const *index = _index.load(std::memory_order::relaxed);
+    auto const size = _size.load(std::memory_order::relaxed);
+
+    // Keep the load factor below one half, so that probe sequences stay short.
+    if ((size + 1) * 2 > index->mask + 1) {
+        auto const *new_index = make_index((index->mask + 1) * 2);
+        for (auto i = 0uz; i <= index->mask; ++i) {
+            auto const *entry = index->slots[i].load(std::memory_order::relaxed);
+            if (entry == nullptr) {
+                continue;
+            }
+
+            auto j = hash(entry->name) & new_index->mask;
+            while (new_index->slots[j].load(std::memory_order::relaxed) != nullptr) {
+                j = (j + 1) & new_index->mask;
+            }
+            new_index->slots[j].store(entry, std::memory_order::relaxed);
+        }
+
+        // The old index stays in the arena for lookups that are still using it.
+        _index.store(new_index, std::memory_order::release);
+        index = new_index;
+    }
 
-    for (auto const& table : tables) {
-        _table.append_range(*table);
+    auto i = hash(name) & index->mask;
+    while (auto const *entry = index->slots[i].load(std::memory_order::relaxed)) {
+        if (entry->name == name) {
+            return entry->symbol;
+        }
+        i = (i + 1) & index->mask;
     }
 
-    std::sort(_tables.begin(), _tables.end());
+    auto *const ptr = _arena.allocate(sizeof(value_type), alignof(value_type)).first;
+    auto const *const entry = std::construct_at(static_cast<value_type *>(ptr), name, symbol);
+    index->slots[i].store(entry, std::memory_order::release);
+    _size.store(size + 1, std::memory_order::release);
+    return nullptr;
 }
 
-hk::symbol *symbol_table::add(fqname name, std::shared_ptr<hk::symbol> symbol)
+[[nodiscard]] hk::symbol *symbol_table::get(interned_string name) const noexcept
 {
-    auto it = std::lower_bound(_table.begin(), _table.end(), name, [](auto const& item, auto const& x) {
-        return item.name < x;
-    });
-
-    if (it != _table.end() and it->name == name) {
-        return *it->symbol;
+    if (auto *r = find(name)) {
+        return r;
     }
 
-    _table.emplace(it, std::move(name), std::move(symbol));
+    for (auto const *table : _overlays) {
+        if (auto *r = table->get(name)) {
+            return r;
+        }
+    }
     return nullptr;
 }
 
-[[nodiscard]] hk::symbol *symbol_table::get(fqname const& name) const
+[[nodiscard]] hk::symbol *symbol_table::find(interned_string name) const noexcept
 {
-    auto it = std::lower_bound(_table.begin(), _table.end(), name, [](auto const& item, auto const& x) {
-        return item.name < x;
-    });
+    auto const *index = _index.load(std::memory_order::acquire);
 
-    if (it != _table.end() and it->name == name) {
-        return *it->symbol;
+    auto i = hash(name) & index->mask;
+    while (auto const *entry = index->slots[i].load(std::memory_order::acquire)) {
+        if (entry->name == name) {
+            return entry->symbol;
+        }
+        i = (i + 1) & index->mask;
     }
-
     return nullptr;
 }
 
+[[nodiscard]] symbol_table::index_type const *symbol_table::make_index(std::size_t capacity)
+{
+    assert(std::has_single_bit(capacity));
+
+    auto *const slots_ptr = _arena.allocate(capacity * sizeof(std::atomic<value_type const *>), alignof(std::atomic<value_type const *>)).first;
+    auto *const slots = static_cast<std::atomic<value_type const *> *>(slots_ptr);
+    for (auto i = 0uz; i != capacity; ++i) {
+        std::construct_at(slots + i, nullptr);
+    }
+
+    auto *const ptr = _arena.allocate(sizeof(index_type), alignof(index_type)).first;
+    return std::construct_at(static_cast<index_type *>(ptr), capacity - 1, slots);
+}
 
-} // namespace hk
\ No newline at end of file
+} // namespace hk
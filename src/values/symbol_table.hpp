@@ -1,94 +1,213 @@
 
 #pragma once
 
-#include "symbol.hpp"
+#include "arena_allocator.hpp"
 #include "utility/fqname.hpp"
-#include <memory>
+#include "utility/interned_string.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
 #include <vector>
-#include <compare>
 
 namespace hk {
 
+struct symbol;
+
+/** A table of symbols, indexed by their interned fully qualified name.
+ *
+ * The table is an open-addressing hash table; the hash of a name is taken
+ * from its interned storage, so that a lookup does not compare strings.
+ *
+ * A table may be an overlay over other tables, for example a module's
+ * table over the tables of its imports. A lookup that does not find a
+ * name in the table itself continues in the underlying tables, in order;
+ * nothing is copied. The underlying tables must outlive the overlay.
+ *
+ * The symbols are not owned by the table, they are allocated in the arena
+ * of their module. The entries and hash indices are allocated from the
+ * table's own arena and are freed together with the table.
+ *
+ * A table has a single writer. Lookups are lock-free and may run on other
+ * threads while symbols are added; a lookup sees a symbol once `add()`
+ * has returned.
+ */
 class symbol_table {
 public:
     struct value_type {
-        fqname name;
-        std::shared_ptr<hk::symbol> symbol;
+        interned_string name;
+        hk::symbol *symbol;
+    };
+
+    class const_iterator {
+    public:
+        using value_type = symbol_table::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const&;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr const_iterator() noexcept = default;
+
+        constexpr const_iterator(std::atomic<value_type const *> const *it, std::atomic<value_type const *> const *last) noexcept :
+            _it(it), _last(last)
+        {
+            skip_empty();
+        }
+
+        [[nodiscard]] reference operator*() const noexcept
+        {
+            return *_it->load(std::memory_order::acquire);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept
+        {
+            return _it->load(std::memory_order::acquire);
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            ++_it;
+            skip_empty();
+            return *this;
+        }
 
-        [[nodiscard]] friend bool operator==(value_type const& lhs, value_type const& rhs)
+        const_iterator operator++(int) noexcept
         {
-            return lhs.name == rhs.name;
+            auto tmp = *this;
+            ++*this;
+            return tmp;
         }
 
-        [[nodiscard]] friend std::strong_ordering operator<=>(value_type const& lhs, value_type const& rhs)
+        [[nodiscard]] constexpr friend bool operator==(const_iterator const&, const_iterator const&) noexcept = default;
+
+    private:
+        std::atomic<value_type const *> const *_it = nullptr;
+        std::atomic<value_type const *> const *_last = nullptr;
+
+        constexpr void skip_empty() noexcept
         {
-            return lhs.name <=> rhs.name;
+            while (_it != _last and _it->load(std::memory_order::acquire) == nullptr) {
+                ++_it;
+            }
         }
     };
 
-    using container_type = std::vector<value_type>;
-    using iterator = container_type::iterator;
-    using const_iterator = container_type::const_iterator;
+    using iterator = const_iterator;
 
-    constexpr symbol_table() = default;
-    symbol_table(symbol_table const&) = default;
-    symbol_table(symbol_table&&) = default;
-    symbol_table& operator=(symbol_table const&) = default;
-    symbol_table& operator=(symbol_table&&) = default;
+    ~symbol_table() = default;
+    symbol_table(symbol_table const&) = delete;
+    symbol_table(symbol_table&&) = delete;
+    symbol_table& operator=(symbol_table const&) = delete;
+    symbol_table& operator=(symbol_table&&) = delete;
 
-    /** Create a symbol table by merging them together.
-     */
-    symbol_table(std::span<symbol_table const*> tables);
+    symbol_table();
 
-    [[nodiscard]] constexpr bool empty() const
-    {
-        return _table.empty();
-    }
+    /** Create an overlay over other tables.
+     *
+     * @param tables The underlying tables, searched in order after this table.
+     */
+    explicit symbol_table(std::span<symbol_table const * const> tables);
 
-    [[nodiscard]] constexpr size_t size() const
+    /** The number of symbols in the table itself, excluding underlying tables.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
     {
-        return _table.size();
+        return _size.load(std::memory_order::acquire);
     }
 
-    [[nodiscard]] constexpr iterator begin()
+    [[nodiscard]] bool empty() const noexcept
     {
-        return _table.begin();
+        return size() == 0;
     }
 
-    [[nodiscard]] constexpr const_iterator begin() const
+    /** Iterate over the symbols in the table itself, in no particular order.
+     */
+    [[nodiscard]] const_iterator begin() const noexcept
     {
-        return _table.begin();
+        auto const *index = _index.load(std::memory_order::acquire);
+        return {index->slots, index->slots + index->mask + 1};
     }
 
-    [[nodiscard]] constexpr iterator end()
+    [[nodiscard]] const_iterator end() const noexcept
     {
-        return _table.end();
+        auto const *index = _index.load(std::memory_order::acquire);
+        return {index->slots + index->mask + 1, index->slots + index->mask + 1};
     }
 
-    [[nodiscard]] constexpr const_iterator end() const
+    /** The underlying tables.
+     */
+    [[nodiscard]] std::span<symbol_table const * const> overlays() const noexcept
     {
-        return _table.end();
+        return _overlays;
     }
 
     /** Add a symbol to the symbol table.
-     * 
-     * @param name The name of the symbol to insert.
-     * @param symbol The symbol
-     * @return The duplicate symbol.
+     *
+     * A symbol shadows a symbol with the same name in an underlying table.
+     *
+     * @param name The interned name of the symbol to insert.
+     * @param symbol The symbol.
+     * @return The duplicate symbol in this table.
      * @retval nullptr Successfully inserted.
      */
-    hk::symbol* add(fqname name, std::shared_ptr<hk::symbol> symbol);
+    hk::symbol *add(interned_string name, hk::symbol *symbol);
 
-    /** Get a symbol from the symbol table.
-     * 
-     * @param name The name of the symbol to get.
+    /** Add a symbol to the symbol table.
+     *
+     * @see add(interned_string, hk::symbol *)
+     */
+    hk::symbol *add(fqname const& name, hk::symbol *symbol)
+    {
+        return add(interned_string{name.string()}, symbol);
+    }
+
+    /** Get a symbol from this table or the underlying tables.
+     *
+     * @param name The interned name of the symbol to get.
      * @return The symbol that was found.
      * @retval nullptr The symbol was not found.
      */
-    [[nodiscard]] hk::symbol* get(fqname const& name) const;
+    [[nodiscard]] hk::symbol *get(interned_string name) const noexcept;
+
+    /** Get a symbol from this table or the underlying tables.
+     *
+     * @see get(interned_string)
+     */
+    [[nodiscard]] hk::symbol *get(fqname const& name) const
+    {
+        return get(interned_string{name.string()});
+    }
 
 private:
-    container_type _table;
+    /** The hash index, a power-of-two number of slots.
+     *
+     * An index is never modified after it is replaced by a larger one, so
+     * that a concurrent lookup may continue in it.
+     */
+    struct index_type {
+        std::size_t mask;
+        std::atomic<value_type const *> *slots;
+    };
+
+    constexpr static auto initial_capacity = 16uz;
+
+    builtin::arena_allocator _arena;
+    std::atomic<index_type const *> _index;
+    std::atomic<std::size_t> _size = 0;
+    std::vector<symbol_table const *> _overlays = {};
+
+    [[nodiscard]] static std::size_t hash(interned_string name) noexcept
+    {
+        return std::hash<interned_string>{}(name);
+    }
+
+    /** Find a symbol in this table only.
+     */
+    [[nodiscard]] hk::symbol *find(interned_string name) const noexcept;
+
+    [[nodiscard]] index_type const *make_index(std::size_t capacity);
 };
 
 } // namespace hk
@@ -0,0 +1,145 @@
+
+#include "symbol_table.hpp"
+#include <hikotest/hikotest.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** Symbols are opaque to the table, only their addresses are used.
+ */
+std::array<int, 1000> symbols = {};
+
+[[nodiscard]] hk::symbol *make_symbol(std::size_t i)
+{
+    return reinterpret_cast<hk::symbol *>(&symbols[i]);
+}
+
+[[nodiscard]] std::vector<hk::interned_string> make_names(std::string_view prefix, std::size_t n)
+{
+    auto r = std::vector<hk::interned_string>{};
+    for (auto i = 0uz; i != n; ++i) {
+        r.emplace_back(std::format(".{}.symbol_{}", prefix, i));
+    }
+    return r;
+}
+
+} // namespace
+
+TEST_SUITE(symbol_table_suite)
+{
+
+TEST_CASE(add_get)
+{
+    auto table = hk::symbol_table{};
+    REQUIRE(table.empty());
+
+    REQUIRE(table.add(hk::fqname{".foo"}, make_symbol(0)) == nullptr);
+    REQUIRE(table.add(hk::fqname{".bar"}, make_symbol(1)) == nullptr);
+    REQUIRE(table.size() == 2);
+
+    REQUIRE(table.get(hk::fqname{".foo"}) == make_symbol(0));
+    REQUIRE(table.get(hk::interned_string{".bar"}) == make_symbol(1));
+    REQUIRE(table.get(hk::fqname{".baz"}) == nullptr);
+
+    // A duplicate is not inserted, and the existing symbol is returned.
+    REQUIRE(table.add(hk::fqname{".foo"}, make_symbol(2)) == make_symbol(0));
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.get(hk::fqname{".foo"}) == make_symbol(0));
+}
+
+TEST_CASE(grow)
+{
+    auto const names = make_names("grow", 1000);
+
+    auto table = hk::symbol_table{};
+    for (auto i = 0uz; i != names.size(); ++i) {
+        REQUIRE(table.add(names[i], make_symbol(i)) == nullptr);
+    }
+    REQUIRE(table.size() == 1000);
+
+    for (auto i = 0uz; i != names.size(); ++i) {
+        REQUIRE(table.get(names[i]) == make_symbol(i));
+    }
+
+    // Every symbol is visited once.
+    auto visited = std::vector<hk::symbol *>{};
+    for (auto const& [name, symbol] : table) {
+        REQUIRE(table.get(name) == symbol);
+        visited.push_back(symbol);
+    }
+    std::ranges::sort(visited);
+    REQUIRE(visited.size() == 1000);
+    REQUIRE(std::ranges::adjacent_find(visited) == visited.end());
+}
+
+TEST_CASE(overlay)
+{
+    auto std_table = hk::symbol_table{};
+    std_table.add(hk::fqname{".std.print"}, make_symbol(0));
+    std_table.add(hk::fqname{".std.string"}, make_symbol(1));
+
+    auto other_table = hk::symbol_table{};
+    other_table.add(hk::fqname{".std.print"}, make_symbol(2));
+    other_table.add(hk::fqname{".other.foo"}, make_symbol(3));
+
+    auto const imports = std::array<hk::symbol_table const *, 2>{&std_table, &other_table};
+    auto table = hk::symbol_table{imports};
+    table.add(hk::fqname{".std.string"}, make_symbol(4));
+    REQUIRE(table.size() == 1);
+    REQUIRE(table.overlays().size() == 2);
+
+    // The table itself first, then the underlying tables in order.
+    REQUIRE(table.get(hk::fqname{".std.string"}) == make_symbol(4));
+    REQUIRE(table.get(hk::fqname{".std.print"}) == make_symbol(0));
+    REQUIRE(table.get(hk::fqname{".other.foo"}) == make_symbol(3));
+    REQUIRE(table.get(hk::fqname{".other.bar"}) == nullptr);
+
+    // Symbols added to an underlying table are visible without copying.
+    std_table.add(hk::fqname{".std.vector"}, make_symbol(5));
+    REQUIRE(table.get(hk::fqname{".std.vector"}) == make_symbol(5));
+}
+
+TEST_CASE(concurrent_get)
+{
+    constexpr auto num_threads = 4;
+    auto const names = make_names("concurrent", 1000);
+
+    auto table = hk::symbol_table{};
+    auto num_added = std::atomic<std::size_t>{0};
+    auto num_errors = std::atomic<int>{0};
+
+    // The readers look up every symbol that was added so far, while the
+    // writer keeps growing the table.
+    auto readers = std::vector<std::thread>{};
+    for (auto t = 0; t != num_threads; ++t) {
+        readers.emplace_back([&] {
+            auto n = 0uz;
+            while (n != names.size()) {
+                n = num_added.load(std::memory_order::acquire);
+                for (auto i = 0uz; i != n; ++i) {
+                    if (table.get(names[i]) != make_symbol(i)) {
+                        ++num_errors;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto i = 0uz; i != names.size(); ++i) {
+        table.add(names[i], make_symbol(i));
+        num_added.store(i + 1, std::memory_order::release);
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    REQUIRE(num_errors.load() == 0);
+}
+
+}; // TEST_SUITE(symbol_table_suite)